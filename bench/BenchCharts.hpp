@@ -0,0 +1,63 @@
+#pragma once
+
+#include "GameplayCore.hpp"
+#include <algorithm>
+#include <random>
+#include <vector>
+
+// Synthetic charts and scripted players shared by the gameplay benchmarks
+
+namespace Bench {
+
+struct Play {
+    std::vector<App::Core::Note> notes;
+    std::vector<App::Windows::ScriptedInput> inputs;
+    double duration;
+};
+
+// Each lane gets non-overlapping notes, 20% of them HOLDs; the player skips 5%
+// of the notes, lets go of 10% of the holds early and hits with ~40 ms jitter
+inline Play makePlay(size_t noteCount, unsigned seed) {
+    using App::Windows::ScriptedInput;
+
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> gap(0.08, 0.2);
+    std::uniform_real_distribution<double> holdLength(0.2, 1.0);
+    std::uniform_real_distribution<double> chance(0.0, 1.0);
+    std::normal_distribution<double> jitter(0.0, 0.04);
+
+    Play play;
+    play.notes.reserve(noteCount);
+    play.inputs.reserve(noteCount * 2);
+    double laneTime[2] = {1.0, 1.05};
+
+    for (size_t i = 0; i < noteCount; i++) {
+        int lane = static_cast<int>(i % 2);
+        double start = laneTime[lane] + gap(rng);
+        bool hold = chance(rng) < 0.2;
+        double end = hold ? start + holdLength(rng) : start;
+        laneTime[lane] = end;
+
+        App::Core::Note note{static_cast<int>(i + 1), static_cast<App::Core::Lane>(lane),
+                             hold ? App::Core::HOLD : App::Core::TAP, start, end};
+        play.notes.push_back(note);
+
+        if (chance(rng) < 0.05) continue;
+
+        double press = start + std::clamp(jitter(rng), -0.07, 0.07);
+        double release = press + 0.03;
+        if (hold) {
+            release = chance(rng) < 0.1 ? start + (end - start) * 0.5 : end + 0.01;
+        }
+        play.inputs.push_back(ScriptedInput{press, note.lane, true});
+        play.inputs.push_back(ScriptedInput{release, note.lane, false});
+    }
+
+    std::stable_sort(play.inputs.begin(), play.inputs.end(), [](const ScriptedInput& a, const ScriptedInput& b) {
+        return a.time < b.time;
+    });
+    play.duration = std::max(laneTime[0], laneTime[1]) + 1.0;
+    return play;
+}
+
+} // namespace Bench
@@ -0,0 +1,83 @@
+#include "GameplayCore.hpp"
+#include "BenchCharts.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+// Replays synthetic charts through the headless gameplay core with a scripted,
+// slightly sloppy player, at 60 frames per second of song time
+
+namespace {
+
+const double FRAME_TIME = 1.0 / 60.0;
+
+using App::Windows::GameplayCore;
+using App::Windows::GameStats;
+using App::Windows::ScriptedInput;
+
+using Bench::Play;
+using Bench::makePlay;
+
+double percentile(std::vector<double>& samples, double fraction) {
+    size_t index = std::min(samples.size() - 1, static_cast<size_t>(fraction * (samples.size() - 1)));
+    std::nth_element(samples.begin(), samples.begin() + index, samples.end());
+    return samples[index];
+}
+
+} // namespace
+
+int main() {
+    std::printf("Gameplay benchmark: scripted play at %.0f fps of song time\n\n", 1.0 / FRAME_TIME);
+    std::printf("%10s %10s %12s %14s %10s %10s %10s %10s %8s\n",
+                "notes", "frames", "run ms", "notes/sec", "p50 ns", "p99 ns", "p99.9 ns", "max ns", "acc %");
+
+    for (size_t noteCount : {size_t(1000), size_t(10000), size_t(100000), size_t(1000000)}) {
+        Play play = makePlay(noteCount, 42);
+        GameplayCore core;
+        core.loadNotes(play.notes);
+
+        // Whole run throughput
+        auto start = std::chrono::steady_clock::now();
+        GameStats stats = core.simulate(play.inputs, play.duration, FRAME_TIME);
+        auto end = std::chrono::steady_clock::now();
+        double runMs = std::chrono::duration<double, std::milli>(end - start).count();
+
+        // Per-frame cost: the inputs seen by a frame plus its update
+        core.reset();
+        std::vector<double> frameNs;
+        frameNs.reserve(static_cast<size_t>(play.duration / FRAME_TIME) + 2);
+        size_t next = 0;
+        for (long frame = 0;; frame++) {
+            double frameEnd = std::min(frame * FRAME_TIME, play.duration);
+
+            auto frameStart = std::chrono::steady_clock::now();
+            while (next < play.inputs.size() && play.inputs[next].time <= frameEnd) {
+                const ScriptedInput& input = play.inputs[next++];
+                if (input.pressed) {
+                    core.press(input.lane, input.time);
+                } else {
+                    core.release(input.lane, input.time);
+                }
+            }
+            core.update(frameEnd);
+            core.clearEvents();
+            auto frameStop = std::chrono::steady_clock::now();
+            frameNs.push_back(std::chrono::duration<double, std::nano>(frameStop - frameStart).count());
+
+            if (frameEnd >= play.duration) break;
+        }
+
+        size_t frames = frameNs.size();
+        double p50 = percentile(frameNs, 0.5);
+        double p99 = percentile(frameNs, 0.99);
+        double p999 = percentile(frameNs, 0.999);
+        double maxNs = *std::max_element(frameNs.begin(), frameNs.end());
+
+        std::printf("%10zu %10zu %12.2f %14.0f %10.0f %10.0f %10.0f %10.0f %8.2f\n",
+                    noteCount, frames, runMs, noteCount / (runMs / 1000.0), p50, p99, p999, maxNs, stats.accuracy);
+    }
+
+    return 0;
+}
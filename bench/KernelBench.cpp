@@ -0,0 +1,147 @@
+#include "AudioKernels.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <functional>
+#include <random>
+#include <vector>
+
+// Microbenchmark for the analysis kernels over a synthetic 10-minute 44.1kHz mono track
+
+namespace {
+
+const size_t SAMPLE_RATE = 44100;
+const size_t TRACK_SECONDS = 600;
+const int REPEATS = 5;
+
+// Vector kernels sum in a different order than the scalar reference, so float
+// results may differ from it by this much relative to the magnitude
+const double TOLERANCE = 1e-6;
+
+volatile double sink = 0.0;
+
+double bestMilliseconds(const std::function<double()>& kernel) {
+    double best = 1e30;
+    for (int i = 0; i < REPEATS; i++) {
+        auto start = std::chrono::steady_clock::now();
+        sink = sink + kernel();
+        auto end = std::chrono::steady_clock::now();
+        best = std::min(best, std::chrono::duration<double, std::milli>(end - start).count());
+    }
+    return best;
+}
+
+bool matches(double result, double reference) {
+    return std::abs(result - reference) <= TOLERANCE * std::max(1.0, std::abs(reference));
+}
+
+struct KernelCase {
+    const char* name;
+    std::function<double(const float*, size_t)> floatKernel;
+    std::function<double(const double*, size_t)> doubleKernel;
+};
+
+} // namespace
+
+int main() {
+    const size_t count = SAMPLE_RATE * TRACK_SECONDS;
+    std::vector<float> floatTrack(count);
+    std::vector<double> doubleTrack(count);
+
+    std::mt19937 rng(42);
+    std::normal_distribution<float> noise(0.0f, 0.05f);
+    for (size_t i = 0; i < count; i++) {
+        double t = static_cast<double>(i) / SAMPLE_RATE;
+        double kick = std::exp(-std::fmod(t, 0.5) * 20.0) * std::sin(2.0 * M_PI * 55.0 * t);
+        floatTrack[i] = static_cast<float>(0.6 * kick + 0.2 * std::sin(2.0 * M_PI * 440.0 * t)) + noise(rng);
+        doubleTrack[i] = floatTrack[i];
+    }
+
+    std::vector<KernelCase> cases = {
+        {"absMax",
+            [](const float* d, size_t n) { return static_cast<double>(AudioKernels::absMax(d, n)); },
+            [](const double* d, size_t n) { return AudioKernels::absMax(d, n); }},
+        {"absSum",
+            [](const float* d, size_t n) { return AudioKernels::absSum(d, n); },
+            [](const double* d, size_t n) { return AudioKernels::absSum(d, n); }},
+        {"sumSquares",
+            [](const float* d, size_t n) { return AudioKernels::sumSquares(d, n); },
+            [](const double* d, size_t n) { return AudioKernels::sumSquares(d, n); }},
+        {"differenceEnergy",
+            [](const float* d, size_t n) { return AudioKernels::differenceEnergy(d, n); },
+            [](const double* d, size_t n) { return AudioKernels::differenceEnergy(d, n); }},
+        {"zeroCrossings",
+            [](const float* d, size_t n) { return static_cast<double>(AudioKernels::zeroCrossings(d, n)); },
+            [](const double* d, size_t n) { return static_cast<double>(AudioKernels::zeroCrossings(d, n)); }},
+        {"minMax",
+            [](const float* d, size_t n) { float lo, hi; AudioKernels::minMax(d, n, lo, hi); return static_cast<double>(hi - lo); },
+            nullptr},
+        {"differenceAbsSum",
+            [](const float* d, size_t n) { return AudioKernels::differenceAbsSum(d, n); },
+            nullptr},
+        {"crossingDifferenceSum",
+            [](const float* d, size_t n) { return AudioKernels::crossingDifferenceSum(d, n); },
+            nullptr}
+    };
+
+    std::vector<AudioKernels::Isa> isas;
+    for (AudioKernels::Isa isa : {AudioKernels::Isa::SCALAR, AudioKernels::Isa::SSE2, AudioKernels::Isa::AVX2, AudioKernels::Isa::NEON}) {
+        if (AudioKernels::isSupported(isa)) {
+            isas.push_back(isa);
+        }
+    }
+
+    std::printf("Kernel benchmark: %zu samples (%zu min @ %zu Hz), best of %d runs\n",
+                count, TRACK_SECONDS / 60, SAMPLE_RATE, REPEATS);
+    std::printf("Detected ISA: %s\n\n", AudioKernels::getIsaName(AudioKernels::detectIsa()));
+    std::printf("%-22s %-7s %12s %12s %10s\n", "kernel", "isa", "f64 ms", "f32 ms", "speedup");
+
+    bool ok = true;
+    for (const KernelCase& kernelCase : cases) {
+        double baseline = 0.0;
+        double floatReference = 0.0;
+        double doubleReference = 0.0;
+
+        for (AudioKernels::Isa isa : isas) {
+            AudioKernels::setIsa(isa);
+
+            // Every vector kernel must agree with the scalar one, which runs first
+            double floatResult = kernelCase.floatKernel(floatTrack.data(), count);
+            double doubleResult = kernelCase.doubleKernel ? kernelCase.doubleKernel(doubleTrack.data(), count) : 0.0;
+            if (isa == AudioKernels::Isa::SCALAR) {
+                floatReference = floatResult;
+                doubleReference = doubleResult;
+            } else if (!matches(floatResult, floatReference) || !matches(doubleResult, doubleReference)) {
+                std::printf("%-22s %-7s MISMATCH f32 %.10g vs %.10g, f64 %.10g vs %.10g\n", kernelCase.name,
+                            AudioKernels::getIsaName(isa), floatResult, floatReference, doubleResult, doubleReference);
+                ok = false;
+            }
+
+            double doubleMs = -1.0;
+            if (kernelCase.doubleKernel) {
+                doubleMs = bestMilliseconds([&]() { return kernelCase.doubleKernel(doubleTrack.data(), count); });
+            }
+            double floatMs = bestMilliseconds([&]() { return kernelCase.floatKernel(floatTrack.data(), count); });
+
+            // Speedup of the float32 path against the scalar reference (double when available)
+            if (isa == AudioKernels::Isa::SCALAR) {
+                baseline = doubleMs > 0.0 ? doubleMs : floatMs;
+            }
+
+            if (doubleMs > 0.0) {
+                std::printf("%-22s %-7s %12.2f %12.2f %9.1fx\n", kernelCase.name, AudioKernels::getIsaName(isa),
+                            doubleMs, floatMs, baseline / floatMs);
+            } else {
+                std::printf("%-22s %-7s %12s %12.2f %9.1fx\n", kernelCase.name, AudioKernels::getIsaName(isa),
+                            "-", floatMs, baseline / floatMs);
+            }
+        }
+    }
+
+    AudioKernels::setIsa(AudioKernels::detectIsa());
+    if (!ok) {
+        std::printf("\nVector kernels disagree with the scalar reference beyond %g relative\n", TOLERANCE);
+    }
+    return ok ? 0 : 1;
+}
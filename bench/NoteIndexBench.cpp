@@ -0,0 +1,151 @@
+#include "NodeManager.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+// Range queries and edits on the Editor's note index, checked against a full scan.
+// The charts mix TAPs with HOLDs, including HOLDs that span the whole song, which
+// must not pull the notes before the visible window into the query.
+
+namespace {
+
+using App::Core::NodeManager;
+using App::Core::Note;
+
+const double SONG_SECONDS = 10000.0;
+const double WINDOW_SECONDS = 5.0;
+const int QUERIES = 2000;
+
+struct Chart {
+    const char* name;
+    size_t taps;
+    size_t holds;     // Random lengths up to 2 s
+    size_t longHolds; // Spanning most of the song
+};
+
+void fill(NodeManager& manager, const Chart& chart, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> time(0.0, SONG_SECONDS);
+    std::uniform_real_distribution<double> holdLength(0.1, 2.0);
+    std::uniform_int_distribution<int> lane(0, 1);
+
+    manager.clear();
+    for (size_t i = 0; i < chart.taps; i++) {
+        manager.addNote(lane(rng), time(rng));
+    }
+    for (size_t i = 0; i < chart.holds; i++) {
+        double start = time(rng);
+        manager.addHoldNote(lane(rng), start, start + holdLength(rng));
+    }
+    for (size_t i = 0; i < chart.longHolds; i++) {
+        manager.addHoldNote(lane(rng), i * 0.5, SONG_SECONDS - i * 0.5);
+    }
+}
+
+// What queryRange must return, straight from every note
+void scan(const std::vector<const Note*>& all, double startTime, double endTime, int lane, std::vector<const Note*>& result) {
+    result.clear();
+    for (const Note* note : all) {
+        if ((lane == NodeManager::ALL_LANES || note->lane == lane) &&
+            note->timestamp <= endTime && note->endTimestamp >= startTime) {
+            result.push_back(note);
+        }
+    }
+}
+
+} // namespace
+
+int main() {
+    const Chart charts[] = {
+        {"taps", 10000, 0, 0},
+        {"taps + 1 song-long hold", 10000, 0, 1},
+        {"hold heavy", 5000, 5000, 50},
+        {"100k taps + 1 song-long hold", 100000, 0, 1},
+    };
+
+    std::printf("Note index benchmark: %.0f s song, %.0f s windows, %d queries per chart\n\n",
+                SONG_SECONDS, WINDOW_SECONDS, QUERIES);
+    std::printf("%-30s %8s %10s %12s %12s %14s %8s\n",
+                "chart", "notes", "hits/q", "query ns", "scan ns", "move ns", "check");
+
+    bool ok = true;
+    for (const Chart& chart : charts) {
+        NodeManager manager;
+        fill(manager, chart, 7);
+
+        std::vector<const Note*> all;
+        manager.getAllNotes(all);
+
+        std::mt19937 rng(11);
+        std::uniform_real_distribution<double> windowStart(0.0, SONG_SECONDS - WINDOW_SECONDS);
+        std::vector<double> starts(QUERIES);
+        for (double& start : starts) {
+            start = windowStart(rng);
+        }
+
+        std::vector<const Note*> result;
+        std::vector<const Note*> expected;
+        size_t hits = 0;
+
+        auto queryStart = std::chrono::steady_clock::now();
+        for (double start : starts) {
+            manager.queryRange(start, start + WINDOW_SECONDS, NodeManager::ALL_LANES, result);
+            hits += result.size();
+        }
+        auto queryEnd = std::chrono::steady_clock::now();
+
+        auto scanStart = std::chrono::steady_clock::now();
+        for (double start : starts) {
+            scan(all, start, start + WINDOW_SECONDS, NodeManager::ALL_LANES, expected);
+        }
+        auto scanEnd = std::chrono::steady_clock::now();
+
+        bool match = true;
+        for (double start : starts) {
+            for (int lane : {NodeManager::ALL_LANES, 0, 1}) {
+                manager.queryRange(start, start + WINDOW_SECONDS, lane, result);
+                scan(all, start, start + WINDOW_SECONDS, lane, expected);
+                match = match && result == expected;
+            }
+        }
+
+        // A drag: the note moves every frame, the index follows incrementally
+        int draggedId = all[all.size() / 2]->id;
+        auto moveStart = std::chrono::steady_clock::now();
+        for (int i = 0; i < QUERIES; i++) {
+            manager.moveNote(draggedId, i % 2, windowStart(rng));
+        }
+        auto moveEnd = std::chrono::steady_clock::now();
+
+        // Removed slots are reused by the next additions
+        for (size_t i = 0; i < all.size(); i += 97) {
+            manager.removeNote(all[i]->id);
+        }
+        for (int i = 0; i < 50; i++) {
+            double start = windowStart(rng);
+            manager.addHoldNote(i % 2, start, start + 1.0);
+        }
+
+        manager.getAllNotes(all);
+        match = match && all.size() == manager.getNoteCount() &&
+                std::is_sorted(all.begin(), all.end(), [](const Note* a, const Note* b) {
+                    return a->timestamp != b->timestamp ? a->timestamp < b->timestamp : a->id < b->id;
+                });
+        for (double start : starts) {
+            manager.queryRange(start, start + WINDOW_SECONDS, NodeManager::ALL_LANES, result);
+            scan(all, start, start + WINDOW_SECONDS, NodeManager::ALL_LANES, expected);
+            match = match && result == expected;
+        }
+
+        double queryNs = std::chrono::duration<double, std::nano>(queryEnd - queryStart).count() / QUERIES;
+        double scanNs = std::chrono::duration<double, std::nano>(scanEnd - scanStart).count() / QUERIES;
+        double moveNs = std::chrono::duration<double, std::nano>(moveEnd - moveStart).count() / QUERIES;
+        std::printf("%-30s %8zu %10.1f %12.0f %12.0f %14.0f %8s\n", chart.name, manager.getNoteCount(),
+                    static_cast<double>(hits) / QUERIES, queryNs, scanNs, moveNs, match ? "OK" : "MISMATCH");
+        ok = match && ok;
+    }
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,180 @@
+#include "GameplayCore.hpp"
+#include "BenchCharts.hpp"
+#include "Replay.hpp"
+#include "ChartFile.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+// Re-judges replays headlessly and checks they land on the recorded stats.
+//
+//   replay_verifier                        self check on a synthetic play
+//   replay_verifier chart.chart a.nrr ...  verify replays against a chart
+
+namespace {
+
+using App::Windows::GameplayCore;
+using App::Windows::GameStats;
+using App::Windows::Replay;
+using App::Windows::ScriptedInput;
+
+using Bench::Play;
+using Bench::makePlay;
+
+// Drives the core like the Player does: frames of uneven length, with inputs
+// seen one frame late and sometimes stamped before the previous update
+void playLive(GameplayCore& core, const Play& play, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> frameLength(0.004, 0.034);
+
+    core.reset();
+    size_t next = 0;
+    double now = 0.0;
+    while (now < play.duration) {
+        while (next < play.inputs.size() && play.inputs[next].time <= now) {
+            const ScriptedInput& input = play.inputs[next++];
+            if (input.pressed) {
+                core.press(input.lane, input.time);
+            } else {
+                core.release(input.lane, input.time);
+            }
+        }
+        core.update(now);
+        core.clearEvents();
+        now += frameLength(rng);
+    }
+}
+
+void printStats(const char* label, const GameStats& stats) {
+    std::printf("  %-9s score %d  acc %.4f  P/G/G/M %d/%d/%d/%d  combo %d  max %d\n", label, stats.score,
+                stats.accuracy, stats.perfect, stats.great, stats.good, stats.miss, stats.combo, stats.maxCombo);
+}
+
+// Re-simulates at frameTime and reports how many times faster than real time it ran
+bool verifyTimed(GameplayCore& core, const Replay& replay, double frameTime) {
+    GameStats result;
+    auto start = std::chrono::steady_clock::now();
+    bool match = replay.verify(core, result, frameTime);
+    auto end = std::chrono::steady_clock::now();
+    double seconds = std::chrono::duration<double>(end - start).count();
+
+    std::printf("  frame %8.4f s  %10.2f ms  %12.0fx real time  %s\n", frameTime, seconds * 1000.0,
+                replay.endTime / std::max(seconds, 1e-9), match ? "OK" : "MISMATCH");
+    if (!match) {
+        printStats("recorded", replay.stats);
+        printStats("replayed", result);
+    }
+    return match;
+}
+
+// Crafted files that would hang or blow up a re-simulation must be refused
+bool craftedCheck(GameplayCore& core, const Replay& valid) {
+    struct Case {
+        const char* name;
+        void (*corrupt)(Replay&);
+        bool readable; // Rejected by verify() rather than by deserialize()
+    };
+    const Case cases[] = {
+        {"zero hold tick interval", [](Replay& r) { r.settings.holdTickInterval = 0.0; }, false},
+        {"negative judgement window", [](Replay& r) { r.settings.judgementWindow = -0.2; }, false},
+        {"NaN good window", [](Replay& r) { r.settings.goodWindow = std::nan(""); }, false},
+        {"NaN end time", [](Replay& r) { r.endTime = std::nan(""); }, false},
+        {"huge end time", [](Replay& r) { r.endTime = 1e300; }, false},
+        {"negative end time", [](Replay& r) { r.endTime = -1.0; }, false},
+        {"NaN input time", [](Replay& r) { r.inputs[1].time = std::nan(""); }, false},
+        {"unsorted inputs", [](Replay& r) { std::swap(r.inputs.front().time, r.inputs.back().time); }, false},
+        {"end long after the chart", [](Replay& r) { r.endTime += 3600.0; }, true},
+    };
+
+    bool ok = true;
+    std::printf("crafted replays\n");
+    for (const Case& craftedCase : cases) {
+        Replay crafted = valid;
+        craftedCase.corrupt(crafted);
+        std::vector<char> bytes = crafted.serialize();
+
+        Replay replay;
+        bool read = Replay::deserialize(bytes.data(), bytes.size(), replay);
+        GameStats result;
+        bool refused = craftedCase.readable ? read && !replay.verify(core, result) : !read;
+        std::printf("  %-28s %s\n", craftedCase.name, refused ? "refused" : "ACCEPTED");
+        ok = refused && ok;
+    }
+    std::printf("\n");
+    return ok;
+}
+
+int selfCheck() {
+    bool ok = true;
+
+    for (size_t noteCount : {size_t(1000), size_t(100000)}) {
+        Play play = makePlay(noteCount, 7);
+        GameplayCore core;
+        core.loadNotes(play.notes);
+        playLive(core, play, 11);
+
+        Replay recorded = Replay::record(core);
+        std::vector<char> bytes = recorded.serialize();
+        Replay replay;
+        if (!Replay::deserialize(bytes.data(), bytes.size(), replay)) {
+            std::printf("%zu notes: replay failed to read back\n", noteCount);
+            return 1;
+        }
+
+        std::printf("%zu notes, %zu inputs, %.0f s of song, %zu byte replay\n", noteCount, replay.inputs.size(),
+                    replay.endTime, bytes.size());
+        printStats("recorded", replay.stats);
+        for (double frameTime : {1.0 / 240.0, 1.0 / 60.0, 0.25, 1.0, 10.0}) {
+            ok = verifyTimed(core, replay, frameTime) && ok;
+        }
+        std::printf("\n");
+
+        if (noteCount == 1000) {
+            ok = craftedCheck(core, replay) && ok;
+        }
+    }
+
+    return ok ? 0 : 1;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc == 1) {
+        return selfCheck();
+    }
+    if (argc < 3) {
+        std::fprintf(stderr, "usage: %s [chart.chart replay.nrr...]\n", argv[0]);
+        return 2;
+    }
+
+    App::Windows::ChartFile chart;
+    if (!chart.open(argv[1])) {
+        std::fprintf(stderr, "%s\n", chart.getLastError().c_str());
+        return 2;
+    }
+    GameplayCore core;
+    core.loadChart(chart);
+
+    bool ok = true;
+    for (int i = 2; i < argc; i++) {
+        Replay replay;
+        if (!Replay::load(argv[i], replay)) {
+            ok = false;
+            continue;
+        }
+
+        std::printf("%s\n", argv[i]);
+        if (replay.chartHash != core.getChartHash()) {
+            std::printf("  recorded on another chart\n");
+            ok = false;
+            continue;
+        }
+        ok = verifyTimed(core, replay, 1.0) && ok;
+    }
+
+    return ok ? 0 : 1;
+}
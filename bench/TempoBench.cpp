@@ -0,0 +1,125 @@
+#include "TempoEstimator.hpp"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+// Tempo estimation on synthetic 5-minute 44.1kHz drum tracks of known tempo and
+// first beat: kicks on the beats, snares on 2 and 4, hats on the eighths, a
+// sustained bass line and noise, with a few ms of timing jitter. Tempos outside
+// the estimator's octave are expected back doubled or halved into it
+
+namespace {
+
+const double SAMPLE_RATE = 44100.0;
+const double TRACK_SECONDS = 300.0;
+const double MIN_BPM = 90.0;
+
+struct Track {
+    double bpm;
+    double offset;
+};
+
+void addBurst(std::vector<float>& samples, double time, double frequency, double decay, double gain, std::mt19937& rng,
+              double noise) {
+    std::normal_distribution<float> white(0.0f, 1.0f);
+    size_t start = static_cast<size_t>(std::max(0.0, time * SAMPLE_RATE));
+    size_t length = static_cast<size_t>(decay * 5.0 * SAMPLE_RATE);
+    for (size_t i = 0; i < length && start + i < samples.size(); i++) {
+        double t = i / SAMPLE_RATE;
+        double tone = std::sin(2.0 * M_PI * frequency * t) * (1.0 - noise) + white(rng) * noise;
+        samples[start + i] += static_cast<float>(gain * std::exp(-t / decay) * tone);
+    }
+}
+
+std::vector<float> makeTrack(const Track& track, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::normal_distribution<double> jitter(0.0, 0.003);
+    std::normal_distribution<float> white(0.0f, 0.02f);
+
+    std::vector<float> samples(static_cast<size_t>(SAMPLE_RATE * TRACK_SECONDS));
+    for (size_t i = 0; i < samples.size(); i++) {
+        double t = i / SAMPLE_RATE;
+        samples[i] = static_cast<float>(0.1 * std::sin(2.0 * M_PI * 55.0 * t)) + white(rng);
+    }
+
+    double beat = 60.0 / track.bpm;
+    int beatIndex = 0;
+    for (double time = track.offset; time < TRACK_SECONDS; time += beat, beatIndex++) {
+        addBurst(samples, time + jitter(rng), 60.0, 0.08, 0.6, rng, 0.05);
+        if (beatIndex % 2 == 1) {
+            addBurst(samples, time + jitter(rng), 200.0, 0.05, 0.4, rng, 0.7);
+        }
+        addBurst(samples, time + beat * 0.5 + jitter(rng), 8000.0, 0.01, 0.15, rng, 0.9);
+    }
+    return samples;
+}
+
+// Same layout as the analyzer's spectrogram stage
+Spectrogram makeSpectrogram(const std::vector<float>& samples) {
+    SpectrumStream bandMapper;
+    bandMapper.configure(SAMPLE_RATE, Spectrogram::BAND_COUNT);
+
+    Spectrogram spectrogram;
+    spectrogram.bandCount = static_cast<int>(bandMapper.getBandCount());
+    spectrogram.frameRate = SAMPLE_RATE / Spectrogram::HOP_SIZE;
+    spectrogram.firstFrameTime = SpectrumStream::WINDOW_SIZE * 0.5 / SAMPLE_RATE;
+    spectrogram.frameCount = static_cast<int>((samples.size() - SpectrumStream::WINDOW_SIZE) / Spectrogram::HOP_SIZE + 1);
+    spectrogram.tiles.assign(static_cast<size_t>(spectrogram.getTileCount()) * Spectrogram::TILE_FRAMES * spectrogram.bandCount, 0);
+
+    std::vector<float> scratch(SpectrumStream::WINDOW_SIZE);
+    std::vector<std::complex<float>> bins(bandMapper.getBinCount());
+    std::vector<float> bands(spectrogram.bandCount);
+    for (int frame = 0; frame < spectrogram.frameCount; frame++) {
+        bandMapper.computeFrame(samples.data() + static_cast<size_t>(frame) * Spectrogram::HOP_SIZE, bands.data(),
+                                scratch.data(), bins.data());
+        uint8_t* column = spectrogram.tiles.data() +
+                          static_cast<size_t>(frame / Spectrogram::TILE_FRAMES) * Spectrogram::TILE_FRAMES * spectrogram.bandCount +
+                          frame % Spectrogram::TILE_FRAMES;
+        for (int band = 0; band < spectrogram.bandCount; band++) {
+            column[static_cast<size_t>(band) * Spectrogram::TILE_FRAMES] = static_cast<uint8_t>(bands[band] * 255.0f + 0.5f);
+        }
+    }
+    return spectrogram;
+}
+
+} // namespace
+
+int main() {
+    const Track tracks[] = {
+        {70.0, 0.35}, {92.0, 1.10}, {120.0, 0.00}, {128.0, 0.231}, {140.0, 0.05}, {150.5, 0.62}, {174.0, 0.40}, {190.0, 0.12},
+    };
+
+    std::printf("Tempo benchmark: synthetic %.0f s tracks at %.0f Hz\n\n", TRACK_SECONDS, SAMPLE_RATE);
+    std::printf("%10s %10s %10s %10s %12s %10s %10s\n", "track bpm", "found bpm", "offset s", "found s", "offset err ms",
+                "confidence", "ms");
+
+    int failures = 0;
+    unsigned seed = 1;
+    for (const Track& track : tracks) {
+        Spectrogram spectrogram = makeSpectrogram(makeTrack(track, seed++));
+
+        auto start = std::chrono::steady_clock::now();
+        TempoEstimate estimate = TempoEstimator(MIN_BPM).estimate(spectrogram);
+        auto end = std::chrono::steady_clock::now();
+        double ms = std::chrono::duration<double, std::milli>(end - start).count();
+
+        double expectedBpm = track.bpm;
+        while (expectedBpm < MIN_BPM) expectedBpm *= 2.0;
+        while (expectedBpm >= MIN_BPM * 2.0) expectedBpm *= 0.5;
+
+        // Offsets are compared on the circle of the shorter beat, a halved tempo may start on either
+        double beat = 60.0 / std::max(track.bpm, expectedBpm);
+        double error = std::fmod(estimate.offset - track.offset + beat * 1.5, beat) - beat * 0.5;
+        bool ok = std::abs(estimate.bpm - expectedBpm) < 0.05 && std::abs(error) < 0.012;
+        failures += ok ? 0 : 1;
+
+        std::printf("%10.2f %10.2f %10.3f %10.3f %12.1f %10.2f %10.2f%s\n", track.bpm, estimate.bpm, track.offset,
+                    estimate.offset, error * 1000.0, estimate.confidence, ms, ok ? "" : "  MISMATCH");
+    }
+
+    std::printf("\n%d/%zu tracks matched\n", static_cast<int>(sizeof(tracks) / sizeof(tracks[0])) - failures,
+                sizeof(tracks) / sizeof(tracks[0]));
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#include "AudioAnalazyer.hpp"
+
+#define ANALYSIS_CACHE_DIR "analysis_cache"
+#define ANALYSIS_CACHE_MAX_BYTES (256ULL * 1024 * 1024)
+
+/**
+ * AnalysisCache - Persistent store for finished AudioWaveform results
+ *
+ * Entries are keyed by a hash of the raw audio file bytes combined with the
+ * analyzer version, so editing or re-encoding a song, or changing the analysis
+ * code, never returns stale data. Each entry is one compact binary file; the
+ * directory is kept under a byte budget by evicting the least recently used
+ * entries (a cache hit refreshes the entry's modification time).
+ */
+class AnalysisCache {
+private:
+    std::string directory;
+    uint64_t maxBytes;
+
+    std::string entryPath(uint64_t key) const;
+    void evict();
+
+public:
+    AnalysisCache(const std::string& directory = ANALYSIS_CACHE_DIR, uint64_t maxBytes = ANALYSIS_CACHE_MAX_BYTES);
+
+    static uint64_t hashFile(const std::string& path, uint64_t offset = 0, uint64_t length = 0);
+    static uint64_t hashBytes(const void* data, size_t size, uint64_t seed = 0);
+    static uint64_t makeKey(uint64_t contentHash, uint32_t analyzerVersion);
+
+    bool load(uint64_t key, AudioWaveform& waveform);
+    bool store(uint64_t key, const AudioWaveform& waveform);
+
+    static std::vector<char> serialize(const AudioWaveform& waveform);
+    static bool deserialize(const char* data, size_t size, AudioWaveform& waveform);
+};
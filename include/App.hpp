@@ -4,6 +4,7 @@
 
 #include "Editor.hpp"
 #include "Player.hpp"
+#include "FrameScheduler.hpp"
 
 namespace App
 {
@@ -30,4 +31,5 @@ namespace App
 
     void run();
     void showMainMenu(AppMode& currentMode);
+    void showFramePacingWindow(bool& open);
 }
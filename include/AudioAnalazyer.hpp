@@ -12,8 +12,33 @@
 #include <thread>
 #include <chrono>
 #include <cstring>
+#include <cstdint>
 #include <sndfile.h>
 
+#include "SpectrumStream.hpp"
+
+class ThreadPool;
+class AnalysisCache;
+struct AudioSectionReader;
+
+// Encoded audio stored in a file, either the whole file or a byte range of a container such as a .chart
+struct AudioSource {
+    std::string path;
+    uint64_t offset = 0;
+    uint64_t length = 0; // 0 reads up to the end of the file
+
+    AudioSource() = default;
+    AudioSource(const std::string& path, uint64_t offset = 0, uint64_t length = 0)
+        : path(path), offset(offset), length(length) {}
+
+    bool empty() const { return path.empty(); }
+    bool isSection() const { return offset != 0 || length != 0; }
+    bool operator==(const AudioSource& other) const {
+        return path == other.path && offset == other.offset && length == other.length;
+    }
+    bool operator!=(const AudioSource& other) const { return !(*this == other); }
+};
+
 struct LoudSection {
     double start;
     double end;
@@ -36,12 +61,46 @@ struct BeatFeatures {
     std::vector<double> rhythmIntensity;
 };
 
+// One level of the waveform pyramid; every entry covers samplesPerPixel samples
 struct WaveformLevel {
     std::vector<double> peaks;
     std::vector<double> rms;
+    std::vector<float> minimums;
+    std::vector<float> maximums;
+    std::vector<float> bass;
+    std::vector<float> onset;
     int samplesPerPixel;
 };
 
+/**
+ * Spectrogram - Whole-track log-magnitude STFT, one frame every HOP_SIZE samples
+ *
+ * Bands are SpectrumStream's log-spaced bands (lowest first), quantized to
+ * 0..255 over its DYNAMIC_RANGE. Frames are grouped into tiles of TILE_FRAMES;
+ * inside a tile every band is one contiguous row of TILE_FRAMES bytes, so a
+ * tile is a ready-made TILE_FRAMES x bandCount image and a visible time range
+ * only touches the tiles it overlaps. The last tile is padded with zeros.
+ */
+struct Spectrogram {
+    static constexpr int BAND_COUNT = 128;
+    static constexpr int HOP_SIZE = 512;
+    static constexpr int TILE_FRAMES = 256;
+
+    std::vector<uint8_t> tiles;
+    int bandCount = 0;
+    int frameCount = 0;
+    double frameRate = 0.0;      // Frames per second
+    double firstFrameTime = 0.0; // Center of frame 0's window, in seconds
+
+    bool empty() const { return frameCount == 0 || bandCount == 0; }
+    int getTileCount() const { return (frameCount + TILE_FRAMES - 1) / TILE_FRAMES; }
+    const uint8_t* getTile(int tile) const { return tiles.data() + static_cast<size_t>(tile) * TILE_FRAMES * bandCount; }
+    uint8_t at(int frame, int band) const {
+        return getTile(frame / TILE_FRAMES)[static_cast<size_t>(band) * TILE_FRAMES + frame % TILE_FRAMES];
+    }
+    double getFrameTime(int frame) const { return firstFrameTime + frame / frameRate; }
+};
+
 struct AnalysisProgress {
     double progress;
     std::string stage;
@@ -49,7 +108,7 @@ struct AnalysisProgress {
 
 struct AudioWaveform {
     std::vector<double> data;
-    std::map<std::string, WaveformLevel> levels;
+    std::vector<WaveformLevel> levels; // Finest first, each level halves the previous one
     std::vector<double> frequencyData;
     BeatFeatures beatFeatures;
     AudioStats audioStats;
@@ -57,6 +116,11 @@ struct AudioWaveform {
     double duration;
     int totalSamples;
     double originalSampleRate;
+    Spectrogram spectrogram;
+
+    const WaveformLevel* findLevel(double samplesPerPixel) const;
+    // Coarsest level that still has at least one entry per pixel, the finest one if none does
+    const WaveformLevel* findLevelAtMost(double samplesPerPixel) const;
 };
 
 /**
@@ -70,30 +134,48 @@ struct AudioWaveform {
  *
  * This ensures that bass drops, drum hits, and rhythmic elements are prominently
  * displayed in the waveform, making it easier to create accurate charts.
+ *
+ * Audio is decoded in fixed-size blocks and every analysis stage consumes those
+ * blocks incrementally, so memory use does not grow with the track length.
+ * The stages of a block run concurrently on a worker pool, each split into
+ * chunks, while the next block is being decoded. That includes the
+ * whole-track Spectrogram, so showing it later costs no analysis at all.
+ *
+ * Finished results are kept in an on-disk AnalysisCache, so reopening a song
+ * that was analyzed before skips decoding entirely. Bump VERSION whenever the
+ * analysis output changes to invalidate old entries.
  */
 class AudioAnalyzer {
+public:
+    static constexpr uint32_t VERSION = 2;
+
 private:
     std::function<void(const AnalysisProgress&)> progressCallback;
-    size_t maxFileSize;
+    std::unique_ptr<ThreadPool> workerPool;
+    std::unique_ptr<AnalysisCache> analysisCache;
 
-    std::string cachedAudioFile;
-    std::vector<double> cachedAudioData;
+    AudioSource cachedAudioSource;
+    SNDFILE* spectrumFile;
+    std::unique_ptr<AudioSectionReader> spectrumSection;
+    SF_INFO spectrumInfo;
+    std::vector<float> spectrumBuffer; // Decode scratch of the spectrum stream
+    SpectrumStream spectrumStream;
     double cachedSampleRate;
     double cachedDuration;
 
     void updateProgress(double progress, const std::string& stage);
-    std::vector<double> loadAudioFile(const std::string& filename, double& sampleRate, double& duration);
-    WaveformLevel generateWaveformLevel(const std::vector<double>& channelData, int samplesPerPixel);
-    std::vector<double> analyzeFrequencyContent(const std::vector<double>& channelData, double sampleRate);
-    BeatFeatures analyzeBeatFeatures(const std::vector<double>& channelData, double sampleRate);
-    AudioStats calculateAudioStats(const std::vector<double>& channelData, double sampleRate);
+    SNDFILE* openAudioFile(const AudioSource& source, SF_INFO& sfInfo, std::unique_ptr<AudioSectionReader>& section);
+    sf_count_t readMonoBlock(SNDFILE* file, const SF_INFO& sfInfo, std::vector<float>& buffer, sf_count_t frames);
 
 public:
-    AudioAnalyzer(size_t maxFileSize = 500 * 1024 * 1024);
+    AudioAnalyzer();
+    ~AudioAnalyzer();
     void setProgressCallback(std::function<void(const AnalysisProgress&)> callback);
-    AudioWaveform analyzeAudio(const std::string& filename);
-    std::vector<float> getSpectrumAtTime(const std::string& filename, double time, int spectrumSize = 64);
-    void cacheAudioForSpectrum(const std::string& filename);
+    AudioWaveform analyzeAudio(const AudioSource& source);
+    // Fills spectrum (its size is the band count) with the bands heard at time, decoding only
+    // the samples played since the previous call
+    void getSpectrumAtTime(const AudioSource& source, double time, std::vector<float>& spectrum);
+    const SpectrumStream& getSpectrumStream() const { return spectrumStream; }
+    void cacheAudioForSpectrum(const AudioSource& source);
     void clearAudioCache();
 };
-
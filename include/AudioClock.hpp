@@ -0,0 +1,44 @@
+#pragma once
+
+#include <chrono>
+
+/**
+ * AudioClock - Smooth playback clock built from coarse audio positions
+ *
+ * The position reported by the audio device only moves once per mixed buffer,
+ * and is only polled once per frame. Each update pairs that position with a
+ * steady_clock timestamp; between updates the clock extrapolates from the last
+ * anchor at the playback rate. Small disagreements with the device are slewed
+ * out gradually instead of snapping, larger ones (seeks, stalls) re-anchor.
+ *
+ * While running the reported time never goes backwards and is shifted back by
+ * the output latency, so it matches what is being heard rather than what has
+ * been handed to the device.
+ */
+class AudioClock {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    AudioClock();
+
+    // Feeds a fresh device position (seconds) and returns the smoothed time
+    double update(double devicePosition, bool playing, double rate, Clock::time_point now = Clock::now());
+    // Smoothed time at now, extrapolated from the last update
+    double getTime(Clock::time_point now = Clock::now()) const;
+    // Time that was being heard at an arbitrary instant, e.g. a timestamped key press
+    double getTimeAt(Clock::time_point when) const;
+    void reset(double position = 0.0);
+
+    void setLatency(double seconds) { latency = seconds; }
+    double getLatency() const { return latency; }
+
+private:
+    bool running;
+    double anchorPosition;         // Device timeline position at anchorTime
+    Clock::time_point anchorTime;
+    double rate;                   // Seconds of audio per second of wall time
+    double lastReported;
+    double latency;
+
+    double extrapolate(Clock::time_point now) const;
+};
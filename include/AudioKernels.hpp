@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstddef>
+
+/**
+ * AudioKernels - Vectorized reductions used by the audio analysis stages
+ *
+ * Every kernel has a scalar implementation plus SSE2/AVX2 (x86) and NEON (ARM)
+ * variants. The best instruction set supported by the running CPU is picked the
+ * first time a kernel is called; setIsa() can force a narrower one.
+ *
+ * The float overloads process twice as many samples per instruction as the
+ * double ones, which is why the analyzer decodes and reduces in float32. Their
+ * sums are carried over to double every block, so they stay within 1e-6 of the
+ * scalar reference however long the track is.
+ *
+ * Kernels that look at neighbouring samples (difference energy, zero crossings)
+ * only consider pairs inside the range, i.e. count - 1 pairs starting at data[1].
+ */
+namespace AudioKernels {
+    enum class Isa {
+        SCALAR,
+        SSE2,
+        AVX2,
+        NEON
+    };
+
+    Isa detectIsa();
+    Isa getIsa();
+    bool setIsa(Isa isa);
+    bool isSupported(Isa isa);
+    const char* getIsaName(Isa isa);
+
+    // max(|x|)
+    float absMax(const float* data, size_t count);
+    double absMax(const double* data, size_t count);
+
+    // sum(|x|)
+    double absSum(const float* data, size_t count);
+    double absSum(const double* data, size_t count);
+
+    // sum(x * x)
+    double sumSquares(const float* data, size_t count);
+    double sumSquares(const double* data, size_t count);
+
+    // sum((x[i] - x[i-1])^2)
+    double differenceEnergy(const float* data, size_t count);
+    double differenceEnergy(const double* data, size_t count);
+
+    // Number of i where x[i] and x[i-1] lie on different sides of zero
+    size_t zeroCrossings(const float* data, size_t count);
+    size_t zeroCrossings(const double* data, size_t count);
+
+    // min(x) and max(x), count must be at least 1
+    void minMax(const float* data, size_t count, float& minimum, float& maximum);
+
+    // sum(|x[i] - x[i-1]|), over all pairs and over zero-crossing pairs only
+    double differenceAbsSum(const float* data, size_t count);
+    double crossingDifferenceSum(const float* data, size_t count);
+} // AudioKernels
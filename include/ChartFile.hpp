@@ -0,0 +1,87 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+#include "Common.hpp"
+#include "NodeManager.hpp"
+
+namespace App {
+namespace Windows {
+
+    /**
+     * ChartFile - Read-only, memory-mapped view of a .chart file
+     *
+     * open() maps the file and validates the header and section sizes, but
+     * touches nothing else, so only the pages that are actually read get loaded.
+     * The embedded audio, the note records and the optional analysis section are
+     * exposed as byte ranges inside the mapping; nothing is copied.
+     *
+     * Versions 1 and 2 store header, audio, notes back to back. Version 3 adds a
+     * directory of ChartSection entries right after the header and stores notes
+     * as aligned ChartNoteRecord entries ahead of the audio.
+     *
+     * Pointers returned by the getters stay valid until close() or destruction,
+     * so a sound streamed from getAudioData() must be unloaded first.
+     * Falls back to reading the whole file where mapping is unavailable.
+     */
+    class ChartFile {
+        private:
+            std::string path;
+            const unsigned char* data;
+            size_t size;
+            bool mapped;
+#ifdef _WIN32
+            void* fileHandle;
+            void* mappingHandle;
+#endif
+            std::vector<unsigned char> buffer;
+
+            ChartHeader header;
+            size_t audioOffset;
+            size_t audioSize;
+            size_t notesOffset;
+            size_t noteRecordSize;
+            size_t analysisOffset;
+            size_t analysisSize;
+            std::string lastError;
+
+            bool mapFile(const std::string& filepath);
+            bool validate();
+            bool validateSections();
+
+        public:
+            ChartFile();
+            ~ChartFile();
+            ChartFile(const ChartFile&) = delete;
+            ChartFile& operator=(const ChartFile&) = delete;
+
+            bool open(const std::string& filepath);
+            void close();
+            bool isOpen() const { return data != nullptr; }
+
+            const std::string& getPath() const { return path; }
+            const std::string& getLastError() const { return lastError; }
+            const ChartHeader& getHeader() const { return header; }
+
+            const unsigned char* getAudioData() const { return data ? data + audioOffset : nullptr; }
+            size_t getAudioOffset() const { return audioOffset; }
+            size_t getAudioSize() const { return audioSize; }
+
+            // Serialized AudioWaveform stored with the chart, if any
+            const unsigned char* getAnalysisData() const { return data && analysisSize ? data + analysisOffset : nullptr; }
+            size_t getAnalysisSize() const { return analysisSize; }
+
+            // Packed note records, getNoteCount() entries of getNoteRecordSize() bytes
+            const unsigned char* getNoteRecords() const { return data ? data + notesOffset : nullptr; }
+            size_t getNoteRecordSize() const { return noteRecordSize; }
+            size_t getNoteCount() const { return header.notesCount; }
+            Core::Note getNote(size_t index) const;
+            // Direct view of a version 3 note table, nullptr for older versions
+            const ChartNoteRecord* getNoteTable() const;
+    };
+
+} // Windows
+} // App
@@ -4,6 +4,8 @@
 #include <tuple>
 #include <cstdint>
 
+#define CHART_FORMAT_VERSION 3
+
 namespace App {
 namespace Windows {
 
@@ -18,7 +20,7 @@ namespace Windows {
 
     struct ChartHeader {
         char magic[12];        // "NOTARHYTHM" (11 chars + null terminator)
-        uint32_t version;      // File format version (now 2 for TAP/HOLD support)
+        uint32_t version;      // File format version (3 adds the section directory)
         uint32_t headerSize;   // Size of this header
         uint32_t audioSize;    // Size of embedded audio data
         uint32_t notesCount;   // Number of notes
@@ -26,8 +28,38 @@ namespace Windows {
         char artist[256];      // Artist name
         float bpm;             // Beats per minute
         double duration;       // Song duration in seconds
-        uint32_t reserved[16]; // Reserved for future use
+        uint32_t sectionCount; // Version 3: entries in the section directory that follows the header
+        float gridOffset;      // Time of the first beat in seconds, 0 in files written before it existed
+        uint32_t reserved[14]; // Reserved for future use
+    };
+
+    enum ChartSectionType : uint32_t {
+        CHART_SECTION_NOTES = 1,    // ChartNoteRecord[notesCount]
+        CHART_SECTION_ANALYSIS = 2, // Serialized AudioWaveform (optional, see AnalysisCache)
+        CHART_SECTION_AUDIO = 3,    // Encoded audio file
+    };
+
+    // Version 3 directory entry; offsets are from the start of the file and 8-byte aligned
+    struct ChartSection {
+        uint32_t type;
+        uint32_t flags;
+        uint64_t offset;
+        uint64_t size;
+    };
+
+    // Version 3 note record; fixed width so the table can be used straight from the file
+    struct ChartNoteRecord {
+        int32_t id;
+        uint8_t lane;
+        uint8_t type;
+        uint16_t reserved;
+        double timestamp;
+        double endTimestamp;
     };
 
+    static_assert(sizeof(ChartSection) == 24, "ChartSection must stay 24 bytes");
+    static_assert(sizeof(ChartNoteRecord) == 24, "ChartNoteRecord must stay 24 bytes");
+    static_assert(sizeof(ChartHeader) % 8 == 0, "ChartHeader must keep the directory 8-byte aligned");
+
 } // Windows
 } // App
\ No newline at end of file
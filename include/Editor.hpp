@@ -15,6 +15,7 @@
 #include <cstring>
 #include <filesystem>
 #include <thread>
+#include <mutex>
 #include <complex>
 #include <algorithm>
 #include <numeric>
@@ -24,7 +25,13 @@
 #include "SoundManager.hpp"
 #include "NodeManager.hpp"
 #include "Common.hpp"
+#include "ChartFile.hpp"
 #include "AudioAnalazyer.hpp"
+#include "FrameScheduler.hpp"
+#include "WaveformTiles.hpp"
+#include "SpectrogramTiles.hpp"
+#include "TempoEstimator.hpp"
+#include "ThreadPool.hpp"
 
 #define TIMELINE_OFFSET 4.0f
 
@@ -33,6 +40,8 @@
 
 #define WAVEFORM_HEIGHT_MULTIPLIER 2.5f
 
+#define SPECTRUM_BANDS 64
+
 namespace App {
 namespace Windows {
 
@@ -52,7 +61,8 @@ namespace Windows {
         private:
             // Audio management
             SoundManager* soundManager;
-            std::string currentSongPath;
+            AudioSource currentSongSource; // Song file, or the audio section of the loaded chart
+            SoundHandle songHandle; // "timeline_song" in the SoundManager
             std::string currentSongName;
             bool isSongLoaded;
             bool isPlaying;
@@ -61,15 +71,38 @@ namespace Windows {
 
             // Waveform data
             std::unique_ptr<AudioAnalyzer> audioAnalyzer;
-            AudioWaveform waveformData;
+            AudioWaveform waveformData; // UI thread only, analysis results arrive through analysisSlot
             bool showWaveform;
             bool waveformLoaded;
+            WaveformTiles waveformTiles; // Texture tiles of the waveform, only touched on the render thread
+            SpectrogramTiles spectrogramTiles; // Textures of waveformData.spectrogram, only touched on the render thread
+            bool showSpectrogram; // Drawn under the timeline lanes
+            bool waveformTilesValid; // Cleared when waveformData is replaced, both tile caches rebuild
             bool isAnalyzing;
             std::string analysisProgress;
             float analysisProgressPercent;
 
+            // The analysis job only ever writes this slot, under analysisMutex;
+            // update() copies the progress and moves a finished result into waveformData
+            struct AnalysisSlot {
+                AudioSource source; // Song being analyzed, results for another song are dropped
+                std::string stage;
+                float percent;
+                bool finished;
+                bool succeeded;
+                AudioWaveform waveform;
+                TempoEstimate tempo;
+            };
+            std::mutex analysisMutex;
+            AnalysisSlot analysisSlot;
+            // Runs the analysis job; declared after everything the job touches so
+            // destroying the editor joins it before those members go away
+            std::unique_ptr<ThreadPool> analysisPool;
+
             // Timeline configuration
             float bpm;
+            float gridOffset; // Time of the first beat, the grid, snapping and the metronome count from it
+            TempoEstimate detectedTempo; // Estimated after each analysis, bpm 0 when none
             bool showGrid;
             bool showSubGrid;
             int subGridDivisions;
@@ -104,6 +137,10 @@ namespace Windows {
             bool showMilliseconds;
             float noteRadius;
             SortOrder sortOrder;
+            std::vector<const Core::Note*> noteListView; // Notes list rows in sortOrder
+            uint64_t noteListRevision;
+            SortOrder noteListSortOrder;
+            std::vector<const Core::Note*> visibleNotes; // Scratch buffer for range queries
 
             // Chart file management
             bool showSaveDialog;
@@ -119,15 +156,19 @@ namespace Windows {
 
             // Metronome
             bool metronomeEnabled;
+            SoundHandle metronomeHandles[2]; // "metronome1" and "metronome2" samples, played alternately
             double lastMetronomeBeat;
             int metronomeBeatCount;
 
             // Spectrum Analysis
-            std::vector<float> spectrumData;
-            std::vector<std::vector<float>> spectrumHistory;
+            std::vector<float> spectrumData; // Smoothed bands shown as bars
+            std::vector<float> spectrumFrame; // Bands of the last update, before smoothing
+            std::vector<std::vector<float>> spectrumHistory; // Ring of past frames for the spectrogram
             bool showSpectrum;
             int spectrumHistorySize;
-            bool spectrumInitialized;
+            int spectrumHistoryHead; // Oldest row, written next
+            double lastSpectrumTime; // Song time of the last update, -1 before the first
+            bool spectrumInitialized; // Buffers above are allocated
             bool metronomeSound1;
 
             bool showBpmFinder;
@@ -141,11 +182,13 @@ namespace Windows {
             void loadSong(const std::string& filepath);
             void updatePlayback();
             void updateMetronome();
+            void loadMetronomeSounds();
             void handleKeyboardInput();
             void drawTimelineGrid();
             void drawPlaybackCursor();
             void drawTimelineRuler();
             void drawWaveform();
+            void drawSpectrogram();
             void drawControlsWindow();
             void drawTimelineWindow();
             void drawFileBrowserPopup();
@@ -158,6 +201,8 @@ namespace Windows {
             void updateSpectrum();
             void calculateGridSpacing();
             float getSnapSpacing() const;
+            double snapTime(double time) const;
+            void applyDetectedTempo();
             bool shouldSnap() const;
             void updateAutoscroll();
             void refreshFileList();
@@ -169,13 +214,15 @@ namespace Windows {
             void drawHelpWindow();
             void jumpToPosition(Core::Note* note);
             void sortNotes();
-            void analyzeAudioFile(const std::string& filepath);
+            void analyzeAudioFile(const AudioSource& source);
             void onAnalysisProgress(const AnalysisProgress& progress);
+            void collectAnalysis();
 
             // Chart file operations
             bool saveChartFile(const std::string& filepath);
+            void reopenSong(double position, bool resume);
             bool loadChartFile(const std::string& filepath);
-            std::vector<char> readAudioFile(const std::string& filepath);
+            bool readAudioFile(const AudioSource& source, std::vector<char>& buffer);
             bool writeAudioFile(const std::string& filepath, const std::vector<char>& audioData);
             void extractAudioFromChart(const std::string& chartPath, const std::string& outputPath);
 
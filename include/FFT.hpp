@@ -0,0 +1,39 @@
+#pragma once
+
+#include <vector>
+#include <complex>
+#include <memory>
+#include <cstddef>
+
+/**
+ * FFTPlan - Precomputed radix-2 FFT for real-valued input
+ *
+ * A plan owns the bit-reversal and twiddle tables for one power-of-two size,
+ * so no trigonometric function is evaluated while transforming. Real input of
+ * length N is packed into N/2 complex values, transformed with a half-size
+ * complex FFT and split back into the N/2 + 1 non-redundant bins.
+ *
+ * Plans are immutable once built and can be shared between threads; use
+ * FFTPlan::get() to fetch a cached plan for a given size.
+ */
+class FFTPlan {
+private:
+    size_t size;
+    size_t halfSize;
+    std::vector<size_t> bitReverse;
+    std::vector<std::complex<float>> twiddles;
+    std::vector<std::complex<float>> realTwiddles;
+
+    void transformComplex(std::complex<float>* data) const;
+
+public:
+    explicit FFTPlan(size_t size);
+
+    size_t getSize() const { return size; }
+    size_t getBinCount() const { return halfSize + 1; }
+
+    // input holds getSize() samples, output receives getBinCount() bins
+    void forwardReal(const float* input, std::complex<float>* output) const;
+
+    static std::shared_ptr<const FFTPlan> get(size_t size);
+};
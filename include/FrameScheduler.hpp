@@ -0,0 +1,100 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+
+namespace App {
+namespace Core {
+
+    enum FrameMode {
+        FRAME_MODE_ADAPTIVE = 0, // Idle when nothing moves, vsync when animating, uncapped in gameplay
+        FRAME_MODE_VSYNC = 1,    // Always redraw at the display rate (the old behaviour)
+        FRAME_MODE_LIMITED = 2,  // Like adaptive, with animation and gameplay capped at the target fps
+        FRAME_MODE_UNCAPPED = 3, // Always redraw as fast as possible
+    };
+
+    // What the next frame is waiting on
+    enum FramePacing {
+        PACING_IDLE = 0,        // Sleep until an input event or the idle timeout
+        PACING_VSYNC = 1,       // Swap interval 1
+        PACING_LIMITED = 2,     // Swap interval 0, sleep to the target frame time
+        PACING_LOW_LATENCY = 3, // Swap interval 0, no sleep
+    };
+
+    // Over the last FrameScheduler::HISTORY frames, in milliseconds
+    struct FrameStats {
+        double averageInterval; // Start to start
+        double worstInterval;
+        double averageWork;     // Start to end, before any limiter sleep
+        double p99Work;
+        double worstWork;
+        double fps;
+        size_t samples;
+    };
+
+    /**
+     * FrameScheduler - Decides how the main loop waits between frames
+     *
+     * Every frame the windows report what they need: requestAnimation() when
+     * something moves on its own (playback, analysis, smooth scrolling) and
+     * requestLowLatency() during gameplay. Without a request the loop waits on
+     * window events, so an untouched editor draws a couple of frames a second.
+     * Frames keep coming for a short while after an input wakes the loop, so
+     * ImGui can settle hovers and releases.
+     *
+     * The scheduler has no window system dependency: main() asks it for the
+     * pacing and swap interval and performs the GLFW calls itself.
+     */
+    class FrameScheduler {
+        public:
+            using Clock = std::chrono::steady_clock;
+
+            static constexpr size_t HISTORY = 240;
+            static constexpr double IDLE_TIMEOUT = 0.5;   // Seconds between redraws while idle
+            static constexpr double INPUT_LINGER = 0.35;  // Seconds of full rate drawing after an input
+
+            FrameScheduler();
+
+            void beginFrame(Clock::time_point now = Clock::now());
+            // Records the frame, picks the next pacing and sleeps if it is LIMITED
+            void endFrame();
+
+            void requestAnimation() { animationRequested = true; }
+            void requestLowLatency() { lowLatencyRequested = true; }
+
+            FramePacing getPacing() const { return pacing; }
+            int getSwapInterval() const { return pacing == PACING_IDLE || pacing == PACING_VSYNC ? 1 : 0; }
+            double getIdleTimeout() const { return IDLE_TIMEOUT; }
+
+            void setMode(FrameMode newMode) { mode = newMode; }
+            FrameMode getMode() const { return mode; }
+            void setTargetFps(int fps) { targetFps = fps; }
+            int getTargetFps() const { return targetFps; }
+
+            FrameStats getStats() const;
+
+        private:
+            FrameMode mode;
+            FramePacing pacing;
+            int targetFps;
+
+            bool animationRequested;
+            bool lowLatencyRequested;
+            Clock::time_point frameStart;
+            Clock::time_point previousStart;
+            Clock::time_point waitStart;  // When the loop went idle, to tell an input wake from a timeout
+            Clock::time_point activeUntil; // Keep drawing at full rate until then
+            bool hasPreviousFrame;
+
+            std::array<float, HISTORY> intervals;
+            std::array<float, HISTORY> workTimes;
+            size_t historyCount;
+            size_t historyNext;
+    };
+
+    // Scheduler of the main loop, fed by the windows every frame
+    FrameScheduler& getFrameScheduler();
+
+} // namespace Core
+} // namespace App
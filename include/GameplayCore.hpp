@@ -0,0 +1,169 @@
+#pragma once
+
+#include <vector>
+#include <deque>
+#include <cstddef>
+#include <cstdint>
+
+#include "NodeManager.hpp"
+#include "ChartFile.hpp"
+
+namespace App {
+namespace Windows {
+
+    enum Judgement {
+        PERFECT = 0,
+        GREAT = 1,
+        GOOD = 2,
+        MISS = 3,
+    };
+
+    struct GameNote {
+        int id;
+        Core::Lane lane;
+        Core::NoteType type;
+        double timestamp;
+        double endTimestamp;
+        bool hit;
+        Judgement judgement;
+        double hitTime;
+        bool isActive;
+        bool isHolding;
+        double holdStartTime;
+        bool holdCompleted;
+        double holdAccuracy;
+        int holdTicks;
+        int totalHoldTicks;
+        double lastHoldTickTime;
+    };
+
+    struct GameStats {
+        int perfect;
+        int great;
+        int good;
+        int miss;
+        int combo;
+        int maxCombo;
+        double accuracy;
+        int score;
+    };
+
+    enum GameplayEventType {
+        EVENT_HIT = 0,          // TAP note hit
+        EVENT_HOLD_START = 1,   // HOLD note hit, holding begins
+        EVENT_HOLD_BREAK = 2,   // HOLD released early
+        EVENT_HOLD_COMPLETE = 3,
+        EVENT_MISS = 4,         // Note left the judgement window unhit
+    };
+
+    // Something the front end may want to show or play, in the order it happened
+    struct GameplayEvent {
+        GameplayEventType type;
+        Core::Lane lane;
+        Judgement judgement;
+        double time;
+    };
+
+    // One key press or release of a scripted (or recorded) play, in song time
+    struct ScriptedInput {
+        double time;
+        Core::Lane lane;
+        bool pressed;
+    };
+
+    // Timing rules of a play, in seconds
+    struct GameplaySettings {
+        double judgementWindow;
+        double perfectWindow;
+        double greatWindow;
+        double goodWindow;
+        double holdTickInterval;
+    };
+
+    /**
+     * GameplayCore - Judgement and scoring state of one play, without any UI
+     *
+     * Notes are sorted by time and split into per-lane queues with forward-only
+     * cursors on the first note that can still be judged, so the cost of a
+     * press or an update depends on the notes inside the judgement window, not
+     * on the chart size. HOLD notes being held live in a separate active list.
+     *
+     * The front end feeds presses/releases and the current song time, then
+     * drains getEvents() for effects and sounds. simulate() runs a whole
+     * scripted play headlessly, for benchmarks and replay verification.
+     *
+     * Results only depend on the inputs and the final time, never on how often
+     * update() is called: time never goes backwards, a press first misses the
+     * notes whose window closed before it, and hold ticks fall on a fixed grid
+     * from the hold start. The accepted inputs are logged for replays.
+     */
+    class GameplayCore {
+        private:
+            std::vector<GameNote> notes; // Sorted by timestamp
+            std::vector<size_t> laneQueues[2]; // Indices into notes per lane, in time order
+            size_t laneCursors[2]; // First note of each lane queue that may still be judged
+            std::vector<size_t> activeHolds; // Indices of the HOLD notes being held
+            std::vector<double> noteMaxEnd; // noteMaxEnd[i] = max endTimestamp of notes[0..i]
+            bool laneHeld[2];
+
+            GameStats stats;
+            std::deque<Judgement> recentJudgements;
+            std::vector<GameplayEvent> events;
+            std::vector<ScriptedInput> inputLog;
+            double lastTime; // Latest time seen, inputs and updates are clamped to it
+            uint64_t chartHash;
+
+            GameplaySettings settings;
+
+            double advanceTime(double time);
+            void advanceHoldTicks(GameNote& note, double time);
+            void buildQueues();
+            void hitNote(GameNote& note, double time);
+            void missNote(GameNote& note, double time);
+            void breakHold(GameNote& note, double time);
+            void completeHold(GameNote& note, double time);
+            void checkNoteHits(double currentTime);
+            void updateHoldNotes(double currentTime);
+            Judgement calculateJudgement(double hitTime, double noteTime) const;
+            void updateStats(Judgement judgement);
+            void pushEvent(GameplayEventType type, const GameNote& note, Judgement judgement, double time);
+
+        public:
+            GameplayCore();
+
+            void loadNotes(const std::vector<Core::Note>& chartNotes);
+            void loadChart(const ChartFile& chart);
+            // Clears judgements and stats, keeps the notes
+            void reset();
+
+            void press(Core::Lane lane, double time);
+            void release(Core::Lane lane, double time);
+            // Misses notes that left the window and advances holds up to currentTime
+            void update(double currentTime);
+
+            // Plays inputs (sorted by time) against the chart at a fixed frame step, from a reset state
+            GameStats simulate(const std::vector<ScriptedInput>& inputs, double endTime, double frameTime);
+
+            void setSettings(const GameplaySettings& newSettings) { settings = newSettings; }
+            const GameplaySettings& getSettings() const { return settings; }
+            // Hash of the loaded notes (id, lane, type, times), identifies the chart a replay belongs to
+            uint64_t getChartHash() const { return chartHash; }
+            // Inputs accepted since reset(), with the times they were judged at
+            const std::vector<ScriptedInput>& getInputLog() const { return inputLog; }
+            double getCurrentTime() const { return lastTime; }
+
+            const std::vector<GameNote>& getNotes() const { return notes; }
+            // Latest end time of any note, 0 without notes
+            double getChartEnd() const { return noteMaxEnd.empty() ? 0.0 : noteMaxEnd.back(); }
+            // First note that may still be on screen at time, ends at or after it
+            size_t firstNoteEndingAfter(double time) const;
+            const GameStats& getStats() const { return stats; }
+            const std::deque<Judgement>& getRecentJudgements() const { return recentJudgements; }
+            const std::vector<GameplayEvent>& getEvents() const { return events; }
+            void clearEvents() { events.clear(); }
+            bool isLaneHeld(Core::Lane lane) const;
+            double getJudgementWindow() const { return settings.judgementWindow; }
+    };
+
+} // Windows
+} // App
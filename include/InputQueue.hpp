@@ -0,0 +1,50 @@
+#pragma once
+
+#include <atomic>
+#include <array>
+#include <chrono>
+#include <cstddef>
+
+#include "NodeManager.hpp"
+
+namespace App {
+namespace Core {
+
+    struct InputEvent {
+        Lane lane;
+        bool pressed;                                 // false on release
+        std::chrono::steady_clock::time_point time;   // When the OS delivered the key event
+    };
+
+    /**
+     * InputQueue - Lock-free single producer / single consumer ring of key events
+     *
+     * The window system's key callback pushes events the moment they are
+     * delivered, stamped with steady_clock, and gameplay drains them once per
+     * frame. Timing then comes from the event stamps, not from the frame the
+     * event happens to be seen in. When the ring is full new events are dropped.
+     */
+    class InputQueue {
+        public:
+            static constexpr size_t CAPACITY = 256; // Power of two
+
+            InputQueue();
+
+            // Producer side
+            bool push(const InputEvent& event);
+
+            // Consumer side
+            bool pop(InputEvent& event);
+            void clear();
+
+        private:
+            std::array<InputEvent, CAPACITY> events;
+            std::atomic<size_t> head; // Next slot written by the producer
+            std::atomic<size_t> tail; // Next slot read by the consumer
+    };
+
+    // Queue fed by the GLFW key callback installed in main()
+    InputQueue& getInputQueue();
+
+} // namespace Core
+} // namespace App
@@ -1,7 +1,10 @@
 #pragma once
 
 #include <vector>
+#include <deque>
 #include <algorithm>
+#include <unordered_map>
+#include <cstdint>
 
 namespace App {
 namespace Core {
@@ -24,8 +27,23 @@ namespace Core {
         double endTimestamp;     // End time for HOLD notes (same as timestamp for TAP)
     };
 
+    /**
+     * NodeManager - Owns the notes of a chart and indexes them by time
+     *
+     * Notes live in stable slots (reused through a free list) and an id -> slot
+     * map gives constant time lookups. Each lane keeps a treap ordered by
+     * (timestamp, id) whose nodes carry the maximum endTimestamp of their
+     * subtree, so range queries skip every subtree that ends before the range
+     * and a long HOLD never drags the notes after it into the scan. Edits update
+     * the treaps in O(log n); queries cost O(log n + k).
+     *
+     * Slots never move: a pointer returned by getNoteById() or queryRange()
+     * stays valid until that note is removed or the manager is cleared.
+     */
     class NodeManager {
     public:
+        static constexpr int ALL_LANES = -1;
+
         NodeManager();
         int addNote(int lane, double timestamp);
         int addNoteWithId(int id, int lane, double timestamp);
@@ -35,13 +53,47 @@ namespace Core {
         void moveNote(int id, int newLane, double newTimestamp);
         void moveHoldNote(int id, int newLane, double newStartTimestamp, double newEndTimestamp);
         Note* getNoteById(int id);
-        std::vector<Note>& getNotes();
+        size_t getNoteCount() const;
+        // Every note, in time order
+        void getAllNotes(std::vector<const Note*>& result) const;
         void clear();
         int getNextId() const;
 
+        // Notes of the lane (or ALL_LANES) whose [timestamp, endTimestamp] overlaps [startTime, endTime], in time order
+        void queryRange(double startTime, double endTime, int lane, std::vector<const Note*>& result) const;
+        // Incremented by every edit, lets callers cache views of the notes
+        uint64_t getRevision() const;
+
     private:
-        std::vector<Note> notes;
+        static constexpr int NO_SLOT = -1;
+
+        struct NoteSlot {
+            Note note;
+            uint32_t priority; // Treap heap order, random so the tree stays balanced
+            int left;
+            int right;
+            double maxEnd;     // Largest endTimestamp in this subtree
+        };
+
+        std::deque<NoteSlot> slots;
+        std::vector<int> freeSlots;
+        std::unordered_map<int, int> slotById;
+        int laneRoots[2]; // TOP, BOTTOM
         int nextId;
+        uint64_t revision;
+        uint32_t priorityState;
+
+        mutable std::vector<const Note*> laneResults[2]; // Per lane results merged for ALL_LANES
+
+        int insertNote(const Note& note);
+        void linkSlot(int slot);
+        void unlinkSlot(int slot);
+        void updateSlot(int slot);
+        bool precedes(int a, int b) const;
+        void split(int root, int slot, int& left, int& right);
+        int merge(int left, int right);
+        int eraseFrom(int root, int slot);
+        void collect(int root, double startTime, double endTime, std::vector<const Note*>& result) const;
     };
 
 } // namespace Core
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <vector>
+
+#include "imgui.h"
+
+namespace App {
+namespace Windows {
+
+    /**
+     * NoteRenderer - Batched gameplay note drawing from a sprite atlas
+     *
+     * The note layers (glow, body, core, outline ring) are rasterized once
+     * into a white RGBA atlas texture, anti-aliased, and every primitive is
+     * then one textured quad tinted by its vertex colour. Quads queued between
+     * begin() and end() are emitted in order as a single texture run of the
+     * draw list, so a note costs 4 vertices instead of tessellated circles.
+     *
+     * The texture is created lazily on the render thread, once a GL context
+     * exists, and lives as long as that context.
+     */
+    class NoteRenderer {
+        public:
+            // Atlas cells, the TAP body is baked at several approach intensities
+            enum Sprite {
+                SPRITE_TAP = 0,
+                SPRITE_HOLD_START = 8,
+                SPRITE_HOLD_END = 9,
+                SPRITE_RING = 10,
+                SPRITE_DOT = 11,
+                SPRITE_WHITE = 12,
+                SPRITE_RING_SMALL = 13,
+            };
+
+            static const int TAP_LEVELS = 8;
+
+        private:
+            struct Quad {
+                ImVec2 min;
+                ImVec2 max;
+                int sprite;
+                ImU32 color;
+            };
+
+            unsigned int texture;
+            float bakedRadius; // noteRadius the ring thickness was baked for
+            bool atlasFailed;
+            ImDrawList* drawList;
+            std::vector<Quad> quads;
+
+            bool buildAtlas(float noteRadius);
+            void addSprite(ImVec2 center, float radius, int sprite, ImU32 color);
+
+        public:
+            NoteRenderer();
+            ~NoteRenderer() = default;
+
+            void begin(ImDrawList* drawList, float noteRadius);
+            // Flushes the queued quads into the draw list
+            void end();
+
+            // Glow, body and core of a TAP note; intensity 0 far away, 1 at the hit zone
+            void tapNote(ImVec2 center, float noteRadius, ImU32 color, float intensity);
+            void holdStart(ImVec2 center, float noteRadius, ImU32 color);
+            void holdEnd(ImVec2 center, float noteRadius, ImU32 color);
+            // Two pixel outline circle. The stroke is baked for rings of 1.2 and 1.0
+            // noteRadius, other radii use the nearer one and scale its stroke
+            void ring(ImVec2 center, float radius, ImU32 color);
+            void dot(ImVec2 center, float radius, ImU32 color);
+            void rect(ImVec2 min, ImVec2 max, ImU32 color);
+            void rectOutline(ImVec2 min, ImVec2 max, ImU32 color, float thickness);
+    };
+
+} // Windows
+} // App
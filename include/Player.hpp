@@ -15,17 +15,27 @@
 #include <cstring>
 #include <filesystem>
 #include <deque>
+#include <map>
+#include <ctime>
 
 #include "imgui.h"
 
 #include "SoundManager.hpp"
 #include "NodeManager.hpp"
 #include "Common.hpp"
+#include "ChartFile.hpp"
+#include "InputQueue.hpp"
+#include "FrameScheduler.hpp"
+#include "GameplayCore.hpp"
+#include "Replay.hpp"
+#include "NoteRenderer.hpp"
 
 #define TIMELINE_OFFSET 4.0f
 
 #define RECENT_CHART_FILE "recent_charts.txt"
 
+#define HIT_EFFECT_CAPACITY 64
+
 namespace App {
 namespace Windows {
 
@@ -37,51 +47,12 @@ namespace Windows {
         RESULTS = 4,
     };
 
-    enum Judgement {
-        PERFECT = 0,
-        GREAT = 1,
-        GOOD = 2,
-        MISS = 3,
-    };
-
-    struct GameNote {
-        int id;
-        Core::Lane lane;
-        Core::NoteType type;
-        double timestamp;
-        double endTimestamp;
-        bool hit;
-        Judgement judgement;
-        double hitTime;
-        bool isActive;
-        bool isHolding;
-        double holdStartTime;
-        bool holdCompleted;
-        double holdAccuracy;
-        int holdTicks;
-        int totalHoldTicks;
-        double lastHoldTickTime;
-    };
-
-    struct GameStats {
-        int perfect;
-        int great;
-        int good;
-        int miss;
-        int combo;
-        int maxCombo;
-        double accuracy;
-        int score;
-    };
-
+    // Scale and fade are derived from the age when drawn
     struct HitEffect {
         ImVec2 position;
-        float scale;
-        float alpha;
         double startTime;
         double duration;
         Judgement judgement;
-        bool active;
     };
 
     class Player {
@@ -89,22 +60,26 @@ namespace Windows {
             SoundManager* soundManager;
             std::string currentSongPath;
             std::string currentSongName;
+            SoundHandle songHandle;
+            ChartFile chartFile; // Mapped chart the current song streams from
             bool isSongLoaded;
             bool isPlaying;
             double currentPosition; // in seconds
             double songDuration; // in seconds
 
             GameState gameState;
-            GameStats stats;
-            std::vector<GameNote> gameNotes;
-            std::deque<Judgement> recentJudgements;
-            double judgementWindow; // in seconds
-            double perfectWindow;
-            double greatWindow;
-            double goodWindow;
-
-            std::vector<HitEffect> hitEffects;
+            GameplayCore gameplay; // Notes, judgements and stats of the current play
+            std::string lastReplayPath; // Replay written when the last play ended, empty if none
+
+            // Ring of live effects, oldest first: they all last as long and are created in
+            // time order, so expired ones always sit at the head. When full the oldest is reused
+            std::array<HitEffect, HIT_EFFECT_CAPACITY> hitEffects;
+            size_t hitEffectHead;
+            size_t hitEffectCount;
+            NoteRenderer noteRenderer; // Atlas sprites for the approaching notes
             std::string hitSoundPath;
+            SoundHandle hitSoundHandle; // "hit_sound" sample
+            bool hitSoundLoadFailed;
 
             float bpm;
             bool showGrid;
@@ -123,6 +98,7 @@ namespace Windows {
             std::string currentDirectory;
             std::vector<std::string> directories;
             std::vector<std::string> files;
+            std::map<std::string, ChartHeader> chartHeaders; // Metadata of the listed charts, by file name
             int selectedFileIndex;
 
             bool showNoteIds;
@@ -179,14 +155,10 @@ namespace Windows {
             ImVec4 comboColor;
             ImVec4 scoreColor;
 
-            double holdTickInterval;
-            double holdMissThreshold;
-            double holdBreakTime;
-            bool fKeyHolding;
-            bool jKeyHolding;
 
             bool loadSong(const std::string& filepath);
             void updatePlayback();
+            void drainInputQueue();
             void handleKeyboardInput();
             void calculateGridSpacing();
             void updateAutoscroll();
@@ -194,20 +166,17 @@ namespace Windows {
             void navigateToDirectory(const std::string& dirName);
             void drawJudgement();
             void updateGameLogic();
-            void processInput();
-            void processNoteHit(GameNote& note, double currentTime);
-            void checkNoteHits();
-            Judgement calculateJudgement(double hitTime, double noteTime);
-            void updateStats(Judgement judgement);
+            void handleGameplayEvents();
             void drawResults();
+            bool saveReplay();
             void resetGame();
+            void clearEffects();
             void startGame();
             void pauseGame();
             void resumeGame();
 
             bool loadChartFile(const std::string& filepath);
-            std::vector<char> readAudioFile(const std::string& filepath);
-            bool writeAudioFile(const std::string& filepath, const std::vector<char>& audioData);
+            void unloadSong();
 
             void drawGameplayWindow();
             void drawStatsWindow();
@@ -220,7 +189,6 @@ namespace Windows {
             void drawComboDisplay();
             void drawScoreDisplay();
             void drawProgressBar();
-            void cleanupTempFiles();
             void drawMainMenu();
             void drawChartBrowser();
             void drawChartInfo();
@@ -228,14 +196,9 @@ namespace Windows {
             void saveRecentCharts();
             void addToRecentCharts(const std::string& chartPath);
             void createHitEffect(const ImVec2& position, Judgement judgement);
-            void updateHitEffects();
+            bool loadHitSound();
             void playHitSound();
 
-            void updateHoldNotes();
-            void breakHoldNote(GameNote& note, const std::string& reason);
-            void completeHoldNote(GameNote& note);
-            void processHoldTick(GameNote& note);
-            bool isKeyHeldForLane(Core::Lane lane);
 
         public:
             Player();
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+#include "GameplayCore.hpp"
+
+#define REPLAY_DIRECTORY "replays"
+#define REPLAY_EXTENSION ".nrr"
+
+namespace App {
+namespace Windows {
+
+    /**
+     * Replay - Everything needed to re-judge a play without its audio
+     *
+     * Holds the hash of the chart's notes, the timing settings, the judged
+     * inputs with their song times, the time the play stopped at and the stats
+     * it claimed. Because GameplayCore results don't depend on the update
+     * rate, verify() can re-simulate with one update per song second and must
+     * land on exactly the recorded stats.
+     *
+     * On disk: "NRRP", format version, then the fields in native byte order;
+     * each input is one flag byte (lane, pressed) and a double. deserialize()
+     * rejects files whose settings, end time or input times could make a
+     * re-simulation misbehave (non-finite, non-positive windows, unsorted
+     * inputs), and verify() one that ends long after the chart does.
+     */
+    struct Replay {
+        uint64_t chartHash;
+        GameplaySettings settings;
+        double endTime;
+        GameStats stats;
+        std::vector<ScriptedInput> inputs;
+
+        static Replay record(const GameplayCore& core);
+
+        std::vector<char> serialize() const;
+        static bool deserialize(const char* data, size_t size, Replay& replay);
+        bool save(const std::string& path) const;
+        static bool load(const std::string& path, Replay& replay);
+
+        // core must have the replay's chart loaded; result receives the re-simulated stats
+        bool verify(GameplayCore& core, GameStats& result, double frameTime = 1.0) const;
+        static bool sameStats(const GameStats& a, const GameStats& b);
+    };
+
+} // Windows
+} // App
@@ -4,10 +4,15 @@
 #include <map>
 #include <vector>
 #include <iostream>
+#include <cstdint>
+#include <cstddef>
+
+#include "AudioClock.hpp"
 
 #ifdef __EMSCRIPTEN__
 // WebAssembly version - no BASS library
 typedef int HSTREAM;
+typedef int HSAMPLE;
 typedef unsigned int DWORD;
 typedef unsigned long long QWORD;
 #else
@@ -25,10 +30,73 @@ typedef unsigned long long QWORD;
 #define BASS_MIN_FREQUENCY 100
 #endif
 
+// Voices per preloaded sample; the oldest voice is restarted when all are busy
+#define SAMPLE_VOICES 8
+
+/**
+ * SoundHandle - Small typed id of a loaded sound
+ *
+ * Indexes SoundManager's slot table directly. A generation counter makes
+ * handles to an unloaded sound go stale instead of hitting whatever reuses
+ * the slot. A default constructed handle is invalid.
+ */
+class SoundHandle {
+public:
+    SoundHandle() : index(0), generation(0) {}
+    SoundHandle(uint32_t slot, uint32_t generation) : index(slot + 1), generation(generation) {}
+
+    explicit operator bool() const { return index != 0; }
+    uint32_t getIndex() const { return index - 1; }
+    uint32_t getGeneration() const { return generation; }
+
+    bool operator==(const SoundHandle& other) const { return index == other.index && generation == other.generation; }
+    bool operator!=(const SoundHandle& other) const { return !(*this == other); }
+
+private:
+    uint32_t index; // Slot + 1, 0 for the invalid handle
+    uint32_t generation;
+};
+
+/**
+ * SoundManager - Streams, one-shot samples and playback clocks on top of BASS
+ *
+ * Sounds live in a slot table addressed by SoundHandle; per-frame callers
+ * should keep the handle returned by loadSound() and use the handle
+ * overloads. The name based overloads look the handle up first and are
+ * kept for one-off calls.
+ */
 class SoundManager {
 private:
-    std::map<std::string, HSTREAM> streams;
+    struct SoundSlot {
+        HSTREAM stream = 0;
+        uint32_t generation = 0;
+        bool used = false;
+        std::string name;
+        AudioClock clock;
+    };
+
+    std::vector<SoundSlot> slots;
+    std::vector<uint32_t> freeSlots;
+    std::map<std::string, SoundHandle> handlesByName;
+
+    // Samples have their own table, so a sample handle never reaches the stream calls
+    struct SampleSlot {
+        HSAMPLE sample = 0;
+        uint32_t generation = 0;
+        bool used = false;
+        std::string name;
+    };
+
+    std::vector<SampleSlot> sampleSlots;
+    std::map<std::string, SoundHandle> sampleHandlesByName;
     bool initialized;
+    double outputLatency; // in seconds, as reported by the device
+
+    SoundHandle addSound(const std::string& name, HSTREAM stream);
+    SoundSlot* getSlot(SoundHandle handle);
+    const SoundSlot* getSlot(SoundHandle handle) const;
+    SampleSlot* getSampleSlot(SoundHandle handle);
+    const SampleSlot* getSampleSlot(SoundHandle handle) const;
 
 public:
     SoundManager();
@@ -37,7 +105,37 @@ public:
     bool initialize(int device = BASS_DEFAULT_DEVICE, int freq = BASS_MAX_FREQUENCY, int flags = BASS_MIN_FREQUENCY);
     void cleanup();
 
-    bool loadSound(const std::string& name, const std::string& filepath);
+    // Loaders return the existing handle when name is already loaded, an invalid one on failure
+    SoundHandle loadSound(const std::string& name, const std::string& filepath);
+    // Streams length bytes starting at offset inside filepath (length 0 = up to the end of the file)
+    SoundHandle loadSoundFromFile(const std::string& name, const std::string& filepath, uint64_t offset, uint64_t length);
+    // Streams an encoded file held in memory; the buffer must stay valid until the sound is unloaded
+    SoundHandle loadSoundFromMemory(const std::string& name, const void* data, size_t size);
+    SoundHandle findSound(const std::string& name) const;
+
+    bool playSound(SoundHandle handle, bool loop = false);
+    bool stopSound(SoundHandle handle);
+    bool pauseSound(SoundHandle handle);
+    bool resumeSound(SoundHandle handle);
+    bool setVolume(SoundHandle handle, float volume);
+    bool isPlaying(SoundHandle handle);
+    double getCurrentTime(SoundHandle handle);
+    // Smoothed, latency compensated playback time; use this for anything synced to what is heard
+    double getClockTime(SoundHandle handle);
+    // Playback time at a past steady_clock instant, from the state of the last getClockTime() call
+    double getClockTimeAt(SoundHandle handle, AudioClock::Clock::time_point time) const;
+    double getDuration(SoundHandle handle);
+    bool setPosition(SoundHandle handle, double time);
+    bool setFrequency(SoundHandle handle, int frequency);
+    int getFrequency(SoundHandle handle);
+    double getPosition(SoundHandle handle);
+    bool seekTo(SoundHandle handle, double position);
+    bool isSoundLoaded(SoundHandle handle) const;
+    float getPlaybackSpeed(SoundHandle handle);
+    float getCurrentPlaybackSpeed(SoundHandle handle);
+    bool setPlaybackSpeed(SoundHandle handle, float speed);
+    void unloadSound(SoundHandle handle);
+
     bool playSound(const std::string& name, bool loop = false);
     bool stopSound(const std::string& name);
     bool pauseSound(const std::string& name);
@@ -45,10 +143,27 @@ public:
     bool setVolume(const std::string& name, float volume);
     bool isPlaying(const std::string& name);
     double getCurrentTime(const std::string& name);
+    double getClockTime(const std::string& name);
+    double getClockTimeAt(const std::string& name, AudioClock::Clock::time_point time) const;
     double getDuration(const std::string& name);
     bool setPosition(const std::string& name, double time);
     bool setFrequency(const std::string& name, int frequency);
     int getFrequency(const std::string& name);
+
+    // Short one-shots (hit sounds, metronome) are decoded into memory once and
+    // played from a fixed pool of voices, so overlapping plays don't cut each other off.
+    // Like loadSound(), loadSample() returns the existing handle when name is already loaded
+    SoundHandle loadSample(const std::string& name, const std::string& filepath, int voices = SAMPLE_VOICES);
+    SoundHandle findSample(const std::string& name) const;
+    bool playSample(SoundHandle handle, float volume = 1.0f);
+    bool isSampleLoaded(SoundHandle handle) const;
+    void unloadSample(SoundHandle handle);
+
+    bool playSample(const std::string& name, float volume = 1.0f);
+    bool isSampleLoaded(const std::string& name) const;
+    void unloadSample(const std::string& name);
+
+    double getOutputLatency() const;
     void stopAllSounds();
     void pauseAllSounds();
     void resumeAllSounds();
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "imgui.h"
+
+#include "AudioAnalazyer.hpp"
+
+#define SPECTROGRAM_UPLOADS_PER_FRAME 16 // Tiles turned into textures per draw, the rest wait a frame
+
+namespace App {
+namespace Windows {
+
+    /**
+     * SpectrogramTiles - Editor spectrogram drawn from the analysis' tiles
+     *
+     * Every Spectrogram tile is already a TILE_FRAMES x bandCount image, so it
+     * becomes one texture through a 256 entry colormap, the first time it is
+     * visible, and is then drawn as one textured quad at any zoom and scroll.
+     * Nothing is analyzed while drawing. Textures are kept until clear() (about
+     * 2.5 MB per minute of audio); at most SPECTROGRAM_UPLOADS_PER_FRAME are
+     * created per draw so zooming out on a long track never stalls a frame.
+     *
+     * Textures need the GL context, so every call must come from the render
+     * thread; tiles live as long as the context.
+     */
+    class SpectrogramTiles {
+        private:
+            std::vector<unsigned int> textures; // Per spectrogram tile, 0 until uploaded
+            std::vector<unsigned char> pixels; // Scratch RGBA image of one tile
+            ImU32 colormap[256];
+            bool textureFailed;
+
+            unsigned int uploadTile(const Spectrogram& spectrogram, int tile);
+
+        public:
+            SpectrogramTiles();
+            ~SpectrogramTiles() = default;
+
+            // Forgets every tile, call when the spectrogram changes
+            void clear();
+
+            // Draws start..start+duration seconds stretched over min..max, lowest band at the bottom;
+            // returns false while visible tiles are still waiting for their texture
+            bool draw(ImDrawList* drawList, const Spectrogram& spectrogram, double start, double duration,
+                      ImVec2 min, ImVec2 max);
+    };
+
+} // Windows
+} // App
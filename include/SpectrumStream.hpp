@@ -0,0 +1,60 @@
+#pragma once
+
+#include <vector>
+#include <complex>
+#include <memory>
+#include <cstddef>
+#include <cstdint>
+
+#include "FFT.hpp"
+
+/**
+ * SpectrumStream - Sliding-window spectrum of a stream of mono samples
+ *
+ * Samples are pushed as playback moves forward into a fixed ring buffer; a
+ * spectrum is the real FFT of the last WINDOW_SIZE samples, through a
+ * precomputed Hann table. The FFT bins are grouped into log-spaced bands
+ * (each at least one bin wide, so the low end turns linear) and reported in
+ * decibels mapped to 0..1 over DYNAMIC_RANGE dB below a full-scale sine.
+ *
+ * All buffers are sized by configure(), pushing and computing allocate
+ * nothing. computeFrame() applies the same mapping to any block of samples
+ * with caller-owned scratch, so a configured stream can also be shared by
+ * several threads as a read-only band mapper.
+ */
+class SpectrumStream {
+public:
+    static constexpr size_t WINDOW_SIZE = 1024;
+    static constexpr size_t RING_SIZE = 4096; // Power of two, at least WINDOW_SIZE
+    static constexpr float DYNAMIC_RANGE = 70.0f;
+
+    SpectrumStream();
+
+    void configure(double sampleRate, size_t bandCount, double minFrequency = 30.0);
+    // Forgets the pushed samples; the next sample pushed is the one at position
+    void reset(int64_t position = 0);
+    void push(const float* samples, size_t count);
+
+    // Bands of the WINDOW_SIZE samples before getPosition(), samples before the reset count as silence
+    void compute(float* bands);
+    // Bands of WINDOW_SIZE samples; scratch holds WINDOW_SIZE floats (may be samples itself) and
+    // scratchBins the FFT bin count, nothing else is touched
+    void computeFrame(const float* samples, float* bands, float* scratch, std::complex<float>* scratchBins) const;
+
+    int64_t getPosition() const { return position; }
+    size_t getBinCount() const { return plan->getBinCount(); }
+    size_t getBandCount() const { return bandStart.empty() ? 0 : bandStart.size() - 1; }
+    double getSampleRate() const { return sampleRate; }
+    // Lower edge of a band in Hz
+    double getBandFrequency(size_t band) const;
+
+private:
+    std::shared_ptr<const FFTPlan> plan;
+    std::vector<float> window;          // Hann table
+    std::vector<float> ring;
+    int64_t position;                   // Absolute index of the next sample pushed
+    std::vector<float> frame;           // Windowed copy of the ring, FFT input
+    std::vector<std::complex<float>> bins;
+    std::vector<size_t> bandStart;      // Band b covers FFT bins [bandStart[b], bandStart[b + 1])
+    double sampleRate;
+};
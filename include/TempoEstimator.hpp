@@ -0,0 +1,42 @@
+#pragma once
+
+#include <vector>
+
+#include "AudioAnalazyer.hpp"
+
+struct TempoEstimate {
+    double bpm;        // 0 when no tempo could be found
+    double offset;     // Time of the first beat in seconds, within [0, 60 / bpm)
+    double confidence; // Best tempo score over the average one, close to 1 means no clear pulse
+};
+
+/**
+ * TempoEstimator - Tempo and beat grid of a track from its Spectrogram
+ *
+ * The onset envelope is the spectral flux of the spectrogram (the sum of the
+ * band level increases between consecutive frames) minus its local mean.
+ * Its autocorrelation is scored by a comb over the first four multiples of
+ * every candidate beat period. Around the best candidate, the tempo and the
+ * first beat are refined together by aligning a beat comb with the envelope
+ * over the whole track, and a whole BPM is preferred when it fits about as
+ * well.
+ *
+ * Onsets alone can't tell a tempo from its half or double, so candidates are
+ * taken from one octave, [minBpm, 2 * minBpm), like DJ software does; the
+ * grid lines still fall on beats either way.
+ *
+ * Works on the already computed spectrogram, so it reads no audio; a five
+ * minute track takes some tens of milliseconds.
+ */
+class TempoEstimator {
+public:
+    explicit TempoEstimator(double minBpm = 90.0);
+
+    TempoEstimate estimate(const Spectrogram& spectrogram) const;
+
+    // Spectral flux per spectrogram frame, local mean removed and clamped at 0
+    static void onsetEnvelope(const Spectrogram& spectrogram, std::vector<float>& envelope);
+
+private:
+    double minBpm;
+};
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <exception>
+
+/**
+ * ThreadPool - Fixed set of worker threads pulling tasks from a shared queue
+ *
+ * Tasks are grouped with a TaskGroup, which is the unit callers wait on. A thread
+ * waiting on a group runs queued tasks itself instead of sleeping, so waiting
+ * never deadlocks even when every worker is busy.
+ *
+ * On WebAssembly builds there are no workers and tasks run inline.
+ */
+class ThreadPool {
+private:
+    std::vector<std::thread> workers;
+    std::deque<std::function<void()>> tasks;
+    std::mutex mutex;
+    std::condition_variable condition;
+    bool stopping;
+
+    void workerLoop();
+
+public:
+    explicit ThreadPool(size_t threadCount = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    size_t getThreadCount() const;
+    void enqueue(std::function<void()> task);
+    bool runPendingTask();
+};
+
+class TaskGroup {
+private:
+    ThreadPool& pool;
+    std::mutex mutex;
+    std::condition_variable condition;
+    size_t pending;
+    std::exception_ptr firstError;
+
+public:
+    explicit TaskGroup(ThreadPool& pool);
+    ~TaskGroup();
+
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+
+    void run(std::function<void()> task);
+    // Blocks until every task has finished and rethrows the first task exception
+    void wait();
+};
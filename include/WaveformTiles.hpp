@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstdint>
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+#include "imgui.h"
+
+#include "AudioAnalazyer.hpp"
+
+#define WAVEFORM_TILE_WIDTH 1024
+#define WAVEFORM_TILE_HEIGHT 256
+#define WAVEFORM_TILE_CAPACITY 48 // 1 MB of texture each
+
+namespace App {
+namespace Windows {
+
+    /**
+     * WaveformTiles - Editor waveform drawn from cached GL texture tiles
+     *
+     * Zoom levels are bucketed to powers of two of pixels per second. Within a
+     * bucket the timeline is cut into tiles of WAVEFORM_TILE_WIDTH pixel
+     * columns, each rendered once on the CPU as one min/max column per pixel
+     * (from the pyramid level matching the bucket) and uploaded as a texture.
+     * Drawing the visible range is then one textured quad per visible tile,
+     * scaled by at most 2x to the exact zoom, whatever the scroll position.
+     *
+     * Tiles are created lazily and the least recently drawn ones are reused
+     * past WAVEFORM_TILE_CAPACITY. Textures need the GL context, so every call
+     * must come from the render thread; tiles live as long as the context.
+     */
+    class WaveformTiles {
+        private:
+            struct Tile {
+                uint64_t key;
+                unsigned int texture;
+            };
+
+            std::list<Tile> tiles; // Most recently drawn first
+            std::unordered_map<uint64_t, std::list<Tile>::iterator> tileIndex;
+            std::vector<unsigned char> pixels; // Scratch RGBA image of one tile
+            bool textureFailed;
+
+            unsigned int acquireTile(const AudioWaveform& waveform, int bucket, int64_t index);
+            void renderTile(const AudioWaveform& waveform, int bucket, int64_t index);
+
+        public:
+            WaveformTiles();
+            ~WaveformTiles() = default;
+
+            // Forgets every tile, call when the waveform data changes
+            void clear();
+
+            // Draws start..start+duration seconds of the waveform stretched over min..max;
+            // the tiles cover amplitudes up to amplitudeScale times the rectangle height
+            void draw(ImDrawList* drawList, const AudioWaveform& waveform, double start, double duration,
+                      ImVec2 min, ImVec2 max, float amplitudeScale);
+
+            size_t getTileCount() const { return tiles.size(); }
+    };
+
+} // Windows
+} // App
@@ -0,0 +1,459 @@
+#include "AnalysisCache.hpp"
+#include <filesystem>
+#include <fstream>
+#include <cstring>
+#include <algorithm>
+#include <cstdio>
+#include <limits>
+#include <stdexcept>
+
+namespace {
+
+const char CACHE_MAGIC[4] = {'N', 'R', 'A', 'C'};
+const uint32_t CACHE_FORMAT_VERSION = 1;
+const char* CACHE_EXTENSION = ".nrac";
+
+const uint64_t PRIME1 = 0x9E3779B185EBCA87ULL;
+const uint64_t PRIME2 = 0xC2B2AE3D27D4EB4FULL;
+const uint64_t PRIME3 = 0x165667B19E3779F9ULL;
+const uint64_t PRIME4 = 0x85EBCA77C2B2AE63ULL;
+const uint64_t PRIME5 = 0x27D4EB2F165667C5ULL;
+
+inline uint64_t rotateLeft(uint64_t value, int bits) {
+    return (value << bits) | (value >> (64 - bits));
+}
+
+inline uint64_t readWord(const unsigned char* bytes) {
+    uint64_t word;
+    memcpy(&word, bytes, sizeof(word));
+    return word;
+}
+
+inline uint64_t laneRound(uint64_t accumulator, uint64_t input) {
+    accumulator += input * PRIME2;
+    accumulator = rotateLeft(accumulator, 31);
+    return accumulator * PRIME1;
+}
+
+inline uint64_t mergeRound(uint64_t hash, uint64_t lane) {
+    hash ^= laneRound(0, lane);
+    return hash * PRIME1 + PRIME4;
+}
+
+// 64-bit hash over a byte stream, four independent lanes of 8-byte words
+class ContentHasher {
+private:
+    uint64_t lanes[4];
+    unsigned char tail[32];
+    size_t tailSize;
+    uint64_t length;
+    uint64_t seed;
+
+    void consumeStripe(const unsigned char* stripe) {
+        for (int i = 0; i < 4; i++) {
+            lanes[i] = laneRound(lanes[i], readWord(stripe + i * 8));
+        }
+    }
+
+public:
+    explicit ContentHasher(uint64_t seed) : tailSize(0), length(0), seed(seed) {
+        lanes[0] = seed + PRIME1 + PRIME2;
+        lanes[1] = seed + PRIME2;
+        lanes[2] = seed;
+        lanes[3] = seed - PRIME1;
+    }
+
+    void update(const void* data, size_t size) {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        length += size;
+
+        if (tailSize > 0) {
+            size_t take = std::min(size, sizeof(tail) - tailSize);
+            memcpy(tail + tailSize, bytes, take);
+            tailSize += take;
+            bytes += take;
+            size -= take;
+
+            if (tailSize < sizeof(tail)) {
+                return;
+            }
+            consumeStripe(tail);
+            tailSize = 0;
+        }
+
+        while (size >= sizeof(tail)) {
+            consumeStripe(bytes);
+            bytes += sizeof(tail);
+            size -= sizeof(tail);
+        }
+
+        memcpy(tail, bytes, size);
+        tailSize = size;
+    }
+
+    uint64_t finish() const {
+        uint64_t hash;
+        if (length >= sizeof(tail)) {
+            hash = rotateLeft(lanes[0], 1) + rotateLeft(lanes[1], 7) + rotateLeft(lanes[2], 12) + rotateLeft(lanes[3], 18);
+            for (int i = 0; i < 4; i++) {
+                hash = mergeRound(hash, lanes[i]);
+            }
+        } else {
+            hash = seed + PRIME5;
+        }
+        hash += length;
+
+        size_t offset = 0;
+        for (; offset + 8 <= tailSize; offset += 8) {
+            hash ^= laneRound(0, readWord(tail + offset));
+            hash = rotateLeft(hash, 27) * PRIME1 + PRIME4;
+        }
+        for (; offset < tailSize; offset++) {
+            hash ^= tail[offset] * PRIME5;
+            hash = rotateLeft(hash, 11) * PRIME1;
+        }
+
+        hash ^= hash >> 33;
+        hash *= PRIME2;
+        hash ^= hash >> 29;
+        hash *= PRIME3;
+        hash ^= hash >> 32;
+        return hash;
+    }
+};
+
+class Writer {
+private:
+    std::vector<char>& buffer;
+
+public:
+    explicit Writer(std::vector<char>& buffer) : buffer(buffer) {}
+
+    template <typename T>
+    void value(const T& item) {
+        const char* bytes = reinterpret_cast<const char*>(&item);
+        buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+    }
+
+    template <typename T>
+    void array(const std::vector<T>& items) {
+        value(static_cast<uint64_t>(items.size()));
+        const char* bytes = reinterpret_cast<const char*>(items.data());
+        buffer.insert(buffer.end(), bytes, bytes + items.size() * sizeof(T));
+    }
+};
+
+class Reader {
+private:
+    const char* data;
+    size_t size;
+    size_t offset;
+
+public:
+    Reader(const char* data, size_t size) : data(data), size(size), offset(0) {}
+
+    template <typename T>
+    bool value(T& item) {
+        if (size - offset < sizeof(T)) {
+            return false;
+        }
+        memcpy(&item, data + offset, sizeof(T));
+        offset += sizeof(T);
+        return true;
+    }
+
+    template <typename T>
+    bool array(std::vector<T>& items) {
+        uint64_t count;
+        if (!value(count) || count > (size - offset) / sizeof(T)) {
+            return false;
+        }
+        items.resize(static_cast<size_t>(count));
+        memcpy(items.data(), data + offset, items.size() * sizeof(T));
+        offset += items.size() * sizeof(T);
+        return true;
+    }
+
+    bool atEnd() const { return offset == size; }
+};
+
+} // namespace
+
+AnalysisCache::AnalysisCache(const std::string& directory, uint64_t maxBytes)
+    : directory(directory), maxBytes(maxBytes) {}
+
+uint64_t AnalysisCache::hashBytes(const void* data, size_t size, uint64_t seed) {
+    ContentHasher hasher(seed);
+    hasher.update(data, size);
+    return hasher.finish();
+}
+
+uint64_t AnalysisCache::hashFile(const std::string& path, uint64_t offset, uint64_t length) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        throw std::runtime_error("Cannot open file: " + path);
+    }
+
+    // A length of 0 hashes everything from offset to the end of the file
+    uint64_t remaining = length ? length : std::numeric_limits<uint64_t>::max();
+    file.seekg(static_cast<std::streamoff>(offset), std::ios::beg);
+
+    ContentHasher hasher(0);
+    std::vector<char> chunk(1 << 20);
+    while (file && remaining > 0) {
+        file.read(chunk.data(), static_cast<std::streamsize>(std::min<uint64_t>(chunk.size(), remaining)));
+        std::streamsize bytesRead = file.gcount();
+        if (bytesRead <= 0) {
+            break;
+        }
+        hasher.update(chunk.data(), static_cast<size_t>(bytesRead));
+        remaining -= static_cast<uint64_t>(bytesRead);
+    }
+
+    return hasher.finish();
+}
+
+uint64_t AnalysisCache::makeKey(uint64_t contentHash, uint32_t analyzerVersion) {
+    uint64_t parts[2] = {contentHash, analyzerVersion};
+    return hashBytes(parts, sizeof(parts));
+}
+
+std::string AnalysisCache::entryPath(uint64_t key) const {
+    char name[17];
+    snprintf(name, sizeof(name), "%016llx", static_cast<unsigned long long>(key));
+    return (std::filesystem::path(directory) / (std::string(name) + CACHE_EXTENSION)).string();
+}
+
+std::vector<char> AnalysisCache::serialize(const AudioWaveform& waveform) {
+    std::vector<char> buffer;
+    Writer writer(buffer);
+
+    buffer.insert(buffer.end(), CACHE_MAGIC, CACHE_MAGIC + sizeof(CACHE_MAGIC));
+    writer.value(CACHE_FORMAT_VERSION);
+    writer.value(static_cast<uint32_t>(AudioAnalyzer::VERSION));
+
+    writer.value(waveform.sampleRate);
+    writer.value(waveform.duration);
+    writer.value(waveform.originalSampleRate);
+    writer.value(static_cast<int64_t>(waveform.totalSamples));
+    writer.array(waveform.data);
+
+    writer.value(static_cast<uint32_t>(waveform.levels.size()));
+    for (const WaveformLevel& level : waveform.levels) {
+        writer.value(static_cast<int32_t>(level.samplesPerPixel));
+        writer.array(level.peaks);
+        writer.array(level.rms);
+        writer.array(level.minimums);
+        writer.array(level.maximums);
+        writer.array(level.bass);
+        writer.array(level.onset);
+    }
+
+    writer.array(waveform.frequencyData);
+
+    writer.array(waveform.beatFeatures.energy);
+    writer.array(waveform.beatFeatures.zeroCrossings);
+    writer.array(waveform.beatFeatures.spectralCentroid);
+    writer.array(waveform.beatFeatures.bassEnergy);
+    writer.array(waveform.beatFeatures.rhythmIntensity);
+
+    writer.value(waveform.audioStats.peakAmplitude);
+    writer.value(waveform.audioStats.averageAmplitude);
+    writer.value(waveform.audioStats.dynamicRange);
+    writer.value(waveform.audioStats.silenceThreshold);
+    writer.array(waveform.audioStats.loudSections);
+
+    const Spectrogram& spectrogram = waveform.spectrogram;
+    writer.value(static_cast<int32_t>(spectrogram.bandCount));
+    writer.value(static_cast<int32_t>(spectrogram.frameCount));
+    writer.value(spectrogram.frameRate);
+    writer.value(spectrogram.firstFrameTime);
+    writer.array(spectrogram.tiles);
+
+    return buffer;
+}
+
+bool AnalysisCache::deserialize(const char* data, size_t size, AudioWaveform& waveform) {
+    if (size < sizeof(CACHE_MAGIC) || memcmp(data, CACHE_MAGIC, sizeof(CACHE_MAGIC)) != 0) {
+        return false;
+    }
+
+    Reader reader(data + sizeof(CACHE_MAGIC), size - sizeof(CACHE_MAGIC));
+    uint32_t formatVersion, analyzerVersion;
+    if (!reader.value(formatVersion) || formatVersion != CACHE_FORMAT_VERSION ||
+        !reader.value(analyzerVersion) || analyzerVersion != AudioAnalyzer::VERSION) {
+        return false;
+    }
+
+    AudioWaveform result;
+    int64_t totalSamples;
+    uint32_t levelCount;
+    int32_t bandCount, frameCount;
+
+    bool ok = reader.value(result.sampleRate) &&
+              reader.value(result.duration) &&
+              reader.value(result.originalSampleRate) &&
+              reader.value(totalSamples) &&
+              reader.array(result.data) &&
+              reader.value(levelCount);
+    if (!ok) {
+        return false;
+    }
+    result.totalSamples = static_cast<int>(totalSamples);
+
+    for (uint32_t i = 0; i < levelCount; i++) {
+        WaveformLevel level;
+        int32_t samplesPerPixel;
+        ok = reader.value(samplesPerPixel) &&
+             reader.array(level.peaks) &&
+             reader.array(level.rms) &&
+             reader.array(level.minimums) &&
+             reader.array(level.maximums) &&
+             reader.array(level.bass) &&
+             reader.array(level.onset);
+        if (!ok || samplesPerPixel <= 0) {
+            return false;
+        }
+        level.samplesPerPixel = samplesPerPixel;
+        result.levels.push_back(std::move(level));
+    }
+
+    ok = reader.array(result.frequencyData) &&
+         reader.array(result.beatFeatures.energy) &&
+         reader.array(result.beatFeatures.zeroCrossings) &&
+         reader.array(result.beatFeatures.spectralCentroid) &&
+         reader.array(result.beatFeatures.bassEnergy) &&
+         reader.array(result.beatFeatures.rhythmIntensity) &&
+         reader.value(result.audioStats.peakAmplitude) &&
+         reader.value(result.audioStats.averageAmplitude) &&
+         reader.value(result.audioStats.dynamicRange) &&
+         reader.value(result.audioStats.silenceThreshold) &&
+         reader.array(result.audioStats.loudSections) &&
+         reader.value(bandCount) &&
+         reader.value(frameCount) &&
+         reader.value(result.spectrogram.frameRate) &&
+         reader.value(result.spectrogram.firstFrameTime) &&
+         reader.array(result.spectrogram.tiles) &&
+         reader.atEnd();
+    if (!ok || bandCount < 0 || frameCount < 0) {
+        return false;
+    }
+
+    result.spectrogram.bandCount = bandCount;
+    result.spectrogram.frameCount = frameCount;
+    size_t tileBytes = static_cast<size_t>(Spectrogram::TILE_FRAMES) * static_cast<size_t>(bandCount);
+    if (result.spectrogram.tiles.size() != static_cast<size_t>(result.spectrogram.getTileCount()) * tileBytes) {
+        return false;
+    }
+
+    waveform = std::move(result);
+    return true;
+}
+
+bool AnalysisCache::load(uint64_t key, AudioWaveform& waveform) {
+    std::string path = entryPath(key);
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    std::streamsize size = file.tellg();
+    if (size <= 0) {
+        return false;
+    }
+    file.seekg(0, std::ios::beg);
+
+    std::vector<char> buffer(static_cast<size_t>(size));
+    if (!file.read(buffer.data(), size)) {
+        return false;
+    }
+    file.close();
+
+    if (!deserialize(buffer.data(), buffer.size(), waveform)) {
+        std::error_code error;
+        std::filesystem::remove(path, error);
+        return false;
+    }
+
+    // Touch the entry so eviction treats it as recently used
+    std::error_code error;
+    std::filesystem::last_write_time(path, std::filesystem::file_time_type::clock::now(), error);
+    return true;
+}
+
+bool AnalysisCache::store(uint64_t key, const AudioWaveform& waveform) {
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+    if (error) {
+        std::cerr << "Failed to create analysis cache directory: " << error.message() << std::endl;
+        return false;
+    }
+
+    std::vector<char> buffer = serialize(waveform);
+    if (buffer.size() > maxBytes) {
+        return false;
+    }
+
+    // Write to a temporary name first so a crash never leaves a truncated entry
+    std::string path = entryPath(key);
+    std::string tempPath = path + ".tmp";
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (!file.is_open() || !file.write(buffer.data(), buffer.size())) {
+            std::cerr << "Failed to write analysis cache entry: " << tempPath << std::endl;
+            std::filesystem::remove(tempPath, error);
+            return false;
+        }
+    }
+
+    std::filesystem::rename(tempPath, path, error);
+    if (error) {
+        std::cerr << "Failed to store analysis cache entry: " << error.message() << std::endl;
+        std::filesystem::remove(tempPath, error);
+        return false;
+    }
+
+    evict();
+    return true;
+}
+
+void AnalysisCache::evict() {
+    struct Entry {
+        std::filesystem::path path;
+        std::filesystem::file_time_type lastUsed;
+        uint64_t size;
+    };
+
+    std::vector<Entry> entries;
+    uint64_t totalBytes = 0;
+    std::error_code error;
+
+    for (const auto& item : std::filesystem::directory_iterator(directory, error)) {
+        if (!item.is_regular_file(error) || item.path().extension() != CACHE_EXTENSION) {
+            continue;
+        }
+
+        Entry entry{item.path(), item.last_write_time(error), item.file_size(error)};
+        if (!error) {
+            totalBytes += entry.size;
+            entries.push_back(entry);
+        }
+    }
+
+    if (totalBytes <= maxBytes) {
+        return;
+    }
+
+    std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) {
+        return a.lastUsed < b.lastUsed;
+    });
+
+    for (const Entry& entry : entries) {
+        if (totalBytes <= maxBytes) {
+            break;
+        }
+        if (std::filesystem::remove(entry.path, error)) {
+            totalBytes -= entry.size;
+        }
+    }
+}
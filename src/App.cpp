@@ -48,11 +48,45 @@ namespace App
 
         ImGui::TextColored(ImVec4(0.8f, 0.8f, 0.8f, 1.0f), "Editor: Create and edit rhythm charts");
         ImGui::TextColored(ImVec4(0.8f, 0.8f, 0.8f, 1.0f), "Player: Listen to charts");
+        ImGui::TextColored(ImVec4(0.6f, 0.6f, 0.6f, 1.0f), "F3: Frame pacing and frame times");
 
         ImGui::PopStyleColor();
         ImGui::End();
     }
 
+    void showFramePacingWindow(bool& open) {
+        Core::FrameScheduler& scheduler = Core::getFrameScheduler();
+
+        ImGui::SetNextWindowSize(ImVec2(320, 0), ImGuiCond_FirstUseEver);
+        if (!ImGui::Begin("Frame Pacing", &open)) {
+            ImGui::End();
+            return;
+        }
+
+        const char* modes[] = {"Adaptive", "VSync", "Limited", "Uncapped"};
+        int mode = scheduler.getMode();
+        if (ImGui::Combo("Mode", &mode, modes, IM_ARRAYSIZE(modes))) {
+            scheduler.setMode(static_cast<Core::FrameMode>(mode));
+        }
+
+        int targetFps = scheduler.getTargetFps();
+        if (ImGui::SliderInt("Target FPS", &targetFps, 30, 360)) {
+            scheduler.setTargetFps(targetFps);
+        }
+
+        const char* pacings[] = {"Idle", "VSync", "Limited", "Low latency"};
+        ImGui::Text("Pacing: %s", pacings[scheduler.getPacing()]);
+        ImGui::Separator();
+
+        Core::FrameStats stats = scheduler.getStats();
+        ImGui::Text("Frames: %zu", stats.samples);
+        ImGui::Text("FPS: %.1f", stats.fps);
+        ImGui::Text("Interval: avg %.2f ms, worst %.2f ms", stats.averageInterval, stats.worstInterval);
+        ImGui::Text("Work: avg %.2f ms, p99 %.2f ms, worst %.2f ms", stats.averageWork, stats.p99Work, stats.worstWork);
+
+        ImGui::End();
+    }
+
     void run() {
         static Config config;
         static std::unique_ptr<SoundManager> soundManager = std::make_unique<SoundManager>();
@@ -71,6 +105,11 @@ namespace App
             configured = true;
         }
 
+        static bool showFramePacing = false;
+        if (ImGui::IsKeyPressed(ImGuiKey_F3, false)) {
+            showFramePacing = !showFramePacing;
+        }
+
         if (ImGui::IsKeyPressed(ImGuiKey_Escape) && ImGui::GetIO().KeyCtrl) {
             if (currentMode == AppMode::MAIN_MENU) {
                 requestShutdown();
@@ -96,5 +135,19 @@ namespace App
                 player.render();
                 break;
         }
+
+        if (showFramePacing) {
+            showFramePacingWindow(showFramePacing);
+        }
+
+        // Drags, held buttons and text fields need every frame even without new events
+        if (ImGui::IsAnyItemActive() || ImGui::IsMouseDown(ImGuiMouseButton_Left) || ImGui::IsMouseDown(ImGuiMouseButton_Right)) {
+            Core::getFrameScheduler().requestAnimation();
+        }
+
+        // Key events are only consumed by the player, don't let them pile up elsewhere
+        if (currentMode != AppMode::PLAYER) {
+            Core::getInputQueue().clear();
+        }
     }
 } // namespace App
@@ -1,4 +1,8 @@
 #include "AudioAnalazyer.hpp"
+#include "FFT.hpp"
+#include "AudioKernels.hpp"
+#include "ThreadPool.hpp"
+#include "AnalysisCache.hpp"
 #include <limits>
 
 #ifdef __EMSCRIPTEN__
@@ -20,196 +24,349 @@ static int sf_close_stub(SNDFILE* sndfile) {
     return 0; // Success
 }
 
-static sf_count_t sf_readf_double_stub(SNDFILE* sndfile, double* ptr, sf_count_t frames) {
+static SNDFILE* sf_open_virtual_stub(SF_VIRTUAL_IO* sfvirtual, int mode, SF_INFO* sfinfo, void* user_data) {
+    return reinterpret_cast<SNDFILE*>(1);
+}
+
+static sf_count_t sf_readf_float_stub(SNDFILE* sndfile, float* ptr, sf_count_t frames) {
     // Return 0 frames read (empty file)
     return 0;
 }
 
+static sf_count_t sf_seek_stub(SNDFILE* sndfile, sf_count_t frames, int whence) {
+    return 0;
+}
+
 static const char* sf_strerror_stub(SNDFILE* sndfile) {
     return "WebAssembly stub - no audio file support";
 }
 
 // Override the libsndfile functions
 #define sf_open sf_open_stub
+#define sf_open_virtual sf_open_virtual_stub
 #define sf_close sf_close_stub
-#define sf_readf_double sf_readf_double_stub
+#define sf_readf_float sf_readf_float_stub
+#define sf_seek sf_seek_stub
 #define sf_strerror sf_strerror_stub
 #endif
 
-AudioAnalyzer::AudioAnalyzer(size_t maxFileSize) : maxFileSize(maxFileSize) {}
-
-void AudioAnalyzer::setProgressCallback(std::function<void(const AnalysisProgress&)> callback) {
-    progressCallback = callback;
-}
-
-void AudioAnalyzer::updateProgress(double progress, const std::string& stage) {
-    if (progressCallback) {
-        try {
-            progressCallback({progress, stage});
-        } catch (const std::exception& e) {
-            std::cerr << "Progress callback error: " << e.what() << std::endl;
+// Presents a byte range of a file to libsndfile as if it were a whole file
+struct AudioSectionReader {
+    FILE* file;
+    sf_count_t offset;
+    sf_count_t length;
+    sf_count_t position;
+
+    AudioSectionReader() : file(nullptr), offset(0), length(0), position(0) {}
+    ~AudioSectionReader() {
+        if (file) {
+            fclose(file);
         }
     }
-}
+};
 
-std::vector<double> AudioAnalyzer::loadAudioFile(const std::string& filename, double& sampleRate, double& duration) {
-    SF_INFO sfInfo;
-    memset(&sfInfo, 0, sizeof(sfInfo));
+namespace {
 
-    SNDFILE* file = sf_open(filename.c_str(), SFM_READ, &sfInfo);
-    if (!file) {
-        throw std::runtime_error("Failed to open audio file: " + std::string(sf_strerror(nullptr)));
+sf_count_t sectionLength(void* userData) {
+    return static_cast<AudioSectionReader*>(userData)->length;
+}
+
+sf_count_t sectionSeek(sf_count_t offset, int whence, void* userData) {
+    AudioSectionReader* section = static_cast<AudioSectionReader*>(userData);
+    sf_count_t target = offset;
+    if (whence == SEEK_CUR) {
+        target += section->position;
+    } else if (whence == SEEK_END) {
+        target += section->length;
     }
 
-    if (sfInfo.frames <= 0 || sfInfo.samplerate <= 0 || sfInfo.channels <= 0) {
-        sf_close(file);
-        throw std::runtime_error("Invalid audio file parameters");
+    if (target < 0 || target > section->length) {
+        return -1;
     }
+    section->position = target;
+    return target;
+}
 
-    size_t expectedSize = static_cast<size_t>(sfInfo.frames) * sfInfo.channels;
-    size_t memoryRequired = expectedSize * sizeof(double);
-    if (memoryRequired > maxFileSize) {
-        sf_close(file);
-        throw std::runtime_error("Audio file too large for analysis (requires " +
-                                std::to_string(memoryRequired / (1024 * 1024)) +
-                                "MB, max allowed: " + std::to_string(maxFileSize / (1024 * 1024)) + "MB)");
+sf_count_t sectionRead(void* buffer, sf_count_t count, void* userData) {
+    AudioSectionReader* section = static_cast<AudioSectionReader*>(userData);
+    count = std::min(count, section->length - section->position);
+    if (count <= 0 || fseek(section->file, static_cast<long>(section->offset + section->position), SEEK_SET) != 0) {
+        return 0;
     }
 
-    sampleRate = sfInfo.samplerate;
-    duration = static_cast<double>(sfInfo.frames) / sampleRate;
+    sf_count_t bytesRead = static_cast<sf_count_t>(fread(buffer, 1, static_cast<size_t>(count), section->file));
+    section->position += bytesRead;
+    return bytesRead;
+}
 
-    std::vector<double> audioData;
-    try {
-        audioData.resize(sfInfo.frames * sfInfo.channels);
-    } catch (const std::bad_alloc& e) {
-        sf_close(file);
-        throw std::runtime_error("Failed to allocate memory for audio data: " + std::string(e.what()));
-    }
+sf_count_t sectionWrite(const void*, sf_count_t, void*) {
+    return 0;
+}
+
+sf_count_t sectionTell(void* userData) {
+    return static_cast<AudioSectionReader*>(userData)->position;
+}
 
-    const sf_count_t chunkSize = 1000000;
-    sf_count_t totalSamplesRead = 0;
+SF_VIRTUAL_IO sectionIo = {sectionLength, sectionSeek, sectionRead, sectionWrite, sectionTell};
 
-    for (sf_count_t offset = 0; offset < sfInfo.frames; offset += chunkSize) {
-        sf_count_t samplesToRead = std::min(chunkSize, sfInfo.frames - offset);
-        sf_count_t samplesRead = sf_readf_double(file,
-            audioData.data() + (offset * sfInfo.channels),
-            samplesToRead);
+const sf_count_t STREAM_BLOCK_FRAMES = 1 << 18;
+const size_t CHUNK_SAMPLES = 16384;
+const size_t CHUNK_WINDOWS = 16;
 
-        if (samplesRead != samplesToRead) {
-            sf_close(file);
-            throw std::runtime_error("Failed to read complete audio file");
-        }
+// Keeps the tail of the stream that overlapping analysis windows still need
+class SlidingBuffer {
+private:
+    std::vector<float> data;
+    size_t start = 0;
 
-        totalSamplesRead += samplesRead;
+public:
+    void append(const float* samples, size_t count) {
+        if (start > 0) {
+            data.erase(data.begin(), data.begin() + start);
+            start = 0;
+        }
+        data.insert(data.end(), samples, samples + count);
     }
 
-    if (totalSamplesRead != sfInfo.frames) {
-        sf_close(file);
-        throw std::runtime_error("Failed to read complete audio file");
+    size_t available() const { return data.size() - start; }
+    const float* front() const { return data.data() + start; }
+    void consume(size_t count) { start += std::min(count, available()); }
+};
+
+// Splits [0, count) into contiguous ranges of chunkSize items. The boundaries never
+// depend on the pool size, so partial sums merge in the same order on every machine
+std::vector<std::pair<size_t, size_t>> splitRange(size_t count, size_t chunkSize) {
+    std::vector<std::pair<size_t, size_t>> ranges;
+    for (size_t start = 0; start < count; start += chunkSize) {
+        ranges.push_back({start, std::min(count, start + chunkSize)});
     }
+    return ranges;
+}
 
-    sf_close(file);
+// Size of the window sequence that fits in the buffered samples
+size_t countWindows(size_t available, size_t windowSize, size_t hopSize) {
+    return available >= windowSize ? (available - windowSize) / hopSize + 1 : 0;
+}
 
-    if (sfInfo.channels == 2) {
-        std::vector<double> monoData(sfInfo.frames);
-        for (int i = 0; i < sfInfo.frames; i++) {
-            monoData[i] = (audioData[i * 2] + audioData[i * 2 + 1]) * 0.5;
+/**
+ * One analysis stage of the streaming pipeline. For every decoded batch,
+ * prepare() and commit() run on the scheduling thread while processChunk()
+ * runs on the worker pool; chunks of the same batch never depend on each other
+ * and commit() merges their partial results in stream order.
+ */
+class AnalysisStage {
+public:
+    virtual ~AnalysisStage() = default;
+    virtual size_t prepare(const float* samples, size_t count) = 0;
+    virtual void processChunk(size_t chunk) = 0;
+    virtual void commit() = 0;
+};
+
+struct WaveformBin {
+    float minPeak = std::numeric_limits<float>::infinity();
+    float maxPeak = -std::numeric_limits<float>::infinity();
+    double sumSquares = 0.0;
+    double bassEnergy = 0.0;
+    double rhythmEnergy = 0.0;
+    double onsetEnergy = 0.0;
+    int sampleCount = 0;
+    int diffCount = 0;
+
+    void merge(const WaveformBin& other) {
+        minPeak = std::min(minPeak, other.minPeak);
+        maxPeak = std::max(maxPeak, other.maxPeak);
+        sumSquares += other.sumSquares;
+        bassEnergy += other.bassEnergy;
+        rhythmEnergy += other.rhythmEnergy;
+        onsetEnergy += other.onsetEnergy;
+        sampleCount += other.sampleCount;
+        diffCount += other.diffCount;
+    }
+};
+
+// Sums over consecutive sample pairs, gathered with the vector kernels
+struct PairSums {
+    double currentSquares = 0.0;
+    double previousSquares = 0.0;
+    double differenceEnergy = 0.0;
+    double differenceAbs = 0.0;
+    double crossingDifference = 0.0;
+    size_t pairs = 0;
+
+    // sum((a * sample + b * previous)^2), expanded so it only needs the sums above
+    double weightedEnergy(double a, double b) const {
+        double crossTerm = currentSquares + previousSquares - differenceEnergy;
+        return a * a * currentSquares + b * b * previousSquares + a * b * crossTerm;
+    }
+};
+
+PairSums computePairSums(const float* samples, size_t start, size_t end, float previous, bool hasPrevious) {
+    PairSums sums;
+    size_t first = start;
+
+    if (start == 0) {
+        if (hasPrevious && end > 0) {
+            float sample = samples[0];
+            double difference = sample - previous;
+            sums.currentSquares += sample * sample;
+            sums.previousSquares += previous * previous;
+            sums.differenceEnergy += difference * difference;
+            sums.differenceAbs += std::abs(difference);
+            if ((previous >= 0) != (sample >= 0)) {
+                sums.crossingDifference += std::abs(difference);
+            }
+            sums.pairs++;
         }
-        return monoData;
-    } else if (sfInfo.channels == 1) {
-        return audioData;
-    } else {
-        throw std::runtime_error("Unsupported number of channels: " + std::to_string(sfInfo.channels));
+        first = 1;
     }
-}
 
-WaveformLevel AudioAnalyzer::generateWaveformLevel(const std::vector<double>& channelData, int samplesPerPixel) {
-    std::vector<double> peaks;
-    std::vector<double> rms;
+    if (end > first) {
+        const float* base = samples + first - 1;
+        size_t count = end - first + 1;
+        sums.currentSquares += AudioKernels::sumSquares(base + 1, count - 1);
+        sums.previousSquares += AudioKernels::sumSquares(base, count - 1);
+        sums.differenceEnergy += AudioKernels::differenceEnergy(base, count);
+        sums.differenceAbs += AudioKernels::differenceAbsSum(base, count);
+        sums.crossingDifference += AudioKernels::crossingDifferenceSum(base, count);
+        sums.pairs += count - 1;
+    }
 
-    int segmentCount = static_cast<int>(std::ceil(static_cast<double>(channelData.size()) / samplesPerPixel));
+    return sums;
+}
+
+// Builds the finest waveform level in one pass, coarser levels are reduced from it
+class WaveformAccumulator : public AnalysisStage {
+private:
+    static const size_t coarsestBinCount = 1000;
+
+    struct Chunk {
+        size_t start;
+        size_t end;
+        std::vector<WaveformBin> bins;
+        double globalSum;
+        double globalBassSum;
+        double globalRhythmSum;
+    };
 
-    double globalMax = 0.0;
+    int samplesPerPixel;
+    std::vector<WaveformBin> bins;
+    WaveformBin current;
     double globalSum = 0.0;
     double globalBassSum = 0.0;
     double globalRhythmSum = 0.0;
+    size_t sampleCount = 0;
+    float previous = 0.0f;
+
+    const float* batch = nullptr;
+    size_t batchCount = 0;
+    std::vector<Chunk> chunks;
+
+    WaveformLevel finishLevel(const std::vector<WaveformBin>& levelBins, int levelSamplesPerPixel) const;
+
+public:
+    WaveformAccumulator(int samplesPerPixel, size_t expectedSamples) : samplesPerPixel(samplesPerPixel) {
+        bins.reserve(expectedSamples / samplesPerPixel + 1);
+    }
+
+    size_t prepare(const float* samples, size_t count) override;
+    void processChunk(size_t chunk) override;
+    void commit() override;
+    std::vector<WaveformLevel> finish();
+};
+
+size_t WaveformAccumulator::prepare(const float* samples, size_t count) {
+    batch = samples;
+    batchCount = count;
+    chunks.clear();
+
+    for (const auto& range : splitRange(count, CHUNK_SAMPLES)) {
+        chunks.push_back({range.first, range.second, {}, 0.0, 0.0, 0.0});
+    }
+    return chunks.size();
+}
+
+void WaveformAccumulator::processChunk(size_t index) {
+    Chunk& chunk = chunks[index];
+    bool hasPrevious = sampleCount > 0;
 
-    for (size_t i = 0; i < channelData.size(); i++) {
-        double sample = channelData[i];
-        double absSample = std::abs(sample);
-        globalMax = std::max(globalMax, absSample);
-        globalSum += absSample;
+    // Bins stay aligned to the global grid so commit() can merge them as they are
+    size_t offset = (static_cast<size_t>(current.sampleCount) + chunk.start) % samplesPerPixel;
+    size_t start = chunk.start;
 
-        if (i > 0) {
-            double bassComponent = sample * 0.8 + channelData[i-1] * 0.2;
-            globalBassSum += bassComponent * bassComponent;
+    while (start < chunk.end) {
+        size_t end = std::min(chunk.end, start + (samplesPerPixel - offset));
+        WaveformBin bin;
 
-            double onset = std::abs(sample - channelData[i-1]);
-            globalRhythmSum += onset;
+        AudioKernels::minMax(batch + start, end - start, bin.minPeak, bin.maxPeak);
+        bin.sumSquares = AudioKernels::sumSquares(batch + start, end - start);
+        bin.sampleCount = static_cast<int>(end - start);
+
+        // bass = 0.2 * sample + 0.8 * previous, onset = sample - previous
+        PairSums pairs = computePairSums(batch, start, end, previous, hasPrevious);
+        bin.bassEnergy = pairs.weightedEnergy(0.2, 0.8) * 2.0;
+        bin.onsetEnergy = pairs.differenceEnergy;
+        bin.rhythmEnergy = pairs.crossingDifference * 1.5;
+        bin.diffCount = static_cast<int>(pairs.pairs);
+
+        chunk.bins.push_back(bin);
+        offset = 0;
+        start = end;
+    }
+
+    PairSums chunkPairs = computePairSums(batch, chunk.start, chunk.end, previous, hasPrevious);
+    chunk.globalSum = AudioKernels::absSum(batch + chunk.start, chunk.end - chunk.start);
+    chunk.globalBassSum = chunkPairs.weightedEnergy(0.8, 0.2);
+    chunk.globalRhythmSum = chunkPairs.differenceAbs;
+}
+
+void WaveformAccumulator::commit() {
+    for (const Chunk& chunk : chunks) {
+        for (const WaveformBin& bin : chunk.bins) {
+            current.merge(bin);
+            if (current.sampleCount == samplesPerPixel) {
+                bins.push_back(current);
+                current = WaveformBin();
+            }
         }
+
+        globalSum += chunk.globalSum;
+        globalBassSum += chunk.globalBassSum;
+        globalRhythmSum += chunk.globalRhythmSum;
+    }
+
+    if (batchCount > 0) {
+        previous = batch[batchCount - 1];
     }
+    sampleCount += batchCount;
+    chunks.clear();
+}
 
-    double globalAverage = globalSum / channelData.size();
-    double globalBassAverage = std::sqrt(globalBassSum / (channelData.size() - 1));
-    double globalRhythmAverage = globalRhythmSum / (channelData.size() - 1);
+WaveformLevel WaveformAccumulator::finishLevel(const std::vector<WaveformBin>& levelBins, int levelSamplesPerPixel) const {
+    WaveformLevel level;
+    level.samplesPerPixel = levelSamplesPerPixel;
+    level.peaks.reserve(levelBins.size());
+    level.rms.reserve(levelBins.size());
+    level.minimums.reserve(levelBins.size());
+    level.maximums.reserve(levelBins.size());
+    level.bass.reserve(levelBins.size());
+    level.onset.reserve(levelBins.size());
+
+    double differences = sampleCount > 1 ? static_cast<double>(sampleCount - 1) : 1.0;
+    double globalAverage = sampleCount > 0 ? globalSum / sampleCount : 0.0;
+    double globalBassAverage = std::sqrt(globalBassSum / differences);
+    double globalRhythmAverage = globalRhythmSum / differences;
 
     double silenceThreshold = globalAverage * 0.1;
     double bassThreshold = globalBassAverage * 0.3;
     double rhythmThreshold = globalRhythmAverage * 0.5;
 
-    for (int i = 0; i < segmentCount; i++) {
-        int startSample = i * samplesPerPixel;
-        int endSample = std::min(startSample + samplesPerPixel, static_cast<int>(channelData.size()));
-
-        if (startSample >= static_cast<int>(channelData.size()) || startSample >= endSample) {
-            peaks.push_back(0.0);
-            rms.push_back(0.0);
-            continue;
-        }
-
-        double maxPeak = -std::numeric_limits<double>::infinity();
-        double minPeak = std::numeric_limits<double>::infinity();
-        double sumSquares = 0.0;
-        double bassEnergy = 0.0;
-        double rhythmEnergy = 0.0;
-        double onsetEnergy = 0.0;
-        int sampleCount = 0;
-        int bassCount = 0;
-        int rhythmCount = 0;
-
-        for (int j = startSample; j < endSample && j < static_cast<int>(channelData.size()); j++) {
-            double sample = channelData[j];
-            maxPeak = std::max(maxPeak, sample);
-            minPeak = std::min(minPeak, sample);
-            sumSquares += sample * sample;
-            sampleCount++;
-
-            if (j > startSample) {
-                double highFreq = sample - channelData[j - 1];
-                double midFreq = sample - highFreq * 0.5;
-                double bassComponent = midFreq - highFreq * 0.3;
-
-                bassEnergy += bassComponent * bassComponent * 2.0;
-                bassCount++;
-
-                double onset = std::abs(sample - channelData[j - 1]);
-                onsetEnergy += onset * onset;
-
-                bool prevPositive = channelData[j - 1] >= 0;
-                bool currPositive = sample >= 0;
-                if (prevPositive != currPositive) {
-                    rhythmEnergy += onset * 1.5;
-                }
-                rhythmCount++;
-            }
-        }
-
-        double rmsValue = std::sqrt(sumSquares / sampleCount);
-        double avgBassEnergy = bassCount > 0 ? std::sqrt(bassEnergy / bassCount) : 0.0;
-        double avgRhythmEnergy = rhythmCount > 0 ? std::sqrt(rhythmEnergy / rhythmCount) : 0.0;
-        double avgOnsetEnergy = rhythmCount > 0 ? std::sqrt(onsetEnergy / rhythmCount) : 0.0;
+    for (const WaveformBin& bin : levelBins) {
+        double rmsValue = std::sqrt(bin.sumSquares / bin.sampleCount);
+        double avgBassEnergy = bin.diffCount > 0 ? std::sqrt(bin.bassEnergy / bin.diffCount) : 0.0;
+        double avgRhythmEnergy = bin.diffCount > 0 ? std::sqrt(bin.rhythmEnergy / bin.diffCount) : 0.0;
+        double avgOnsetEnergy = bin.diffCount > 0 ? std::sqrt(bin.onsetEnergy / bin.diffCount) : 0.0;
 
-        double peakAmplitude = std::max(std::abs(maxPeak), std::abs(minPeak));
+        double peakAmplitude = std::max(std::abs(bin.maxPeak), std::abs(bin.minPeak));
 
         double volumeComponent = peakAmplitude * 0.3;
         double bassComponent = avgBassEnergy * 2.5;
@@ -235,268 +392,592 @@ WaveformLevel AudioAnalyzer::generateWaveformLevel(const std::vector<double>& ch
         double compressionFactor = 0.6;
         double finalAmplitude = std::pow(processedAmplitude, compressionFactor);
 
-        peaks.push_back(finalAmplitude);
-        rms.push_back(rmsValue);
+        level.peaks.push_back(finalAmplitude);
+        level.rms.push_back(rmsValue);
+        level.minimums.push_back(bin.minPeak);
+        level.maximums.push_back(bin.maxPeak);
+        level.bass.push_back(static_cast<float>(avgBassEnergy));
+        level.onset.push_back(static_cast<float>(avgOnsetEnergy));
     }
 
-    if (!peaks.empty()) {
-        double maxPeak = *std::max_element(peaks.begin(), peaks.end());
-        double minPeak = *std::min_element(peaks.begin(), peaks.end());
+    if (!level.peaks.empty()) {
+        double maxPeak = *std::max_element(level.peaks.begin(), level.peaks.end());
+        double minPeak = *std::min_element(level.peaks.begin(), level.peaks.end());
         double range = maxPeak - minPeak;
 
         if (range > 0.0) {
-            for (double& peak : peaks) {
+            for (double& peak : level.peaks) {
                 peak = (peak - minPeak) / range;
             }
         } else {
-            for (double& peak : peaks) {
+            for (double& peak : level.peaks) {
                 peak = 0.5;
             }
         }
     }
 
-    return {peaks, rms, samplesPerPixel};
+    return level;
 }
 
-std::vector<double> AudioAnalyzer::analyzeFrequencyContent(const std::vector<double>& channelData, double sampleRate) {
-    const int windowSize = 2048;
-    const int hopSize = windowSize / 4;
+std::vector<WaveformLevel> WaveformAccumulator::finish() {
+    if (current.sampleCount > 0) {
+        bins.push_back(current);
+        current = WaveformBin();
+    }
+
+    std::vector<WaveformLevel> levels;
+    levels.push_back(finishLevel(bins, samplesPerPixel));
+
+    // Each coarser level merges pairs of bins from the level below it
+    std::vector<WaveformBin> levelBins = std::move(bins);
+    int levelSamplesPerPixel = samplesPerPixel;
+
+    while (levelBins.size() > coarsestBinCount) {
+        std::vector<WaveformBin> reduced((levelBins.size() + 1) / 2);
+        for (size_t i = 0; i < reduced.size(); i++) {
+            reduced[i] = levelBins[i * 2];
+            if (i * 2 + 1 < levelBins.size()) {
+                reduced[i].merge(levelBins[i * 2 + 1]);
+            }
+        }
+
+        levelBins = std::move(reduced);
+        levelSamplesPerPixel *= 2;
+        levels.push_back(finishLevel(levelBins, levelSamplesPerPixel));
+    }
+
+    bins.clear();
+    return levels;
+}
+
+// Spectral centroid over 2048-sample windows with a 512-sample hop
+class FrequencyAccumulator : public AnalysisStage {
+private:
+    static const size_t windowSize = 2048;
+    static const size_t hopSize = windowSize / 4;
+
+    double sampleRate;
+    std::shared_ptr<const FFTPlan> plan;
+    SlidingBuffer buffer;
     std::vector<double> frequencyData;
 
-    int maxWindows = std::min(1000, static_cast<int>((channelData.size() - windowSize) / hopSize));
+    size_t batchWindows = 0;
+    size_t batchBase = 0;
+    std::vector<std::pair<size_t, size_t>> chunks;
+
+public:
+    explicit FrequencyAccumulator(double sampleRate)
+        : sampleRate(sampleRate), plan(FFTPlan::get(windowSize)) {}
+
+    size_t prepare(const float* samples, size_t count) override {
+        buffer.append(samples, count);
+        batchWindows = countWindows(buffer.available(), windowSize, hopSize);
+        batchBase = frequencyData.size();
+        frequencyData.resize(batchBase + batchWindows);
+        chunks = splitRange(batchWindows, CHUNK_WINDOWS);
+        return chunks.size();
+    }
+
+    void processChunk(size_t chunk) override {
+        std::vector<std::complex<float>> bins(plan->getBinCount());
+
+        for (size_t window = chunks[chunk].first; window < chunks[chunk].second; window++) {
+            plan->forwardReal(buffer.front() + window * hopSize, bins.data());
 
-    for (int i = 0; i < maxWindows; i++) {
-        int startIndex = i * hopSize;
+            double spectralSum = 0.0;
+            double magnitudeSum = 0.0;
 
-        if (startIndex + windowSize > static_cast<int>(channelData.size())) {
-            break;
+            for (size_t k = 1; k < windowSize / 2; k++) {
+                double magnitude = std::sqrt(bins[k].real() * bins[k].real() + bins[k].imag() * bins[k].imag());
+                double frequency = k * sampleRate / windowSize;
+
+                spectralSum += frequency * magnitude;
+                magnitudeSum += magnitude;
+            }
+
+            frequencyData[batchBase + window] = magnitudeSum > 0 ? spectralSum / magnitudeSum : 0.0;
         }
+    }
 
-        double spectralSum = 0.0;
-        double magnitudeSum = 0.0;
+    void commit() override {
+        buffer.consume(batchWindows * hopSize);
+    }
 
-        // Simple DFT for spectral centroid calculation
-        for (int k = 1; k < windowSize / 2; k++) {
-            double real = 0.0;
-            double imag = 0.0;
+    std::vector<double> finish() { return std::move(frequencyData); }
+};
+
+// Log-band STFT of the whole track, written straight into the tiled layout
+class SpectrogramAccumulator : public AnalysisStage {
+private:
+    static const size_t windowSize = SpectrumStream::WINDOW_SIZE;
+    static const size_t hopSize = Spectrogram::HOP_SIZE;
+    static const size_t tileSize = Spectrogram::TILE_FRAMES;
+
+    SpectrumStream bandMapper; // Only its const computeFrame() is used, from every chunk
+    SlidingBuffer buffer;
+    Spectrogram spectrogram;
+
+    size_t batchWindows = 0;
+    size_t batchBase = 0;
+    std::vector<std::pair<size_t, size_t>> chunks;
+
+public:
+    explicit SpectrogramAccumulator(double sampleRate) {
+        bandMapper.configure(sampleRate, Spectrogram::BAND_COUNT);
+        spectrogram.bandCount = static_cast<int>(bandMapper.getBandCount());
+        spectrogram.frameRate = sampleRate / hopSize;
+        spectrogram.firstFrameTime = windowSize * 0.5 / sampleRate;
+    }
+
+    size_t prepare(const float* samples, size_t count) override {
+        buffer.append(samples, count);
+        batchWindows = countWindows(buffer.available(), windowSize, hopSize);
+        batchBase = static_cast<size_t>(spectrogram.frameCount);
+
+        // Whole tiles only, so chunks write into storage that never moves
+        size_t total = batchBase + batchWindows;
+        size_t tileBytes = tileSize * static_cast<size_t>(spectrogram.bandCount);
+        spectrogram.tiles.resize((total + tileSize - 1) / tileSize * tileBytes, 0);
+        spectrogram.frameCount = static_cast<int>(total);
+
+        chunks = splitRange(batchWindows, CHUNK_WINDOWS);
+        return chunks.size();
+    }
+
+    void processChunk(size_t chunk) override {
+        size_t bandCount = static_cast<size_t>(spectrogram.bandCount);
+        std::vector<float> scratch(windowSize);
+        std::vector<std::complex<float>> bins(bandMapper.getBinCount());
+        std::vector<float> bands(bandCount);
+
+        for (size_t window = chunks[chunk].first; window < chunks[chunk].second; window++) {
+            bandMapper.computeFrame(buffer.front() + window * hopSize, bands.data(), scratch.data(), bins.data());
 
-            for (int n = 0; n < windowSize; n++) {
-                double sample = (startIndex + n < static_cast<int>(channelData.size())) ? channelData[startIndex + n] : 0.0;
-                double angle = -2.0 * M_PI * k * n / windowSize;
-                real += sample * std::cos(angle);
-                imag += sample * std::sin(angle);
+            size_t frame = batchBase + window;
+            uint8_t* column = spectrogram.tiles.data() + (frame / tileSize) * tileSize * bandCount + frame % tileSize;
+            for (size_t band = 0; band < bandCount; band++) {
+                column[band * tileSize] = static_cast<uint8_t>(bands[band] * 255.0f + 0.5f);
             }
+        }
+    }
+
+    void commit() override {
+        buffer.consume(batchWindows * hopSize);
+    }
+
+    Spectrogram finish() { return std::move(spectrogram); }
+};
 
-            double magnitude = std::sqrt(real * real + imag * imag);
-            double frequency = k * sampleRate / windowSize;
+// Energy, zero crossings and bass energy over 100ms windows with 50% overlap
+class BeatAccumulator : public AnalysisStage {
+private:
+    size_t windowSize;
+    size_t hopSize;
+    SlidingBuffer buffer;
+    BeatFeatures beatFeatures;
 
-            spectralSum += frequency * magnitude;
-            magnitudeSum += magnitude;
+    size_t batchWindows = 0;
+    size_t batchBase = 0;
+    std::vector<std::pair<size_t, size_t>> chunks;
+
+public:
+    explicit BeatAccumulator(double sampleRate)
+        : windowSize(std::max<size_t>(2, static_cast<size_t>(sampleRate * 0.1))),
+          hopSize(std::max<size_t>(1, windowSize / 2)) {}
+
+    size_t prepare(const float* samples, size_t count) override {
+        buffer.append(samples, count);
+        batchWindows = countWindows(buffer.available(), windowSize, hopSize);
+        batchBase = beatFeatures.energy.size();
+
+        size_t total = batchBase + batchWindows;
+        beatFeatures.energy.resize(total);
+        beatFeatures.zeroCrossings.resize(total);
+        beatFeatures.spectralCentroid.resize(total, 0.0); // Simplified
+        beatFeatures.bassEnergy.resize(total);
+        beatFeatures.rhythmIntensity.resize(total);
+
+        chunks = splitRange(batchWindows, CHUNK_WINDOWS);
+        return chunks.size();
+    }
+
+    void processChunk(size_t chunk) override {
+        for (size_t window = chunks[chunk].first; window < chunks[chunk].second; window++) {
+            const float* samples = buffer.front() + window * hopSize;
+            double energy = AudioKernels::sumSquares(samples, windowSize);
+            size_t zeroCrossings = AudioKernels::zeroCrossings(samples, windowSize);
+
+            // Simple bass energy calculation: sample - (sample - previous)
+            double bassEnergy = AudioKernels::sumSquares(samples, windowSize - 1);
+
+            energy = energy / windowSize;
+            bassEnergy = bassEnergy / windowSize;
+
+            size_t index = batchBase + window;
+            beatFeatures.energy[index] = energy;
+            beatFeatures.zeroCrossings[index] = static_cast<double>(zeroCrossings);
+            beatFeatures.bassEnergy[index] = bassEnergy;
+            beatFeatures.rhythmIntensity[index] = std::sqrt(energy * bassEnergy);
         }
+    }
+
+    void commit() override {
+        buffer.consume(batchWindows * hopSize);
+    }
+
+    BeatFeatures finish() { return std::move(beatFeatures); }
+};
+
+class StatsAccumulator : public AnalysisStage {
+private:
+    struct Chunk {
+        size_t start;
+        size_t end;
+        double maxAmplitude;
+        double sumAmplitude;
+        double sumSquares;
+        std::vector<std::pair<size_t, double>> sectionPieces;
+    };
+
+    double sampleRate;
+    size_t samplesPerSection;
+    double maxAmplitude = 0.0;
+    double sumAmplitude = 0.0;
+    double sumSquares = 0.0;
+    size_t sampleCount = 0;
+
+    // 500ms sections, thresholded once the overall RMS is known
+    std::vector<LoudSection> sections;
+    double sectionEnergy = 0.0;
+    size_t sectionSamples = 0;
+
+    const float* batch = nullptr;
+    std::vector<Chunk> chunks;
+
+    void closeSection() {
+        size_t sectionEnd = sampleCount;
+        size_t sectionStart = sectionEnd - sectionSamples;
+        sections.push_back({
+            static_cast<double>(sectionStart) / sampleRate,
+            static_cast<double>(sectionEnd) / sampleRate,
+            std::sqrt(sectionEnergy / sectionSamples)
+        });
+        sectionEnergy = 0.0;
+        sectionSamples = 0;
+    }
+
+public:
+    explicit StatsAccumulator(double sampleRate)
+        : sampleRate(sampleRate), samplesPerSection(std::max<size_t>(1, static_cast<size_t>(sampleRate * 0.5))) {}
 
-        double spectralCentroid = magnitudeSum > 0 ? spectralSum / magnitudeSum : 0.0;
-        frequencyData.push_back(spectralCentroid);
+    size_t prepare(const float* samples, size_t count) override {
+        batch = samples;
+        chunks.clear();
 
-        if (i % 20 == 0) {
-            double progress = 55.0 + (static_cast<double>(i) / maxWindows) * 10.0;
-            updateProgress(progress, "Analyzing frequency content... (" + std::to_string(i) + "/" + std::to_string(maxWindows) + ")");
-            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        for (const auto& range : splitRange(count, CHUNK_SAMPLES)) {
+            chunks.push_back({range.first, range.second, 0.0, 0.0, 0.0, {}});
         }
+        return chunks.size();
     }
 
-    return frequencyData;
-}
+    void processChunk(size_t index) override {
+        Chunk& chunk = chunks[index];
+        size_t offset = (sampleCount + chunk.start) % samplesPerSection;
+        size_t start = chunk.start;
 
-BeatFeatures AudioAnalyzer::analyzeBeatFeatures(const std::vector<double>& channelData, double sampleRate) {
-    int windowSize = static_cast<int>(sampleRate * 0.1); // 100ms windows
-    int hopSize = windowSize / 2;
-    int maxWindows = std::min(2000, static_cast<int>((channelData.size() - windowSize) / hopSize));
+        while (start < chunk.end) {
+            size_t end = std::min(chunk.end, start + (samplesPerSection - offset));
+            const float* range = batch + start;
+            size_t rangeCount = end - start;
 
-    BeatFeatures beatFeatures;
+            double squares = AudioKernels::sumSquares(range, rangeCount);
+            chunk.maxAmplitude = std::max(chunk.maxAmplitude, static_cast<double>(AudioKernels::absMax(range, rangeCount)));
+            chunk.sumAmplitude += AudioKernels::absSum(range, rangeCount);
+            chunk.sumSquares += squares;
+            chunk.sectionPieces.push_back({rangeCount, squares});
 
-    for (int i = 0; i < maxWindows; i++) {
-        int startIndex = i * hopSize;
-        double energy = 0.0;
-        int zeroCrossings = 0;
-        double bassEnergy = 0.0;
+            offset = 0;
+            start = end;
+        }
+    }
 
-        for (int j = 0; j < windowSize; j++) {
-            if (startIndex + j >= static_cast<int>(channelData.size())) break;
+    void commit() override {
+        for (const Chunk& chunk : chunks) {
+            maxAmplitude = std::max(maxAmplitude, chunk.maxAmplitude);
+            sumAmplitude += chunk.sumAmplitude;
+            sumSquares += chunk.sumSquares;
 
-            double sample = channelData[startIndex + j];
-            energy += sample * sample;
+            for (const auto& piece : chunk.sectionPieces) {
+                sampleCount += piece.first;
+                sectionSamples += piece.first;
+                sectionEnergy += piece.second;
 
-            // Count zero crossings
-            if (j > 0 && startIndex + j - 1 < static_cast<int>(channelData.size())) {
-                bool prevPositive = channelData[startIndex + j - 1] >= 0;
-                bool currPositive = sample >= 0;
-                if (prevPositive != currPositive) {
-                    zeroCrossings++;
+                if (sectionSamples == samplesPerSection) {
+                    closeSection();
                 }
             }
+        }
+        chunks.clear();
+    }
+
+    AudioStats finish() {
+        if (sectionSamples > 0) {
+            closeSection();
+        }
+
+        double averageAmplitude = sampleCount > 0 ? sumAmplitude / sampleCount : 0.0;
+        double rmsAmplitude = sampleCount > 0 ? std::sqrt(sumSquares / sampleCount) : 0.0;
+        double silenceThreshold = averageAmplitude * 0.1;
+        double energyThreshold = rmsAmplitude * 2.0;
 
-            // Simple bass energy calculation
-            if (j > 0 && startIndex + j - 1 < static_cast<int>(channelData.size())) {
-                double highFreq = sample - channelData[startIndex + j - 1];
-                double bassComponent = sample - highFreq;
-                bassEnergy += bassComponent * bassComponent;
+        std::vector<LoudSection> loudSections;
+        for (const LoudSection& section : sections) {
+            if (section.intensity > energyThreshold) {
+                loudSections.push_back(section);
             }
         }
 
-        energy = energy / windowSize;
-        bassEnergy = bassEnergy / windowSize;
-        double rhythmIntensity = std::sqrt(energy * bassEnergy);
+        return {
+            maxAmplitude,
+            averageAmplitude,
+            maxAmplitude - silenceThreshold,
+            silenceThreshold,
+            loudSections
+        };
+    }
+};
+
+} // namespace
 
-        beatFeatures.energy.push_back(energy);
-        beatFeatures.zeroCrossings.push_back(static_cast<double>(zeroCrossings));
-        beatFeatures.spectralCentroid.push_back(0.0); // Simplified
-        beatFeatures.bassEnergy.push_back(bassEnergy);
-        beatFeatures.rhythmIntensity.push_back(rhythmIntensity);
+const WaveformLevel* AudioWaveform::findLevel(double samplesPerPixel) const {
+    const WaveformLevel* best = nullptr;
+    double bestDistance = std::numeric_limits<double>::infinity();
 
-        if (i % 200 == 0) {
-            double progress = 70.0 + (static_cast<double>(i) / maxWindows) * 10.0;
-            updateProgress(progress, "Detecting beats and rhythm... (" + std::to_string(i) + "/" + std::to_string(maxWindows) + ")");
-            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    for (const WaveformLevel& level : levels) {
+        double distance = std::abs(std::log(std::max(1.0, samplesPerPixel) / level.samplesPerPixel));
+        if (distance < bestDistance) {
+            bestDistance = distance;
+            best = &level;
         }
     }
 
-    return beatFeatures;
+    return best;
 }
 
-AudioStats AudioAnalyzer::calculateAudioStats(const std::vector<double>& channelData, double sampleRate) {
-    double maxAmplitude = 0.0;
-    double sumAmplitude = 0.0;
-    double sumSquares = 0.0;
+const WaveformLevel* AudioWaveform::findLevelAtMost(double samplesPerPixel) const {
+    const WaveformLevel* best = levels.empty() ? nullptr : &levels.front();
+
+    for (const WaveformLevel& level : levels) {
+        if (level.samplesPerPixel <= samplesPerPixel) {
+            best = &level;
+        }
+    }
+
+    return best;
+}
+
+AudioAnalyzer::AudioAnalyzer()
+    : workerPool(std::make_unique<ThreadPool>()), analysisCache(std::make_unique<AnalysisCache>()), spectrumFile(nullptr), cachedSampleRate(0.0), cachedDuration(0.0) {
+    memset(&spectrumInfo, 0, sizeof(spectrumInfo));
+}
 
-    const size_t chunkSize = 100000;
-    size_t totalChunks = (channelData.size() + chunkSize - 1) / chunkSize;
+AudioAnalyzer::~AudioAnalyzer() {
+    clearAudioCache();
+}
 
-    for (size_t chunk = 0; chunk < totalChunks; chunk++) {
-        size_t startIndex = chunk * chunkSize;
-        size_t endIndex = std::min(startIndex + chunkSize, channelData.size());
+void AudioAnalyzer::setProgressCallback(std::function<void(const AnalysisProgress&)> callback) {
+    progressCallback = callback;
+}
 
-        for (size_t i = startIndex; i < endIndex; i++) {
-            double amplitude = std::abs(channelData[i]);
-            maxAmplitude = std::max(maxAmplitude, amplitude);
-            sumAmplitude += amplitude;
-            sumSquares += channelData[i] * channelData[i];
+void AudioAnalyzer::updateProgress(double progress, const std::string& stage) {
+    if (progressCallback) {
+        try {
+            progressCallback({progress, stage});
+        } catch (const std::exception& e) {
+            std::cerr << "Progress callback error: " << e.what() << std::endl;
+        }
+    }
+}
+
+SNDFILE* AudioAnalyzer::openAudioFile(const AudioSource& source, SF_INFO& sfInfo, std::unique_ptr<AudioSectionReader>& section) {
+    memset(&sfInfo, 0, sizeof(sfInfo));
+    section.reset();
+
+    SNDFILE* file = nullptr;
+    if (!source.isSection()) {
+        file = sf_open(source.path.c_str(), SFM_READ, &sfInfo);
+    } else {
+        // Embedded audio is decoded in place instead of being copied out to a file
+        section = std::make_unique<AudioSectionReader>();
+        section->file = fopen(source.path.c_str(), "rb");
+        if (!section->file || fseek(section->file, 0, SEEK_END) != 0) {
+            section.reset();
+            throw std::runtime_error("Failed to open audio file: " + source.path);
         }
 
-        if (chunk % 5 == 0) {
-            double progress = 85.0 + (static_cast<double>(chunk) / totalChunks) * 5.0;
-            updateProgress(progress, "Calculating audio statistics... (" + std::to_string(chunk) + "/" + std::to_string(totalChunks) + " chunks)");
-            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        sf_count_t fileSize = static_cast<sf_count_t>(ftell(section->file));
+        sf_count_t offset = static_cast<sf_count_t>(source.offset);
+        sf_count_t length = source.length ? static_cast<sf_count_t>(source.length) : fileSize - offset;
+        if (offset < 0 || length <= 0 || offset + length > fileSize) {
+            section.reset();
+            throw std::runtime_error("Audio section lies outside of " + source.path);
         }
+
+        section->offset = offset;
+        section->length = length;
+        file = sf_open_virtual(&sectionIo, SFM_READ, &sfInfo, section.get());
     }
 
-    double averageAmplitude = sumAmplitude / channelData.size();
-    double rmsAmplitude = std::sqrt(sumSquares / channelData.size());
-    double silenceThreshold = averageAmplitude * 0.1;
+    if (!file) {
+        section.reset();
+        throw std::runtime_error("Failed to open audio file: " + std::string(sf_strerror(nullptr)));
+    }
 
-    // Detect loud sections
-    std::vector<LoudSection> loudSections;
-    double sectionDuration = 0.5; // 500ms sections
-    int samplesPerSection = static_cast<int>(sampleRate * sectionDuration);
-    double energyThreshold = rmsAmplitude * 2.0;
+    if (sfInfo.frames <= 0 || sfInfo.samplerate <= 0 || sfInfo.channels <= 0) {
+        sf_close(file);
+        section.reset();
+        throw std::runtime_error("Invalid audio file parameters");
+    }
 
-    for (size_t i = 0; i < channelData.size(); i += samplesPerSection) {
-        double sectionEnergy = 0.0;
-        size_t sectionEnd = std::min(i + samplesPerSection, channelData.size());
+    return file;
+}
 
-        for (size_t j = i; j < sectionEnd; j++) {
-            sectionEnergy += channelData[j] * channelData[j];
-        }
+sf_count_t AudioAnalyzer::readMonoBlock(SNDFILE* file, const SF_INFO& sfInfo, std::vector<float>& buffer, sf_count_t frames) {
+    size_t required = static_cast<size_t>(frames) * sfInfo.channels;
+    if (buffer.size() < required) {
+        buffer.resize(required);
+    }
 
-        double averageEnergy = std::sqrt(sectionEnergy / (sectionEnd - i));
+    sf_count_t framesRead = sf_readf_float(file, buffer.data(), frames);
+    if (framesRead <= 0 || sfInfo.channels == 1) {
+        return std::max<sf_count_t>(0, framesRead);
+    }
 
-        if (averageEnergy > energyThreshold) {
-            loudSections.push_back({
-                static_cast<double>(i) / sampleRate,
-                static_cast<double>(sectionEnd) / sampleRate,
-                averageEnergy
-            });
+    // Downmix in place: frame i is written at or before the position it is read from
+    const int channels = sfInfo.channels;
+    const float scale = 1.0f / channels;
+    for (sf_count_t i = 0; i < framesRead; i++) {
+        const float* frame = buffer.data() + i * channels;
+        float sum = 0.0f;
+        for (int c = 0; c < channels; c++) {
+            sum += frame[c];
         }
+        buffer[i] = sum * scale;
     }
 
-    return {
-        maxAmplitude,
-        averageAmplitude,
-        maxAmplitude - silenceThreshold,
-        silenceThreshold,
-        loudSections
-    };
+    return framesRead;
 }
 
-AudioWaveform AudioAnalyzer::analyzeAudio(const std::string& filename) {
+AudioWaveform AudioAnalyzer::analyzeAudio(const AudioSource& source) {
     try {
-        updateProgress(0, "Checking file size...");
+        updateProgress(0, "Opening audio file...");
 
-        // Check file size
-        std::ifstream file(filename, std::ios::binary | std::ios::ate);
-        if (!file.is_open()) {
-            throw std::runtime_error("Cannot open file: " + filename);
+        bool cacheable = true;
+        uint64_t cacheKey = 0;
+        try {
+            cacheKey = AnalysisCache::makeKey(AnalysisCache::hashFile(source.path, source.offset, source.length), VERSION);
+        } catch (const std::exception& e) {
+            std::cerr << "Analysis cache disabled for this file: " << e.what() << std::endl;
+            cacheable = false;
         }
 
-        size_t fileSize = file.tellg();
-        file.close();
-
-        if (fileSize > maxFileSize) {
-            throw std::runtime_error("File too large (" + std::to_string(fileSize / (1024 * 1024)) +
-                                   "MB). Maximum allowed: " + std::to_string(maxFileSize / (1024 * 1024)) + "MB");
+        AudioWaveform cachedWaveform;
+        if (cacheable && analysisCache->load(cacheKey, cachedWaveform)) {
+            updateProgress(100, "Analysis loaded from cache (" + std::to_string(cachedWaveform.data.size()) + " waveform points)");
+            return cachedWaveform;
         }
 
-        updateProgress(5, "File size OK (" + std::to_string(fileSize / (1024 * 1024)) + "MB)");
-        updateProgress(10, "Loading audio file...");
+        SF_INFO sfInfo;
+        std::unique_ptr<AudioSectionReader> section;
+        SNDFILE* file = openAudioFile(source, sfInfo, section);
 
-        double sampleRate, duration;
-        std::vector<double> channelData = loadAudioFile(filename, sampleRate, duration);
-        int totalSamples = static_cast<int>(channelData.size());
+        double sampleRate = sfInfo.samplerate;
+        int expectedSamples = static_cast<int>(std::min<sf_count_t>(sfInfo.frames, std::numeric_limits<int>::max()));
 
-        updateProgress(30, "Audio loaded (" + std::to_string(totalSamples / 1000) + "k samples, " +
-                      std::to_string(static_cast<int>(duration)) + "s duration)");
-        updateProgress(35, "Generating waveform levels...");
+        updateProgress(5, "Audio opened (" + std::to_string(expectedSamples / 1000) + "k samples, " +
+                      std::to_string(static_cast<int>(expectedSamples / sampleRate)) + "s duration)");
 
-    int maxSamplesPerPixel = std::min(100000, totalSamples / 1000);
-    std::vector<std::pair<std::string, int>> resolutions = {
-        {"overview", std::max(1, totalSamples / 1000)},
-        {"low", std::max(1, std::min(totalSamples / 5000, maxSamplesPerPixel / 5))},
-        {"medium", std::max(1, std::min(totalSamples / 20000, maxSamplesPerPixel / 20))},
-        {"high", std::max(1, std::min(totalSamples / 100000, maxSamplesPerPixel / 100))}
-    };
+        WaveformAccumulator waveform(std::max(1, expectedSamples / 100000), expectedSamples);
+        FrequencyAccumulator frequency(sampleRate);
+        BeatAccumulator beats(sampleRate);
+        StatsAccumulator stats(sampleRate);
+        SpectrogramAccumulator spectrogram(sampleRate);
 
-        std::map<std::string, WaveformLevel> waveformLevels;
+        std::vector<AnalysisStage*> stages = {&waveform, &frequency, &beats, &stats, &spectrogram};
 
-        for (size_t i = 0; i < resolutions.size(); i++) {
-            double progress = 35.0 + (static_cast<double>(i) / resolutions.size()) * 20.0;
-            updateProgress(progress, "Generating " + resolutions[i].first + " waveform level (" + std::to_string(i + 1) + "/" + std::to_string(resolutions.size()) + ")...");
+        std::vector<float> blocks[2];
+        size_t currentBlock = 0;
+        sf_count_t totalRead = 0;
 
-            waveformLevels[resolutions[i].first] = generateWaveformLevel(channelData, resolutions[i].second);
-            std::this_thread::sleep_for(std::chrono::milliseconds(10));
-        }
+        try {
+            sf_count_t framesRead = readMonoBlock(file, sfInfo, blocks[currentBlock], STREAM_BLOCK_FRAMES);
+
+            while (framesRead > 0) {
+                const float* samples = blocks[currentBlock].data();
+                size_t count = static_cast<size_t>(framesRead);
+
+                TaskGroup group(*workerPool);
+                for (AnalysisStage* stage : stages) {
+                    size_t chunks = stage->prepare(samples, count);
+                    for (size_t chunk = 0; chunk < chunks; chunk++) {
+                        group.run([stage, chunk]() { stage->processChunk(chunk); });
+                    }
+                }
 
-        updateProgress(55, "Analyzing frequency content...");
-        std::vector<double> frequencyData = analyzeFrequencyContent(channelData, sampleRate);
+                // Decode the next block while the workers reduce this one
+                sf_count_t nextRead = readMonoBlock(file, sfInfo, blocks[currentBlock ^ 1], STREAM_BLOCK_FRAMES);
+                group.wait();
 
-        updateProgress(70, "Detecting beats and rhythm...");
-        BeatFeatures beatFeatures = analyzeBeatFeatures(channelData, sampleRate);
+                for (AnalysisStage* stage : stages) {
+                    stage->commit();
+                }
+
+                totalRead += framesRead;
+                double progress = 5.0 + std::min(1.0, static_cast<double>(totalRead) / sfInfo.frames) * 90.0;
+                updateProgress(progress, "Analyzing audio... (" + std::to_string(static_cast<int>(totalRead / sampleRate)) +
+                               "/" + std::to_string(static_cast<int>(sfInfo.frames / sampleRate)) + "s)");
+
+                currentBlock ^= 1;
+                framesRead = nextRead;
+            }
+        } catch (...) {
+            sf_close(file);
+            throw;
+        }
+        sf_close(file);
 
-        updateProgress(85, "Calculating audio statistics...");
-        AudioStats audioStats = calculateAudioStats(channelData, sampleRate);
+        if (totalRead == 0) {
+            throw std::runtime_error("Failed to read audio data");
+        }
 
         updateProgress(95, "Finalizing analysis...");
 
+        int totalSamples = static_cast<int>(std::min<sf_count_t>(totalRead, std::numeric_limits<int>::max()));
+        double duration = static_cast<double>(totalRead) / sampleRate;
+
         AudioWaveform waveformData = {
-            waveformLevels["medium"].peaks, // Default to medium resolution peaks
-            waveformLevels,
-            frequencyData,
-            beatFeatures,
-            audioStats,
+            {},
+            waveform.finish(),
+            frequency.finish(),
+            beats.finish(),
+            stats.finish(),
             sampleRate,
             duration,
             totalSamples,
-            sampleRate
+            sampleRate,
+            spectrogram.finish()
         };
 
+        // Default to a medium resolution of roughly 20k points
+        const WaveformLevel* defaultLevel = waveformData.findLevel(totalSamples / 20000.0);
+        if (defaultLevel) {
+            waveformData.data = defaultLevel->peaks;
+        }
+
+        if (cacheable) {
+            analysisCache->store(cacheKey, waveformData);
+        }
+
         updateProgress(100, "Analysis complete! (" + std::to_string(waveformData.data.size()) + " waveform points)");
         return waveformData;
 
@@ -505,14 +986,18 @@ AudioWaveform AudioAnalyzer::analyzeAudio(const std::string& filename) {
     }
 }
 
-void AudioAnalyzer::cacheAudioForSpectrum(const std::string& filename) {
-    if (cachedAudioFile == filename && !cachedAudioData.empty()) {
+void AudioAnalyzer::cacheAudioForSpectrum(const AudioSource& source) {
+    if (cachedAudioSource == source && spectrumFile) {
         return;
     }
 
+    clearAudioCache();
+
     try {
-        cachedAudioData = loadAudioFile(filename, cachedSampleRate, cachedDuration);
-        cachedAudioFile = filename;
+        spectrumFile = openAudioFile(source, spectrumInfo, spectrumSection);
+        cachedSampleRate = spectrumInfo.samplerate;
+        cachedDuration = static_cast<double>(spectrumInfo.frames) / cachedSampleRate;
+        cachedAudioSource = source;
     } catch (const std::exception& e) {
         std::cerr << "Error caching audio for spectrum: " << e.what() << std::endl;
         clearAudioCache();
@@ -520,88 +1005,63 @@ void AudioAnalyzer::cacheAudioForSpectrum(const std::string& filename) {
 }
 
 void AudioAnalyzer::clearAudioCache() {
-    cachedAudioFile.clear();
-    cachedAudioData.clear();
+    if (spectrumFile) {
+        sf_close(spectrumFile);
+        spectrumFile = nullptr;
+    }
+    spectrumSection.reset();
+    memset(&spectrumInfo, 0, sizeof(spectrumInfo));
+    cachedAudioSource = AudioSource();
+    spectrumBuffer.clear();
+    spectrumStream.reset(-1);
     cachedSampleRate = 0.0;
     cachedDuration = 0.0;
 }
 
-std::vector<float> AudioAnalyzer::getSpectrumAtTime(const std::string& filename, double time, int spectrumSize) {
-    std::vector<float> spectrum(spectrumSize, 0.0f);
-
+void AudioAnalyzer::getSpectrumAtTime(const AudioSource& source, double time, std::vector<float>& spectrum) {
     try {
-        if (cachedAudioFile != filename || cachedAudioData.empty()) {
-            cacheAudioForSpectrum(filename);
+        if (cachedAudioSource != source || !spectrumFile) {
+            cacheAudioForSpectrum(source);
         }
 
-        if (cachedAudioData.empty()) {
-            return spectrum;
+        if (!spectrumFile || time < 0.0) {
+            std::fill(spectrum.begin(), spectrum.end(), 0.0f);
+            return;
         }
 
-        size_t sampleIndex = static_cast<size_t>(time * cachedSampleRate);
-        if (sampleIndex >= cachedAudioData.size()) {
-            return spectrum;
+        if (spectrumStream.getBandCount() != spectrum.size() || spectrumStream.getSampleRate() != cachedSampleRate) {
+            spectrumStream.configure(cachedSampleRate, spectrum.size());
+            spectrumStream.reset(-1);
         }
 
-        int windowSize = 1024;
-        size_t startIndex = sampleIndex;
-        size_t endIndex = std::min(startIndex + windowSize, cachedAudioData.size());
-
-        std::vector<double> window;
-        for (size_t i = startIndex; i < endIndex; i++) {
-            window.push_back(cachedAudioData[i]);
-        }
-
-        while (window.size() < static_cast<size_t>(windowSize)) {
-            window.push_back(0.0);
-        }
-
-        for (int i = 0; i < windowSize; i++) {
-            double windowValue = 0.5 * (1.0 - std::cos(2.0 * M_PI * i / (windowSize - 1)));
-            window[i] *= windowValue;
-        }
-
-        std::vector<float> magnitudes(spectrumSize);
-
-        for (int bin = 0; bin < spectrumSize; bin++) {
-            double real = 0.0, imag = 0.0;
-
-            for (int n = 0; n < windowSize; n++) {
-                double angle = -2.0 * M_PI * bin * n / windowSize;
-                real += window[n] * std::cos(angle);
-                imag += window[n] * std::sin(angle);
+        sf_count_t target = std::min(static_cast<sf_count_t>(time * cachedSampleRate), spectrumInfo.frames);
+        sf_count_t position = spectrumStream.getPosition();
+
+        // Playback moving forward only decodes the new samples; seeks, long jumps and a fresh
+        // stream (negative position) refill one window
+        if (position < 0 || target < position || target - position > static_cast<sf_count_t>(SpectrumStream::RING_SIZE)) {
+            position = std::max<sf_count_t>(0, target - static_cast<sf_count_t>(SpectrumStream::WINDOW_SIZE));
+            if (sf_seek(spectrumFile, position, SF_SEEK_SET) < 0) {
+                std::fill(spectrum.begin(), spectrum.end(), 0.0f);
+                spectrumStream.reset(-1);
+                return;
             }
-
-            double magnitude = std::sqrt(real * real + imag * imag);
-            magnitudes[bin] = static_cast<float>(magnitude);
+            spectrumStream.reset(position);
         }
 
-        float maxMagnitude = 0.0f;
-        for (float mag : magnitudes) {
-            maxMagnitude = std::max(maxMagnitude, mag);
-        }
-
-        if (maxMagnitude > 0.0f) {
-            for (int i = 0; i < spectrumSize; i++) {
-                float frequencyWeight = 1.0f;
-                float normalizedFreq = static_cast<float>(i) / spectrumSize;
-
-                if (normalizedFreq < 0.1f) {
-                    frequencyWeight = 2.0f;
-                } else if (normalizedFreq < 0.3f) {
-                    frequencyWeight = 1.5f;
-                } else if (normalizedFreq > 0.7f) {
-                    frequencyWeight = 0.5f;
-                }
-
-                spectrum[i] = (magnitudes[i] / maxMagnitude) * frequencyWeight;
-                spectrum[i] = std::min(1.0f, spectrum[i]);
+        while (position < target) {
+            sf_count_t wanted = std::min<sf_count_t>(target - position, SpectrumStream::WINDOW_SIZE);
+            sf_count_t framesRead = readMonoBlock(spectrumFile, spectrumInfo, spectrumBuffer, wanted);
+            if (framesRead <= 0) {
+                break;
             }
+            spectrumStream.push(spectrumBuffer.data(), static_cast<size_t>(framesRead));
+            position += framesRead;
         }
 
+        spectrumStream.compute(spectrum.data());
+
     } catch (const std::exception& e) {
         std::cerr << "Error getting spectrum: " << e.what() << std::endl;
     }
-
-    return spectrum;
 }
@@ -0,0 +1,82 @@
+#include "AudioClock.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// Share of the measured error folded back in per update, about 10 frames to settle
+const double DRIFT_CORRECTION = 0.1;
+// Errors past this are a seek or a stall, not drift
+const double RESYNC_THRESHOLD = 0.1;
+
+} // namespace
+
+AudioClock::AudioClock()
+    : running(false),
+      anchorPosition(0.0),
+      anchorTime(Clock::now()),
+      rate(1.0),
+      lastReported(0.0),
+      latency(0.0) {
+}
+
+double AudioClock::extrapolate(Clock::time_point now) const {
+    if (!running) {
+        return anchorPosition;
+    }
+    double elapsed = std::chrono::duration<double>(now - anchorTime).count();
+    return anchorPosition + elapsed * rate;
+}
+
+double AudioClock::update(double devicePosition, bool playing, double playbackRate, Clock::time_point now) {
+    if (!playing) {
+        // Nothing is being mixed, the device position is exact
+        running = false;
+        anchorPosition = devicePosition;
+        anchorTime = now;
+        lastReported = devicePosition;
+        return devicePosition;
+    }
+
+    double predicted = extrapolate(now);
+    double error = devicePosition - predicted;
+
+    if (!running || playbackRate != rate || std::abs(error) > RESYNC_THRESHOLD) {
+        anchorPosition = devicePosition;
+        lastReported = std::max(0.0, devicePosition - latency * playbackRate);
+        running = true;
+    } else {
+        anchorPosition = predicted + error * DRIFT_CORRECTION;
+    }
+    anchorTime = now;
+    rate = playbackRate;
+
+    lastReported = getTime(now);
+    return lastReported;
+}
+
+double AudioClock::getTime(Clock::time_point now) const {
+    if (!running) {
+        return anchorPosition;
+    }
+
+    double heard = std::max(0.0, extrapolate(now) - latency * rate);
+    // Corrections only ever slow the clock down, never step it back
+    return std::max(heard, lastReported);
+}
+
+double AudioClock::getTimeAt(Clock::time_point when) const {
+    if (!running) {
+        return anchorPosition;
+    }
+    // No monotonic clamp here, events from before the last update map to earlier times
+    return std::max(0.0, extrapolate(when) - latency * rate);
+}
+
+void AudioClock::reset(double position) {
+    running = false;
+    anchorPosition = position;
+    anchorTime = Clock::now();
+    rate = 1.0;
+    lastReported = position;
+}
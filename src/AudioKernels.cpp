@@ -0,0 +1,926 @@
+#include "AudioKernels.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define AUDIO_KERNELS_X86
+#include <immintrin.h>
+#define TARGET_SSE2 __attribute__((target("sse2")))
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#elif defined(__ARM_NEON) || defined(__aarch64__)
+#define AUDIO_KERNELS_NEON
+#include <arm_neon.h>
+#endif
+
+namespace {
+
+// Scalar reference implementations, also used for the tails of the vector loops
+
+template <typename T>
+T scalarAbsMax(const T* data, size_t count) {
+    T maximum = 0;
+    for (size_t i = 0; i < count; i++) {
+        maximum = std::max(maximum, std::abs(data[i]));
+    }
+    return maximum;
+}
+
+template <typename T>
+double scalarAbsSum(const T* data, size_t count) {
+    double sum = 0.0;
+    for (size_t i = 0; i < count; i++) {
+        sum += std::abs(data[i]);
+    }
+    return sum;
+}
+
+template <typename T>
+double scalarSumSquares(const T* data, size_t count) {
+    double sum = 0.0;
+    for (size_t i = 0; i < count; i++) {
+        sum += static_cast<double>(data[i]) * data[i];
+    }
+    return sum;
+}
+
+// Pair kernels start at index `first` (>= 1) so vector loops can hand over their tail
+template <typename T>
+double scalarDifferenceEnergy(const T* data, size_t first, size_t count) {
+    double sum = 0.0;
+    for (size_t i = std::max<size_t>(first, 1); i < count; i++) {
+        double difference = static_cast<double>(data[i]) - data[i - 1];
+        sum += difference * difference;
+    }
+    return sum;
+}
+
+template <typename T>
+size_t scalarZeroCrossings(const T* data, size_t first, size_t count) {
+    size_t crossings = 0;
+    for (size_t i = std::max<size_t>(first, 1); i < count; i++) {
+        crossings += (data[i - 1] >= 0) != (data[i] >= 0);
+    }
+    return crossings;
+}
+
+void scalarMinMax(const float* data, size_t first, size_t count, float& minimum, float& maximum) {
+    for (size_t i = first; i < count; i++) {
+        minimum = std::min(minimum, data[i]);
+        maximum = std::max(maximum, data[i]);
+    }
+}
+
+double scalarDifferenceAbsSum(const float* data, size_t first, size_t count) {
+    double sum = 0.0;
+    for (size_t i = std::max<size_t>(first, 1); i < count; i++) {
+        sum += std::abs(data[i] - data[i - 1]);
+    }
+    return sum;
+}
+
+double scalarCrossingDifferenceSum(const float* data, size_t first, size_t count) {
+    double sum = 0.0;
+    for (size_t i = std::max<size_t>(first, 1); i < count; i++) {
+        if ((data[i - 1] >= 0) != (data[i] >= 0)) {
+            sum += std::abs(data[i] - data[i - 1]);
+        }
+    }
+    return sum;
+}
+
+// Float lanes are flushed into a double sum every block, so rounding error stays
+// bounded by the block length rather than growing with the track
+const size_t FLOAT_BLOCK = 1024;
+
+template <typename T, size_t N>
+double horizontalSum(const T (&lanes)[N]) {
+    double sum = 0.0;
+    for (size_t i = 0; i < N; i++) {
+        sum += lanes[i];
+    }
+    return sum;
+}
+
+template <typename T, size_t N>
+T horizontalMax(const T (&lanes)[N]) {
+    T maximum = lanes[0];
+    for (size_t i = 1; i < N; i++) {
+        maximum = std::max(maximum, lanes[i]);
+    }
+    return maximum;
+}
+
+template <typename T, size_t N>
+T horizontalMin(const T (&lanes)[N]) {
+    T minimum = lanes[0];
+    for (size_t i = 1; i < N; i++) {
+        minimum = std::min(minimum, lanes[i]);
+    }
+    return minimum;
+}
+
+struct KernelTable {
+    AudioKernels::Isa isa;
+    float (*absMaxFloat)(const float*, size_t);
+    double (*absMaxDouble)(const double*, size_t);
+    double (*absSumFloat)(const float*, size_t);
+    double (*absSumDouble)(const double*, size_t);
+    double (*sumSquaresFloat)(const float*, size_t);
+    double (*sumSquaresDouble)(const double*, size_t);
+    double (*differenceEnergyFloat)(const float*, size_t);
+    double (*differenceEnergyDouble)(const double*, size_t);
+    size_t (*zeroCrossingsFloat)(const float*, size_t);
+    size_t (*zeroCrossingsDouble)(const double*, size_t);
+    void (*minMax)(const float*, size_t, float&, float&);
+    double (*differenceAbsSum)(const float*, size_t);
+    double (*crossingDifferenceSum)(const float*, size_t);
+};
+
+const KernelTable scalarTable = {
+    AudioKernels::Isa::SCALAR,
+    scalarAbsMax<float>,
+    scalarAbsMax<double>,
+    scalarAbsSum<float>,
+    scalarAbsSum<double>,
+    scalarSumSquares<float>,
+    scalarSumSquares<double>,
+    [](const float* data, size_t count) { return scalarDifferenceEnergy(data, 1, count); },
+    [](const double* data, size_t count) { return scalarDifferenceEnergy(data, 1, count); },
+    [](const float* data, size_t count) { return scalarZeroCrossings(data, 1, count); },
+    [](const double* data, size_t count) { return scalarZeroCrossings(data, 1, count); },
+    [](const float* data, size_t count, float& minimum, float& maximum) {
+        minimum = data[0];
+        maximum = data[0];
+        scalarMinMax(data, 1, count, minimum, maximum);
+    },
+    [](const float* data, size_t count) { return scalarDifferenceAbsSum(data, 1, count); },
+    [](const float* data, size_t count) { return scalarCrossingDifferenceSum(data, 1, count); }
+};
+
+#ifdef AUDIO_KERNELS_X86
+
+// SSE2: 4 float or 2 double lanes
+
+TARGET_SSE2 float sse2AbsMaxFloat(const float* data, size_t count) {
+    const __m128 mask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+    __m128 maximum = _mm_setzero_ps();
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        maximum = _mm_max_ps(maximum, _mm_and_ps(_mm_loadu_ps(data + i), mask));
+    }
+    float lanes[4];
+    _mm_storeu_ps(lanes, maximum);
+    return std::max(horizontalMax(lanes), scalarAbsMax(data + i, count - i));
+}
+
+TARGET_SSE2 double sse2AbsMaxDouble(const double* data, size_t count) {
+    const __m128d mask = _mm_castsi128_pd(_mm_set1_epi64x(0x7fffffffffffffffLL));
+    __m128d maximum = _mm_setzero_pd();
+    size_t i = 0;
+    for (; i + 2 <= count; i += 2) {
+        maximum = _mm_max_pd(maximum, _mm_and_pd(_mm_loadu_pd(data + i), mask));
+    }
+    double lanes[2];
+    _mm_storeu_pd(lanes, maximum);
+    return std::max(horizontalMax(lanes), scalarAbsMax(data + i, count - i));
+}
+
+TARGET_SSE2 double sse2AbsSumFloat(const float* data, size_t count) {
+    const __m128 mask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+    double total = 0.0;
+    size_t i = 0;
+    while (i + 4 <= count) {
+        size_t blockEnd = std::min(count, i + FLOAT_BLOCK);
+        __m128 sum = _mm_setzero_ps();
+        for (; i + 4 <= blockEnd; i += 4) {
+            sum = _mm_add_ps(sum, _mm_and_ps(_mm_loadu_ps(data + i), mask));
+        }
+        float lanes[4];
+        _mm_storeu_ps(lanes, sum);
+        total += horizontalSum(lanes);
+    }
+    return total + scalarAbsSum(data + i, count - i);
+}
+
+TARGET_SSE2 double sse2AbsSumDouble(const double* data, size_t count) {
+    const __m128d mask = _mm_castsi128_pd(_mm_set1_epi64x(0x7fffffffffffffffLL));
+    __m128d sum = _mm_setzero_pd();
+    size_t i = 0;
+    for (; i + 2 <= count; i += 2) {
+        sum = _mm_add_pd(sum, _mm_and_pd(_mm_loadu_pd(data + i), mask));
+    }
+    double lanes[2];
+    _mm_storeu_pd(lanes, sum);
+    return horizontalSum(lanes) + scalarAbsSum(data + i, count - i);
+}
+
+TARGET_SSE2 double sse2SumSquaresFloat(const float* data, size_t count) {
+    double total = 0.0;
+    size_t i = 0;
+    while (i + 4 <= count) {
+        size_t blockEnd = std::min(count, i + FLOAT_BLOCK);
+        __m128 sum = _mm_setzero_ps();
+        for (; i + 4 <= blockEnd; i += 4) {
+            __m128 x = _mm_loadu_ps(data + i);
+            sum = _mm_add_ps(sum, _mm_mul_ps(x, x));
+        }
+        float lanes[4];
+        _mm_storeu_ps(lanes, sum);
+        total += horizontalSum(lanes);
+    }
+    return total + scalarSumSquares(data + i, count - i);
+}
+
+TARGET_SSE2 double sse2SumSquaresDouble(const double* data, size_t count) {
+    __m128d sum = _mm_setzero_pd();
+    size_t i = 0;
+    for (; i + 2 <= count; i += 2) {
+        __m128d x = _mm_loadu_pd(data + i);
+        sum = _mm_add_pd(sum, _mm_mul_pd(x, x));
+    }
+    double lanes[2];
+    _mm_storeu_pd(lanes, sum);
+    return horizontalSum(lanes) + scalarSumSquares(data + i, count - i);
+}
+
+TARGET_SSE2 double sse2DifferenceEnergyFloat(const float* data, size_t count) {
+    double total = 0.0;
+    size_t i = 1;
+    while (i + 4 <= count) {
+        size_t blockEnd = std::min(count, i + FLOAT_BLOCK);
+        __m128 sum = _mm_setzero_ps();
+        for (; i + 4 <= blockEnd; i += 4) {
+            __m128 difference = _mm_sub_ps(_mm_loadu_ps(data + i), _mm_loadu_ps(data + i - 1));
+            sum = _mm_add_ps(sum, _mm_mul_ps(difference, difference));
+        }
+        float lanes[4];
+        _mm_storeu_ps(lanes, sum);
+        total += horizontalSum(lanes);
+    }
+    return total + scalarDifferenceEnergy(data, i, count);
+}
+
+TARGET_SSE2 double sse2DifferenceEnergyDouble(const double* data, size_t count) {
+    __m128d sum = _mm_setzero_pd();
+    size_t i = 1;
+    for (; i + 2 <= count; i += 2) {
+        __m128d difference = _mm_sub_pd(_mm_loadu_pd(data + i), _mm_loadu_pd(data + i - 1));
+        sum = _mm_add_pd(sum, _mm_mul_pd(difference, difference));
+    }
+    double lanes[2];
+    _mm_storeu_pd(lanes, sum);
+    return horizontalSum(lanes) + scalarDifferenceEnergy(data, i, count);
+}
+
+TARGET_SSE2 size_t sse2ZeroCrossingsFloat(const float* data, size_t count) {
+    const __m128 zero = _mm_setzero_ps();
+    size_t crossings = 0;
+    size_t i = 1;
+    for (; i + 4 <= count; i += 4) {
+        __m128 current = _mm_cmpge_ps(_mm_loadu_ps(data + i), zero);
+        __m128 previous = _mm_cmpge_ps(_mm_loadu_ps(data + i - 1), zero);
+        crossings += __builtin_popcount(_mm_movemask_ps(_mm_xor_ps(current, previous)));
+    }
+    return crossings + scalarZeroCrossings(data, i, count);
+}
+
+TARGET_SSE2 size_t sse2ZeroCrossingsDouble(const double* data, size_t count) {
+    const __m128d zero = _mm_setzero_pd();
+    size_t crossings = 0;
+    size_t i = 1;
+    for (; i + 2 <= count; i += 2) {
+        __m128d current = _mm_cmpge_pd(_mm_loadu_pd(data + i), zero);
+        __m128d previous = _mm_cmpge_pd(_mm_loadu_pd(data + i - 1), zero);
+        crossings += __builtin_popcount(_mm_movemask_pd(_mm_xor_pd(current, previous)));
+    }
+    return crossings + scalarZeroCrossings(data, i, count);
+}
+
+TARGET_SSE2 void sse2MinMax(const float* data, size_t count, float& minimum, float& maximum) {
+    __m128 low = _mm_set1_ps(data[0]);
+    __m128 high = low;
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128 x = _mm_loadu_ps(data + i);
+        low = _mm_min_ps(low, x);
+        high = _mm_max_ps(high, x);
+    }
+    float lowLanes[4];
+    float highLanes[4];
+    _mm_storeu_ps(lowLanes, low);
+    _mm_storeu_ps(highLanes, high);
+    minimum = horizontalMin(lowLanes);
+    maximum = horizontalMax(highLanes);
+    scalarMinMax(data, i, count, minimum, maximum);
+}
+
+TARGET_SSE2 double sse2DifferenceAbsSum(const float* data, size_t count) {
+    const __m128 mask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+    double total = 0.0;
+    size_t i = 1;
+    while (i + 4 <= count) {
+        size_t blockEnd = std::min(count, i + FLOAT_BLOCK);
+        __m128 sum = _mm_setzero_ps();
+        for (; i + 4 <= blockEnd; i += 4) {
+            __m128 difference = _mm_sub_ps(_mm_loadu_ps(data + i), _mm_loadu_ps(data + i - 1));
+            sum = _mm_add_ps(sum, _mm_and_ps(difference, mask));
+        }
+        float lanes[4];
+        _mm_storeu_ps(lanes, sum);
+        total += horizontalSum(lanes);
+    }
+    return total + scalarDifferenceAbsSum(data, i, count);
+}
+
+TARGET_SSE2 double sse2CrossingDifferenceSum(const float* data, size_t count) {
+    const __m128 mask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+    const __m128 zero = _mm_setzero_ps();
+    double total = 0.0;
+    size_t i = 1;
+    while (i + 4 <= count) {
+        size_t blockEnd = std::min(count, i + FLOAT_BLOCK);
+        __m128 sum = _mm_setzero_ps();
+        for (; i + 4 <= blockEnd; i += 4) {
+            __m128 current = _mm_loadu_ps(data + i);
+            __m128 previous = _mm_loadu_ps(data + i - 1);
+            __m128 crossing = _mm_xor_ps(_mm_cmpge_ps(current, zero), _mm_cmpge_ps(previous, zero));
+            __m128 difference = _mm_and_ps(_mm_sub_ps(current, previous), mask);
+            sum = _mm_add_ps(sum, _mm_and_ps(difference, crossing));
+        }
+        float lanes[4];
+        _mm_storeu_ps(lanes, sum);
+        total += horizontalSum(lanes);
+    }
+    return total + scalarCrossingDifferenceSum(data, i, count);
+}
+
+// AVX2: 8 float or 4 double lanes
+
+TARGET_AVX2 float avx2AbsMaxFloat(const float* data, size_t count) {
+    const __m256 mask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7fffffff));
+    __m256 maximum = _mm256_setzero_ps();
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        maximum = _mm256_max_ps(maximum, _mm256_and_ps(_mm256_loadu_ps(data + i), mask));
+    }
+    float lanes[8];
+    _mm256_storeu_ps(lanes, maximum);
+    return std::max(horizontalMax(lanes), scalarAbsMax(data + i, count - i));
+}
+
+TARGET_AVX2 double avx2AbsMaxDouble(const double* data, size_t count) {
+    const __m256d mask = _mm256_castsi256_pd(_mm256_set1_epi64x(0x7fffffffffffffffLL));
+    __m256d maximum = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        maximum = _mm256_max_pd(maximum, _mm256_and_pd(_mm256_loadu_pd(data + i), mask));
+    }
+    double lanes[4];
+    _mm256_storeu_pd(lanes, maximum);
+    return std::max(horizontalMax(lanes), scalarAbsMax(data + i, count - i));
+}
+
+TARGET_AVX2 double avx2AbsSumFloat(const float* data, size_t count) {
+    const __m256 mask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7fffffff));
+    double total = 0.0;
+    size_t i = 0;
+    while (i + 8 <= count) {
+        size_t blockEnd = std::min(count, i + FLOAT_BLOCK);
+        __m256 sum = _mm256_setzero_ps();
+        for (; i + 8 <= blockEnd; i += 8) {
+            sum = _mm256_add_ps(sum, _mm256_and_ps(_mm256_loadu_ps(data + i), mask));
+        }
+        float lanes[8];
+        _mm256_storeu_ps(lanes, sum);
+        total += horizontalSum(lanes);
+    }
+    return total + scalarAbsSum(data + i, count - i);
+}
+
+TARGET_AVX2 double avx2AbsSumDouble(const double* data, size_t count) {
+    const __m256d mask = _mm256_castsi256_pd(_mm256_set1_epi64x(0x7fffffffffffffffLL));
+    __m256d sum = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        sum = _mm256_add_pd(sum, _mm256_and_pd(_mm256_loadu_pd(data + i), mask));
+    }
+    double lanes[4];
+    _mm256_storeu_pd(lanes, sum);
+    return horizontalSum(lanes) + scalarAbsSum(data + i, count - i);
+}
+
+TARGET_AVX2 double avx2SumSquaresFloat(const float* data, size_t count) {
+    double total = 0.0;
+    size_t i = 0;
+    while (i + 8 <= count) {
+        size_t blockEnd = std::min(count, i + FLOAT_BLOCK);
+        __m256 sum = _mm256_setzero_ps();
+        for (; i + 8 <= blockEnd; i += 8) {
+            __m256 x = _mm256_loadu_ps(data + i);
+            sum = _mm256_add_ps(sum, _mm256_mul_ps(x, x));
+        }
+        float lanes[8];
+        _mm256_storeu_ps(lanes, sum);
+        total += horizontalSum(lanes);
+    }
+    return total + scalarSumSquares(data + i, count - i);
+}
+
+TARGET_AVX2 double avx2SumSquaresDouble(const double* data, size_t count) {
+    __m256d sum = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m256d x = _mm256_loadu_pd(data + i);
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(x, x));
+    }
+    double lanes[4];
+    _mm256_storeu_pd(lanes, sum);
+    return horizontalSum(lanes) + scalarSumSquares(data + i, count - i);
+}
+
+TARGET_AVX2 double avx2DifferenceEnergyFloat(const float* data, size_t count) {
+    double total = 0.0;
+    size_t i = 1;
+    while (i + 8 <= count) {
+        size_t blockEnd = std::min(count, i + FLOAT_BLOCK);
+        __m256 sum = _mm256_setzero_ps();
+        for (; i + 8 <= blockEnd; i += 8) {
+            __m256 difference = _mm256_sub_ps(_mm256_loadu_ps(data + i), _mm256_loadu_ps(data + i - 1));
+            sum = _mm256_add_ps(sum, _mm256_mul_ps(difference, difference));
+        }
+        float lanes[8];
+        _mm256_storeu_ps(lanes, sum);
+        total += horizontalSum(lanes);
+    }
+    return total + scalarDifferenceEnergy(data, i, count);
+}
+
+TARGET_AVX2 double avx2DifferenceEnergyDouble(const double* data, size_t count) {
+    __m256d sum = _mm256_setzero_pd();
+    size_t i = 1;
+    for (; i + 4 <= count; i += 4) {
+        __m256d difference = _mm256_sub_pd(_mm256_loadu_pd(data + i), _mm256_loadu_pd(data + i - 1));
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(difference, difference));
+    }
+    double lanes[4];
+    _mm256_storeu_pd(lanes, sum);
+    return horizontalSum(lanes) + scalarDifferenceEnergy(data, i, count);
+}
+
+TARGET_AVX2 size_t avx2ZeroCrossingsFloat(const float* data, size_t count) {
+    const __m256 zero = _mm256_setzero_ps();
+    size_t crossings = 0;
+    size_t i = 1;
+    for (; i + 8 <= count; i += 8) {
+        __m256 current = _mm256_cmp_ps(_mm256_loadu_ps(data + i), zero, _CMP_GE_OQ);
+        __m256 previous = _mm256_cmp_ps(_mm256_loadu_ps(data + i - 1), zero, _CMP_GE_OQ);
+        crossings += __builtin_popcount(_mm256_movemask_ps(_mm256_xor_ps(current, previous)));
+    }
+    return crossings + scalarZeroCrossings(data, i, count);
+}
+
+TARGET_AVX2 size_t avx2ZeroCrossingsDouble(const double* data, size_t count) {
+    const __m256d zero = _mm256_setzero_pd();
+    size_t crossings = 0;
+    size_t i = 1;
+    for (; i + 4 <= count; i += 4) {
+        __m256d current = _mm256_cmp_pd(_mm256_loadu_pd(data + i), zero, _CMP_GE_OQ);
+        __m256d previous = _mm256_cmp_pd(_mm256_loadu_pd(data + i - 1), zero, _CMP_GE_OQ);
+        crossings += __builtin_popcount(_mm256_movemask_pd(_mm256_xor_pd(current, previous)));
+    }
+    return crossings + scalarZeroCrossings(data, i, count);
+}
+
+TARGET_AVX2 void avx2MinMax(const float* data, size_t count, float& minimum, float& maximum) {
+    __m256 low = _mm256_set1_ps(data[0]);
+    __m256 high = low;
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256 x = _mm256_loadu_ps(data + i);
+        low = _mm256_min_ps(low, x);
+        high = _mm256_max_ps(high, x);
+    }
+    float lowLanes[8];
+    float highLanes[8];
+    _mm256_storeu_ps(lowLanes, low);
+    _mm256_storeu_ps(highLanes, high);
+    minimum = horizontalMin(lowLanes);
+    maximum = horizontalMax(highLanes);
+    scalarMinMax(data, i, count, minimum, maximum);
+}
+
+TARGET_AVX2 double avx2DifferenceAbsSum(const float* data, size_t count) {
+    const __m256 mask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7fffffff));
+    double total = 0.0;
+    size_t i = 1;
+    while (i + 8 <= count) {
+        size_t blockEnd = std::min(count, i + FLOAT_BLOCK);
+        __m256 sum = _mm256_setzero_ps();
+        for (; i + 8 <= blockEnd; i += 8) {
+            __m256 difference = _mm256_sub_ps(_mm256_loadu_ps(data + i), _mm256_loadu_ps(data + i - 1));
+            sum = _mm256_add_ps(sum, _mm256_and_ps(difference, mask));
+        }
+        float lanes[8];
+        _mm256_storeu_ps(lanes, sum);
+        total += horizontalSum(lanes);
+    }
+    return total + scalarDifferenceAbsSum(data, i, count);
+}
+
+TARGET_AVX2 double avx2CrossingDifferenceSum(const float* data, size_t count) {
+    const __m256 mask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7fffffff));
+    const __m256 zero = _mm256_setzero_ps();
+    double total = 0.0;
+    size_t i = 1;
+    while (i + 8 <= count) {
+        size_t blockEnd = std::min(count, i + FLOAT_BLOCK);
+        __m256 sum = _mm256_setzero_ps();
+        for (; i + 8 <= blockEnd; i += 8) {
+            __m256 current = _mm256_loadu_ps(data + i);
+            __m256 previous = _mm256_loadu_ps(data + i - 1);
+            __m256 crossing = _mm256_xor_ps(_mm256_cmp_ps(current, zero, _CMP_GE_OQ), _mm256_cmp_ps(previous, zero, _CMP_GE_OQ));
+            __m256 difference = _mm256_and_ps(_mm256_sub_ps(current, previous), mask);
+            sum = _mm256_add_ps(sum, _mm256_and_ps(difference, crossing));
+        }
+        float lanes[8];
+        _mm256_storeu_ps(lanes, sum);
+        total += horizontalSum(lanes);
+    }
+    return total + scalarCrossingDifferenceSum(data, i, count);
+}
+
+const KernelTable sse2Table = {
+    AudioKernels::Isa::SSE2,
+    sse2AbsMaxFloat,
+    sse2AbsMaxDouble,
+    sse2AbsSumFloat,
+    sse2AbsSumDouble,
+    sse2SumSquaresFloat,
+    sse2SumSquaresDouble,
+    sse2DifferenceEnergyFloat,
+    sse2DifferenceEnergyDouble,
+    sse2ZeroCrossingsFloat,
+    sse2ZeroCrossingsDouble,
+    sse2MinMax,
+    sse2DifferenceAbsSum,
+    sse2CrossingDifferenceSum
+};
+
+const KernelTable avx2Table = {
+    AudioKernels::Isa::AVX2,
+    avx2AbsMaxFloat,
+    avx2AbsMaxDouble,
+    avx2AbsSumFloat,
+    avx2AbsSumDouble,
+    avx2SumSquaresFloat,
+    avx2SumSquaresDouble,
+    avx2DifferenceEnergyFloat,
+    avx2DifferenceEnergyDouble,
+    avx2ZeroCrossingsFloat,
+    avx2ZeroCrossingsDouble,
+    avx2MinMax,
+    avx2DifferenceAbsSum,
+    avx2CrossingDifferenceSum
+};
+
+#endif // AUDIO_KERNELS_X86
+
+#ifdef AUDIO_KERNELS_NEON
+
+// NEON: 4 float lanes, 2 double lanes on AArch64
+
+float neonAbsMaxFloat(const float* data, size_t count) {
+    float32x4_t maximum = vdupq_n_f32(0.0f);
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        maximum = vmaxq_f32(maximum, vabsq_f32(vld1q_f32(data + i)));
+    }
+    float lanes[4];
+    vst1q_f32(lanes, maximum);
+    return std::max(horizontalMax(lanes), scalarAbsMax(data + i, count - i));
+}
+
+double neonAbsSumFloat(const float* data, size_t count) {
+    double total = 0.0;
+    size_t i = 0;
+    while (i + 4 <= count) {
+        size_t blockEnd = std::min(count, i + FLOAT_BLOCK);
+        float32x4_t sum = vdupq_n_f32(0.0f);
+        for (; i + 4 <= blockEnd; i += 4) {
+            sum = vaddq_f32(sum, vabsq_f32(vld1q_f32(data + i)));
+        }
+        float lanes[4];
+        vst1q_f32(lanes, sum);
+        total += horizontalSum(lanes);
+    }
+    return total + scalarAbsSum(data + i, count - i);
+}
+
+double neonSumSquaresFloat(const float* data, size_t count) {
+    double total = 0.0;
+    size_t i = 0;
+    while (i + 4 <= count) {
+        size_t blockEnd = std::min(count, i + FLOAT_BLOCK);
+        float32x4_t sum = vdupq_n_f32(0.0f);
+        for (; i + 4 <= blockEnd; i += 4) {
+            float32x4_t x = vld1q_f32(data + i);
+            sum = vmlaq_f32(sum, x, x);
+        }
+        float lanes[4];
+        vst1q_f32(lanes, sum);
+        total += horizontalSum(lanes);
+    }
+    return total + scalarSumSquares(data + i, count - i);
+}
+
+double neonDifferenceEnergyFloat(const float* data, size_t count) {
+    double total = 0.0;
+    size_t i = 1;
+    while (i + 4 <= count) {
+        size_t blockEnd = std::min(count, i + FLOAT_BLOCK);
+        float32x4_t sum = vdupq_n_f32(0.0f);
+        for (; i + 4 <= blockEnd; i += 4) {
+            float32x4_t difference = vsubq_f32(vld1q_f32(data + i), vld1q_f32(data + i - 1));
+            sum = vmlaq_f32(sum, difference, difference);
+        }
+        float lanes[4];
+        vst1q_f32(lanes, sum);
+        total += horizontalSum(lanes);
+    }
+    return total + scalarDifferenceEnergy(data, i, count);
+}
+
+size_t neonZeroCrossingsFloat(const float* data, size_t count) {
+    const float32x4_t zero = vdupq_n_f32(0.0f);
+    uint32x4_t crossings = vdupq_n_u32(0);
+    size_t i = 1;
+    for (; i + 4 <= count; i += 4) {
+        uint32x4_t current = vcgeq_f32(vld1q_f32(data + i), zero);
+        uint32x4_t previous = vcgeq_f32(vld1q_f32(data + i - 1), zero);
+        crossings = vaddq_u32(crossings, vshrq_n_u32(veorq_u32(current, previous), 31));
+    }
+    uint32_t lanes[4];
+    vst1q_u32(lanes, crossings);
+    return static_cast<size_t>(horizontalSum(lanes)) + scalarZeroCrossings(data, i, count);
+}
+
+void neonMinMax(const float* data, size_t count, float& minimum, float& maximum) {
+    float32x4_t low = vdupq_n_f32(data[0]);
+    float32x4_t high = low;
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        float32x4_t x = vld1q_f32(data + i);
+        low = vminq_f32(low, x);
+        high = vmaxq_f32(high, x);
+    }
+    float lowLanes[4];
+    float highLanes[4];
+    vst1q_f32(lowLanes, low);
+    vst1q_f32(highLanes, high);
+    minimum = horizontalMin(lowLanes);
+    maximum = horizontalMax(highLanes);
+    scalarMinMax(data, i, count, minimum, maximum);
+}
+
+double neonDifferenceAbsSum(const float* data, size_t count) {
+    double total = 0.0;
+    size_t i = 1;
+    while (i + 4 <= count) {
+        size_t blockEnd = std::min(count, i + FLOAT_BLOCK);
+        float32x4_t sum = vdupq_n_f32(0.0f);
+        for (; i + 4 <= blockEnd; i += 4) {
+            sum = vaddq_f32(sum, vabdq_f32(vld1q_f32(data + i), vld1q_f32(data + i - 1)));
+        }
+        float lanes[4];
+        vst1q_f32(lanes, sum);
+        total += horizontalSum(lanes);
+    }
+    return total + scalarDifferenceAbsSum(data, i, count);
+}
+
+double neonCrossingDifferenceSum(const float* data, size_t count) {
+    const float32x4_t zero = vdupq_n_f32(0.0f);
+    double total = 0.0;
+    size_t i = 1;
+    while (i + 4 <= count) {
+        size_t blockEnd = std::min(count, i + FLOAT_BLOCK);
+        float32x4_t sum = vdupq_n_f32(0.0f);
+        for (; i + 4 <= blockEnd; i += 4) {
+            float32x4_t current = vld1q_f32(data + i);
+            float32x4_t previous = vld1q_f32(data + i - 1);
+            uint32x4_t crossing = veorq_u32(vcgeq_f32(current, zero), vcgeq_f32(previous, zero));
+            uint32x4_t difference = vreinterpretq_u32_f32(vabdq_f32(current, previous));
+            sum = vaddq_f32(sum, vreinterpretq_f32_u32(vandq_u32(difference, crossing)));
+        }
+        float lanes[4];
+        vst1q_f32(lanes, sum);
+        total += horizontalSum(lanes);
+    }
+    return total + scalarCrossingDifferenceSum(data, i, count);
+}
+
+#ifdef __aarch64__
+double neonAbsMaxDouble(const double* data, size_t count) {
+    float64x2_t maximum = vdupq_n_f64(0.0);
+    size_t i = 0;
+    for (; i + 2 <= count; i += 2) {
+        maximum = vmaxq_f64(maximum, vabsq_f64(vld1q_f64(data + i)));
+    }
+    double lanes[2];
+    vst1q_f64(lanes, maximum);
+    return std::max(horizontalMax(lanes), scalarAbsMax(data + i, count - i));
+}
+
+double neonAbsSumDouble(const double* data, size_t count) {
+    float64x2_t sum = vdupq_n_f64(0.0);
+    size_t i = 0;
+    for (; i + 2 <= count; i += 2) {
+        sum = vaddq_f64(sum, vabsq_f64(vld1q_f64(data + i)));
+    }
+    double lanes[2];
+    vst1q_f64(lanes, sum);
+    return horizontalSum(lanes) + scalarAbsSum(data + i, count - i);
+}
+
+double neonSumSquaresDouble(const double* data, size_t count) {
+    float64x2_t sum = vdupq_n_f64(0.0);
+    size_t i = 0;
+    for (; i + 2 <= count; i += 2) {
+        float64x2_t x = vld1q_f64(data + i);
+        sum = vfmaq_f64(sum, x, x);
+    }
+    double lanes[2];
+    vst1q_f64(lanes, sum);
+    return horizontalSum(lanes) + scalarSumSquares(data + i, count - i);
+}
+
+double neonDifferenceEnergyDouble(const double* data, size_t count) {
+    float64x2_t sum = vdupq_n_f64(0.0);
+    size_t i = 1;
+    for (; i + 2 <= count; i += 2) {
+        float64x2_t difference = vsubq_f64(vld1q_f64(data + i), vld1q_f64(data + i - 1));
+        sum = vfmaq_f64(sum, difference, difference);
+    }
+    double lanes[2];
+    vst1q_f64(lanes, sum);
+    return horizontalSum(lanes) + scalarDifferenceEnergy(data, i, count);
+}
+
+size_t neonZeroCrossingsDouble(const double* data, size_t count) {
+    const float64x2_t zero = vdupq_n_f64(0.0);
+    uint64x2_t crossings = vdupq_n_u64(0);
+    size_t i = 1;
+    for (; i + 2 <= count; i += 2) {
+        uint64x2_t current = vcgeq_f64(vld1q_f64(data + i), zero);
+        uint64x2_t previous = vcgeq_f64(vld1q_f64(data + i - 1), zero);
+        crossings = vaddq_u64(crossings, vshrq_n_u64(veorq_u64(current, previous), 63));
+    }
+    uint64_t lanes[2];
+    vst1q_u64(lanes, crossings);
+    return static_cast<size_t>(lanes[0] + lanes[1]) + scalarZeroCrossings(data, i, count);
+}
+#endif
+
+const KernelTable neonTable = {
+    AudioKernels::Isa::NEON,
+    neonAbsMaxFloat,
+#ifdef __aarch64__
+    neonAbsMaxDouble,
+#else
+    scalarAbsMax<double>,
+#endif
+    neonAbsSumFloat,
+#ifdef __aarch64__
+    neonAbsSumDouble,
+#else
+    scalarAbsSum<double>,
+#endif
+    neonSumSquaresFloat,
+#ifdef __aarch64__
+    neonSumSquaresDouble,
+#else
+    scalarSumSquares<double>,
+#endif
+    neonDifferenceEnergyFloat,
+#ifdef __aarch64__
+    neonDifferenceEnergyDouble,
+#else
+    [](const double* data, size_t count) { return scalarDifferenceEnergy(data, 1, count); },
+#endif
+    neonZeroCrossingsFloat,
+#ifdef __aarch64__
+    neonZeroCrossingsDouble,
+#else
+    [](const double* data, size_t count) { return scalarZeroCrossings(data, 1, count); },
+#endif
+    neonMinMax,
+    neonDifferenceAbsSum,
+    neonCrossingDifferenceSum
+};
+
+#endif // AUDIO_KERNELS_NEON
+
+std::atomic<const KernelTable*> activeTable{nullptr};
+
+const KernelTable* tableFor(AudioKernels::Isa isa) {
+    switch (isa) {
+#ifdef AUDIO_KERNELS_X86
+        case AudioKernels::Isa::SSE2: return &sse2Table;
+        case AudioKernels::Isa::AVX2: return &avx2Table;
+#endif
+#ifdef AUDIO_KERNELS_NEON
+        case AudioKernels::Isa::NEON: return &neonTable;
+#endif
+        default: return &scalarTable;
+    }
+}
+
+const KernelTable& kernels() {
+    const KernelTable* table = activeTable.load(std::memory_order_acquire);
+    if (!table) {
+        table = tableFor(AudioKernels::detectIsa());
+        activeTable.store(table, std::memory_order_release);
+    }
+    return *table;
+}
+
+} // namespace
+
+namespace AudioKernels {
+
+bool isSupported(Isa isa) {
+    switch (isa) {
+        case Isa::SCALAR:
+            return true;
+#ifdef AUDIO_KERNELS_X86
+        case Isa::SSE2:
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("sse2");
+        case Isa::AVX2:
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("avx2");
+#endif
+#ifdef AUDIO_KERNELS_NEON
+        case Isa::NEON:
+            return true;
+#endif
+        default:
+            return false;
+    }
+}
+
+Isa detectIsa() {
+    for (Isa isa : {Isa::AVX2, Isa::NEON, Isa::SSE2}) {
+        if (isSupported(isa)) {
+            return isa;
+        }
+    }
+    return Isa::SCALAR;
+}
+
+Isa getIsa() {
+    return kernels().isa;
+}
+
+bool setIsa(Isa isa) {
+    if (!isSupported(isa)) {
+        return false;
+    }
+    activeTable.store(tableFor(isa), std::memory_order_release);
+    return true;
+}
+
+const char* getIsaName(Isa isa) {
+    switch (isa) {
+        case Isa::SSE2: return "SSE2";
+        case Isa::AVX2: return "AVX2";
+        case Isa::NEON: return "NEON";
+        default: return "Scalar";
+    }
+}
+
+float absMax(const float* data, size_t count) { return kernels().absMaxFloat(data, count); }
+double absMax(const double* data, size_t count) { return kernels().absMaxDouble(data, count); }
+
+double absSum(const float* data, size_t count) { return kernels().absSumFloat(data, count); }
+double absSum(const double* data, size_t count) { return kernels().absSumDouble(data, count); }
+
+double sumSquares(const float* data, size_t count) { return kernels().sumSquaresFloat(data, count); }
+double sumSquares(const double* data, size_t count) { return kernels().sumSquaresDouble(data, count); }
+
+double differenceEnergy(const float* data, size_t count) { return kernels().differenceEnergyFloat(data, count); }
+double differenceEnergy(const double* data, size_t count) { return kernels().differenceEnergyDouble(data, count); }
+
+size_t zeroCrossings(const float* data, size_t count) { return kernels().zeroCrossingsFloat(data, count); }
+size_t zeroCrossings(const double* data, size_t count) { return kernels().zeroCrossingsDouble(data, count); }
+
+void minMax(const float* data, size_t count, float& minimum, float& maximum) {
+    kernels().minMax(data, count, minimum, maximum);
+}
+
+double differenceAbsSum(const float* data, size_t count) { return kernels().differenceAbsSum(data, count); }
+double crossingDifferenceSum(const float* data, size_t count) { return kernels().crossingDifferenceSum(data, count); }
+
+} // AudioKernels
@@ -0,0 +1,306 @@
+#include "ChartFile.hpp"
+#include <cstring>
+#include <fstream>
+
+#if defined(_WIN32)
+#include <windows.h>
+#elif !defined(__EMSCRIPTEN__)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace App {
+namespace Windows {
+
+namespace {
+
+// Version 1 records: id, lane, timestamp; version 2 adds the note type and end time
+const size_t NOTE_RECORD_SIZE_V1 = sizeof(int) + sizeof(Core::Lane) + sizeof(double);
+const size_t NOTE_RECORD_SIZE_V2 = sizeof(int) + sizeof(Core::Lane) + sizeof(Core::NoteType) + 2 * sizeof(double);
+
+} // namespace
+
+ChartFile::ChartFile()
+    : data(nullptr),
+      size(0),
+      mapped(false),
+#ifdef _WIN32
+      fileHandle(nullptr),
+      mappingHandle(nullptr),
+#endif
+      audioOffset(0),
+      audioSize(0),
+      notesOffset(0),
+      noteRecordSize(0),
+      analysisOffset(0),
+      analysisSize(0) {
+    memset(&header, 0, sizeof(header));
+}
+
+ChartFile::~ChartFile() {
+    close();
+}
+
+bool ChartFile::mapFile(const std::string& filepath) {
+#if defined(_WIN32)
+    HANDLE file = CreateFileA(filepath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) {
+        CloseHandle(file);
+        return false;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    void* view = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (!view) {
+        if (mapping) {
+            CloseHandle(mapping);
+        }
+        CloseHandle(file);
+        return false;
+    }
+
+    fileHandle = file;
+    mappingHandle = mapping;
+    data = static_cast<const unsigned char*>(view);
+    size = static_cast<size_t>(fileSize.QuadPart);
+    mapped = true;
+    return true;
+#elif !defined(__EMSCRIPTEN__)
+    int fd = ::open(filepath.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size <= 0) {
+        ::close(fd);
+        return false;
+    }
+
+    void* view = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (view == MAP_FAILED) {
+        return false;
+    }
+
+    data = static_cast<const unsigned char*>(view);
+    size = static_cast<size_t>(info.st_size);
+    mapped = true;
+    return true;
+#else
+    (void)filepath;
+    return false;
+#endif
+}
+
+bool ChartFile::open(const std::string& filepath) {
+    close();
+
+    if (!mapFile(filepath)) {
+        std::ifstream file(filepath, std::ios::binary | std::ios::ate);
+        if (!file.is_open()) {
+            lastError = "Failed to open chart file: " + filepath;
+            return false;
+        }
+
+        std::streamsize fileSize = file.tellg();
+        file.seekg(0, std::ios::beg);
+        buffer.resize(fileSize > 0 ? static_cast<size_t>(fileSize) : 0);
+        if (buffer.empty() || !file.read(reinterpret_cast<char*>(buffer.data()), fileSize)) {
+            buffer.clear();
+            lastError = "Failed to read chart file: " + filepath;
+            return false;
+        }
+
+        data = buffer.data();
+        size = buffer.size();
+    }
+
+    path = filepath;
+    if (!validate()) {
+        std::string error = lastError;
+        close();
+        lastError = error;
+        return false;
+    }
+
+    return true;
+}
+
+bool ChartFile::validate() {
+    if (size < sizeof(ChartHeader)) {
+        lastError = "Chart file is too small to hold a header";
+        return false;
+    }
+    memcpy(&header, data, sizeof(ChartHeader));
+
+    if (strncmp(header.magic, "NOTARHYTHM", sizeof(header.magic)) != 0) {
+        lastError = "Invalid chart file format - wrong magic number";
+        return false;
+    }
+
+    if (header.version < 1 || header.version > CHART_FORMAT_VERSION) {
+        lastError = "Unsupported chart file version: " + std::to_string(header.version);
+        return false;
+    }
+
+    // Make sure the strings are terminated even if the file is not
+    header.title[sizeof(header.title) - 1] = '\0';
+    header.artist[sizeof(header.artist) - 1] = '\0';
+
+    if (header.version >= 3) {
+        return validateSections();
+    }
+
+    audioOffset = sizeof(ChartHeader);
+    audioSize = header.audioSize;
+    notesOffset = audioOffset + audioSize;
+    noteRecordSize = header.version >= 2 ? NOTE_RECORD_SIZE_V2 : NOTE_RECORD_SIZE_V1;
+
+    if (audioSize > size - audioOffset) {
+        lastError = "Chart audio data is truncated";
+        return false;
+    }
+
+    if (header.notesCount > (size - notesOffset) / noteRecordSize) {
+        lastError = "Chart note data is truncated";
+        return false;
+    }
+
+    return true;
+}
+
+bool ChartFile::validateSections() {
+    size_t directoryOffset = sizeof(ChartHeader);
+    if (header.sectionCount == 0 || header.sectionCount > (size - directoryOffset) / sizeof(ChartSection)) {
+        lastError = "Chart section directory is truncated";
+        return false;
+    }
+
+    bool hasNotes = false;
+    bool hasAudio = false;
+    noteRecordSize = sizeof(ChartNoteRecord);
+
+    for (uint32_t i = 0; i < header.sectionCount; i++) {
+        ChartSection section;
+        memcpy(&section, data + directoryOffset + i * sizeof(ChartSection), sizeof(ChartSection));
+
+        if (section.offset > size || section.size > size - section.offset) {
+            lastError = "Chart section " + std::to_string(i) + " lies outside of the file";
+            return false;
+        }
+
+        switch (section.type) {
+            case CHART_SECTION_NOTES:
+                if (section.size / noteRecordSize < header.notesCount) {
+                    lastError = "Chart note data is truncated";
+                    return false;
+                }
+                notesOffset = static_cast<size_t>(section.offset);
+                hasNotes = true;
+                break;
+            case CHART_SECTION_ANALYSIS:
+                analysisOffset = static_cast<size_t>(section.offset);
+                analysisSize = static_cast<size_t>(section.size);
+                break;
+            case CHART_SECTION_AUDIO:
+                audioOffset = static_cast<size_t>(section.offset);
+                audioSize = static_cast<size_t>(section.size);
+                hasAudio = true;
+                break;
+            default:
+                // Sections added by newer writers are skipped
+                break;
+        }
+    }
+
+    if (!hasAudio || (!hasNotes && header.notesCount > 0)) {
+        lastError = "Chart is missing its audio or note section";
+        return false;
+    }
+
+    return true;
+}
+
+void ChartFile::close() {
+    if (data && mapped) {
+#if defined(_WIN32)
+        UnmapViewOfFile(data);
+        CloseHandle(static_cast<HANDLE>(mappingHandle));
+        CloseHandle(static_cast<HANDLE>(fileHandle));
+        mappingHandle = nullptr;
+        fileHandle = nullptr;
+#elif !defined(__EMSCRIPTEN__)
+        munmap(const_cast<unsigned char*>(data), size);
+#endif
+    }
+
+    data = nullptr;
+    size = 0;
+    mapped = false;
+    buffer.clear();
+    buffer.shrink_to_fit();
+    path.clear();
+    lastError.clear();
+    memset(&header, 0, sizeof(header));
+    audioOffset = 0;
+    audioSize = 0;
+    notesOffset = 0;
+    noteRecordSize = 0;
+    analysisOffset = 0;
+    analysisSize = 0;
+}
+
+Core::Note ChartFile::getNote(size_t index) const {
+    const unsigned char* record = getNoteRecords() + index * noteRecordSize;
+    Core::Note note;
+
+    if (header.version >= 3) {
+        ChartNoteRecord packed;
+        memcpy(&packed, record, sizeof(packed));
+        note.id = packed.id;
+        note.lane = static_cast<Core::Lane>(packed.lane);
+        note.type = static_cast<Core::NoteType>(packed.type);
+        note.timestamp = packed.timestamp;
+        note.endTimestamp = packed.endTimestamp;
+        return note;
+    }
+
+    memcpy(&note.id, record, sizeof(note.id));
+    record += sizeof(note.id);
+    memcpy(&note.lane, record, sizeof(note.lane));
+    record += sizeof(note.lane);
+
+    if (header.version >= 2) {
+        memcpy(&note.type, record, sizeof(note.type));
+        record += sizeof(note.type);
+        memcpy(&note.timestamp, record, sizeof(note.timestamp));
+        record += sizeof(note.timestamp);
+        memcpy(&note.endTimestamp, record, sizeof(note.endTimestamp));
+    } else {
+        // Version 1 compatibility - all notes are TAP notes
+        note.type = Core::NoteType::TAP;
+        memcpy(&note.timestamp, record, sizeof(note.timestamp));
+        note.endTimestamp = note.timestamp;
+    }
+
+    return note;
+}
+
+const ChartNoteRecord* ChartFile::getNoteTable() const {
+    const unsigned char* records = getNoteRecords();
+    if (!records || header.version < 3 || reinterpret_cast<uintptr_t>(records) % alignof(ChartNoteRecord) != 0) {
+        return nullptr;
+    }
+    return reinterpret_cast<const ChartNoteRecord*>(records);
+}
+
+} // Windows
+} // App
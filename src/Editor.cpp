@@ -1,4 +1,5 @@
 #include "Editor.hpp"
+#include "AnalysisCache.hpp"
 
 namespace App {
 namespace Windows {
@@ -58,15 +59,9 @@ void Editor::drawTimelineLanes() {
         );
     }
 
-    for (const auto& note : nodeManager.getNotes()) {
-        if (note.type == Core::NoteType::HOLD) {
-            if ((note.timestamp < visible_start && note.endTimestamp < visible_start) ||
-                (note.timestamp > visible_start + visible_duration && note.endTimestamp > visible_start + visible_duration)) {
-                continue;
-            }
-        } else {
-            if (note.timestamp < visible_start || note.timestamp > visible_start + visible_duration) continue;
-        }
+    nodeManager.queryRange(visible_start, visible_start + visible_duration, Core::NodeManager::ALL_LANES, visibleNotes);
+    for (const Core::Note* visibleNote : visibleNotes) {
+        const Core::Note& note = *visibleNote;
 
         float x = content_pos.x + (note.timestamp - visible_start) * pixels_per_second;
         float y = timeline_y + note.lane * laneHeight + laneHeight * 0.5f;
@@ -310,8 +305,14 @@ void Editor::handleNotePlacementAndInteraction() {
         float rel_x = mouse.x - content_pos.x;
         float rel_y = mouse.y - timeline_y;
 
+        // Only notes whose span comes within a note radius of the cursor can be hit
+        double mouseTime = visible_start + rel_x / pixels_per_second;
+        double hitTolerance = noteRadius / pixels_per_second;
+        nodeManager.queryRange(mouseTime - hitTolerance, mouseTime + hitTolerance, Core::NodeManager::ALL_LANES, visibleNotes);
+
         bool clickedOnNote = false;
-        for (const auto& note : nodeManager.getNotes()) { // Select notes
+        for (const Core::Note* candidate : visibleNotes) { // Select notes
+            const Core::Note& note = *candidate;
             float note_x = content_pos.x + (note.timestamp - visible_start) * pixels_per_second;
             float note_y = timeline_y + note.lane * laneHeight + laneHeight * 0.5f;
             float distance = sqrtf((mouse.x - note_x) * (mouse.x - note_x) + (mouse.y - note_y) * (mouse.y - note_y));
@@ -357,8 +358,7 @@ void Editor::handleNotePlacementAndInteraction() {
 
                 double snapped = t;
                 if (shouldSnap()) {
-                    float snapSpacing = getSnapSpacing();
-                    snapped = std::round(t / snapSpacing) * snapSpacing;
+                    snapped = snapTime(t);
                 }
 
                 snapped = std::clamp(snapped, 0.0, songDuration);
@@ -379,7 +379,9 @@ void Editor::handleNotePlacementAndInteraction() {
         }
 
         if (ImGui::IsMouseDoubleClicked(0)) { // Delete note on double click
-            for (const auto& note : nodeManager.getNotes()) {
+            nodeManager.queryRange(mouseTime - hitTolerance, mouseTime + hitTolerance, Core::NodeManager::ALL_LANES, visibleNotes);
+            for (const Core::Note* candidate : visibleNotes) {
+                const Core::Note& note = *candidate;
                 float note_x = content_pos.x + (note.timestamp - visible_start) * pixels_per_second;
                 float note_y = timeline_y + note.lane * laneHeight + laneHeight * 0.5f;
                 float distance = sqrtf((mouse.x - note_x) * (mouse.x - note_x) + (mouse.y - note_y) * (mouse.y - note_y));
@@ -396,9 +398,10 @@ void Editor::handleNotePlacementAndInteraction() {
                 }
 
                 if (noteClicked) {
-                    nodeManager.removeNote(note.id);
-                    if (selectedNoteId == note.id) selectedNoteId = -1;
-                    if (hoveredNoteId == note.id) hoveredNoteId = -1;
+                    int removedId = note.id;
+                    nodeManager.removeNote(removedId);
+                    if (selectedNoteId == removedId) selectedNoteId = -1;
+                    if (hoveredNoteId == removedId) hoveredNoteId = -1;
                     break;
                 }
             }
@@ -441,8 +444,7 @@ void Editor::handleNotePlacementAndInteraction() {
             double newTimestamp = visible_start + (rel_x / pixels_per_second);
 
             if (shouldSnap()) {
-                float snapSpacing = getSnapSpacing();
-                newTimestamp = std::round(newTimestamp / snapSpacing) * snapSpacing;
+                newTimestamp = snapTime(newTimestamp);
             }
 
             newTimestamp = std::clamp(newTimestamp, 0.0, songDuration);
@@ -511,7 +513,7 @@ void Editor::handleNotePlacementAndInteraction() {
             if (modified) {
                 newTimestamp = std::clamp(newTimestamp, 0.0, songDuration);
                 nodeManager.moveNote(selectedNoteId, newLane, newTimestamp);
-                jumpToPosition(selectedNote);
+                jumpToPosition(nodeManager.getNoteById(selectedNoteId));
             }
         }
     }
@@ -533,7 +535,7 @@ void Editor::handleNotePlacementAndInteraction() {
             newPosition = std::clamp(newPosition, 0.0, songDuration);
 
             if (soundManager) {
-                soundManager->setPosition("timeline_song", newPosition);
+                soundManager->setPosition(songHandle, newPosition);
                 currentPosition = newPosition;
 
                 if (enableAutoscroll) {
@@ -565,19 +567,27 @@ void Editor::handleNotePlacementAndInteraction() {
 
 Editor::Editor()
     : soundManager(nullptr),
-      currentSongPath(""),
+      currentSongSource(),
       currentSongName(""),
       isSongLoaded(false),
       isPlaying(false),
       currentPosition(0.0),
       songDuration(0.0),
-      audioAnalyzer(std::make_unique<AudioAnalyzer>(500 * 1024 * 1024)),
+      audioAnalyzer(std::make_unique<AudioAnalyzer>()),
       showWaveform(true),
       waveformLoaded(false),
+      waveformTiles(),
+      spectrogramTiles(),
+      showSpectrogram(false),
+      waveformTilesValid(false),
       isAnalyzing(false),
       analysisProgress(""),
       analysisProgressPercent(0.0f),
+      analysisSlot({{}, "", 0.0f, false, false, {}, {0.0, 0.0, 0.0}}),
+      analysisPool(std::make_unique<ThreadPool>(1)),
       bpm(120.0f),
+      gridOffset(0.0f),
+      detectedTempo({0.0, 0.0, 0.0}),
       showGrid(true),
       showSubGrid(true),
       subGridDivisions(4),
@@ -602,6 +612,8 @@ Editor::Editor()
       showMilliseconds(false),
       noteRadius(12.0f),
       sortOrder(SortOrder::TIME),
+      noteListRevision(0),
+      noteListSortOrder(SortOrder::TIME),
       showSaveDialog(false),
       showLoadDialog(false),
       showHelpWindow(false),
@@ -617,6 +629,8 @@ Editor::Editor()
       metronomeBeatCount(0),
       metronomeSound1(true),
       spectrumHistorySize(100),
+      spectrumHistoryHead(0),
+      lastSpectrumTime(-1.0),
       spectrumInitialized(false),
       showBpmFinder(false),
       bpmFinderActive(false),
@@ -641,19 +655,27 @@ Editor::Editor()
 
 Editor::Editor(SoundManager* soundManager)
     : soundManager(soundManager),
-      currentSongPath(""),
+      currentSongSource(),
       currentSongName(""),
       isSongLoaded(false),
       isPlaying(false),
       currentPosition(0.0),
       songDuration(0.0),
-      audioAnalyzer(std::make_unique<AudioAnalyzer>(500 * 1024 * 1024)),
+      audioAnalyzer(std::make_unique<AudioAnalyzer>()),
       showWaveform(true),
       waveformLoaded(false),
+      waveformTiles(),
+      spectrogramTiles(),
+      showSpectrogram(false),
+      waveformTilesValid(false),
       isAnalyzing(false),
       analysisProgress(""),
       analysisProgressPercent(0.0f),
+      analysisSlot({{}, "", 0.0f, false, false, {}, {0.0, 0.0, 0.0}}),
+      analysisPool(std::make_unique<ThreadPool>(1)),
       bpm(120.0f),
+      gridOffset(0.0f),
+      detectedTempo({0.0, 0.0, 0.0}),
       showGrid(true),
       showSubGrid(true),
       subGridDivisions(4),
@@ -678,6 +700,8 @@ Editor::Editor(SoundManager* soundManager)
       showMilliseconds(false),
       noteRadius(12.0f),
       sortOrder(SortOrder::TIME),
+      noteListRevision(0),
+      noteListSortOrder(SortOrder::TIME),
       showSaveDialog(false),
       showLoadDialog(false),
       showHelpWindow(false),
@@ -692,6 +716,8 @@ Editor::Editor(SoundManager* soundManager)
       metronomeBeatCount(0),
       showSpectrum(false),
       spectrumHistorySize(100),
+      spectrumHistoryHead(0),
+      lastSpectrumTime(-1.0),
       spectrumInitialized(false),
       metronomeSound1(true),
       showBpmFinder(false),
@@ -724,6 +750,23 @@ bool Editor::shouldSnap() const {
     return snapMode != NO_SNAP;
 }
 
+double Editor::snapTime(double time) const {
+    float snapSpacing = getSnapSpacing();
+    if (snapSpacing <= 0.0f) {
+        return time;
+    }
+    return gridOffset + std::round((time - gridOffset) / snapSpacing) * snapSpacing;
+}
+
+void Editor::applyDetectedTempo() {
+    if (detectedTempo.bpm <= 0.0) {
+        return;
+    }
+    bpm = static_cast<float>(detectedTempo.bpm);
+    gridOffset = static_cast<float>(detectedTempo.offset);
+    calculateGridSpacing();
+}
+
 float Editor::getSnapSpacing() const {
     switch (snapMode) {
         case SNAP_TO_GRID:
@@ -763,16 +806,17 @@ void Editor::loadSong(const std::string& filepath) {
     size_t lastSlash = filepath.find_last_of("/\\");
     currentSongName = (lastSlash != std::string::npos) ? filepath.substr(lastSlash + 1) : filepath;
 
-    if (soundManager->loadSound("timeline_song", filepath)) {
-        currentSongPath = filepath;
+    songHandle = soundManager->loadSound("timeline_song", filepath);
+    if (songHandle) {
+        currentSongSource = AudioSource(filepath);
         isSongLoaded = true;
         currentPosition = 0.0;
         isPlaying = false;
 
-        songDuration = soundManager->getDuration("timeline_song");
+        songDuration = soundManager->getDuration(songHandle);
 
         if (audioAnalyzer) {
-            audioAnalyzer->cacheAudioForSpectrum(filepath);
+            audioAnalyzer->cacheAudioForSpectrum(currentSongSource);
         }
     } else {
         std::cerr << "Failed to load song: " << filepath << std::endl;
@@ -782,33 +826,31 @@ void Editor::loadSong(const std::string& filepath) {
 void Editor::updatePlayback() {
     if (!soundManager || !isSongLoaded) return;
 
-    currentPosition = soundManager->getPosition("timeline_song");
+    currentPosition = soundManager->getClockTime(songHandle);
 
     if (isPlaying && currentPosition >= songDuration) {
         currentPosition = 0.0;
         isPlaying = false;
-        soundManager->stopSound("timeline_song");
+        soundManager->stopSound(songHandle);
     }
 }
 
+void Editor::loadMetronomeSounds() {
+    // Returns the loaded handles again when the samples already exist
+    metronomeHandles[0] = soundManager->loadSample("metronome1", "assets/metronome1.wav");
+    metronomeHandles[1] = soundManager->loadSample("metronome2", "assets/metronome2.wav");
+}
+
 void Editor::updateMetronome() {
     if (!metronomeEnabled || !soundManager || !isSongLoaded || !isPlaying) return;
 
     double beatDuration = 60.0 / bpm;
 
-    double currentBeat = currentPosition / beatDuration;
-    int currentBeatNumber = static_cast<int>(currentBeat);
+    double currentBeat = (currentPosition - gridOffset) / beatDuration;
+    int currentBeatNumber = static_cast<int>(std::floor(currentBeat));
 
     if (currentBeatNumber > metronomeBeatCount) {
-        if (metronomeSound1) {
-            if (soundManager->isSoundLoaded("metronome1")) {
-                soundManager->playSound("metronome1");
-            }
-        } else {
-            if (soundManager->isSoundLoaded("metronome2")) {
-                soundManager->playSound("metronome2");
-            }
-        }
+        soundManager->playSample(metronomeHandles[metronomeSound1 ? 0 : 1]);
 
         metronomeSound1 = !metronomeSound1;
         metronomeBeatCount = currentBeatNumber;
@@ -821,36 +863,30 @@ void Editor::updateSpectrum() {
         return;
     }
 
-    static double lastUpdateTime = 0.0;
-    double currentTime = ImGui::GetTime();
-    if (currentTime - lastUpdateTime < 0.03) {
-        return;
+    if (!spectrumInitialized) {
+        spectrumData.assign(SPECTRUM_BANDS, 0.0f);
+        spectrumFrame.assign(SPECTRUM_BANDS, 0.0f);
+        spectrumHistory.assign(spectrumHistorySize, std::vector<float>(SPECTRUM_BANDS, 0.0f));
+        spectrumHistoryHead = 0;
+        spectrumInitialized = true;
     }
-    lastUpdateTime = currentTime;
-
-    const int spectrumSize = 64;
-
-    try {
-        spectrumData = audioAnalyzer->getSpectrumAtTime(currentSongPath, currentPosition, spectrumSize);
-
-        static std::vector<float> previousSpectrum(spectrumSize, 0.0f);
-        const float smoothingFactor = 0.7f;
 
-        for (int i = 0; i < spectrumSize; ++i) {
-            spectrumData[i] = smoothingFactor * previousSpectrum[i] + (1.0f - smoothingFactor) * spectrumData[i];
-            previousSpectrum[i] = spectrumData[i];
-        }
+    // The stream only decodes what was played since the last frame, a still position costs nothing
+    if (currentPosition == lastSpectrumTime) {
+        return;
+    }
+    lastSpectrumTime = currentPosition;
 
-    } catch (const std::exception& e) {
-        spectrumData.resize(spectrumSize);
-        double time = currentPosition;
+    audioAnalyzer->getSpectrumAtTime(currentSongSource, currentPosition, spectrumFrame);
 
-        for (int i = 0; i < spectrumSize; ++i) {
-            float value = 0.3f + 0.2f * sin(time * 2.0 + i * 0.1f);
-            value = std::max(0.0f, std::min(1.0f, value));
-            spectrumData[i] = value;
-        }
+    // Same decay as the old 0.7 per 30 ms update, whatever the frame rate
+    float smoothingFactor = std::pow(0.7f, ImGui::GetIO().DeltaTime / 0.03f);
+    for (int i = 0; i < SPECTRUM_BANDS; ++i) {
+        spectrumData[i] = smoothingFactor * spectrumData[i] + (1.0f - smoothingFactor) * spectrumFrame[i];
     }
+
+    std::copy(spectrumFrame.begin(), spectrumFrame.end(), spectrumHistory[spectrumHistoryHead].begin());
+    spectrumHistoryHead = (spectrumHistoryHead + 1) % spectrumHistorySize;
 }
 
 void Editor::handleKeyboardInput() {
@@ -869,17 +905,17 @@ void Editor::handleKeyboardInput() {
             bpmFinderActive = true;
             bpmFinderStartTime = ImGui::GetTime();
             if (soundManager && isSongLoaded && !isPlaying) {
-                soundManager->resumeSound("timeline_song");
+                soundManager->resumeSound(songHandle);
                 isPlaying = true;
             }
             return;
         }
 
         if (isPlaying) {
-            soundManager->pauseSound("timeline_song");
+            soundManager->pauseSound(songHandle);
             isPlaying = false;
         } else {
-            soundManager->resumeSound("timeline_song");
+            soundManager->resumeSound(songHandle);
             isPlaying = true;
         }
     }
@@ -887,7 +923,7 @@ void Editor::handleKeyboardInput() {
     if (ImGui::IsKeyPressed(ImGuiKey_Enter)) {
         double zero = 0;
         currentPosition = zero;
-        soundManager->seekTo("timeline_song", currentPosition);
+        soundManager->seekTo(songHandle, currentPosition);
 
         metronomeBeatCount = 0;
         metronomeSound1 = true;
@@ -897,10 +933,10 @@ void Editor::handleKeyboardInput() {
         speedOverrideEnabled = !speedOverrideEnabled;
         if (soundManager && isSongLoaded) {
             if (speedOverrideEnabled) {
-                originalPlaybackSpeed = soundManager->getCurrentPlaybackSpeed("timeline_song");
-                soundManager->setPlaybackSpeed("timeline_song", playbackSpeed);
+                originalPlaybackSpeed = soundManager->getCurrentPlaybackSpeed(songHandle);
+                soundManager->setPlaybackSpeed(songHandle, playbackSpeed);
             } else {
-                soundManager->setPlaybackSpeed("timeline_song", originalPlaybackSpeed);
+                soundManager->setPlaybackSpeed(songHandle, originalPlaybackSpeed);
             }
         }
     }
@@ -909,13 +945,13 @@ void Editor::handleKeyboardInput() {
         if (ImGui::IsKeyPressed(ImGuiKey_Equal) || ImGui::IsKeyPressed(ImGuiKey_KeypadAdd)) {
             playbackSpeed = std::min(2.0f, playbackSpeed + 0.1f);
             if (soundManager && isSongLoaded) {
-                soundManager->setPlaybackSpeed("timeline_song", playbackSpeed);
+                soundManager->setPlaybackSpeed(songHandle, playbackSpeed);
             }
         }
         if (ImGui::IsKeyPressed(ImGuiKey_Minus) || ImGui::IsKeyPressed(ImGuiKey_KeypadSubtract)) {
             playbackSpeed = std::max(0.1f, playbackSpeed - 0.1f);
             if (soundManager && isSongLoaded) {
-                soundManager->setPlaybackSpeed("timeline_song", playbackSpeed);
+                soundManager->setPlaybackSpeed(songHandle, playbackSpeed);
             }
         }
     }
@@ -939,12 +975,7 @@ void Editor::handleKeyboardInput() {
     if (ImGui::IsKeyPressed(ImGuiKey_M) && !ImGui::GetIO().KeyCtrl) {
         metronomeEnabled = !metronomeEnabled;
         if (metronomeEnabled && soundManager) {
-            if (!soundManager->isSoundLoaded("metronome1")) {
-                soundManager->loadSound("metronome1", "assets/metronome1.wav");
-            }
-            if (!soundManager->isSoundLoaded("metronome2")) {
-                soundManager->loadSound("metronome2", "assets/metronome2.wav");
-            }
+            loadMetronomeSounds();
             metronomeBeatCount = 0;
             metronomeSound1 = true;
         }
@@ -998,6 +1029,9 @@ void Editor::handleKeyboardInput() {
     if (ImGui::IsKeyPressed(ImGuiKey_W)) {
         showWaveform = !showWaveform;
     }
+    if (ImGui::IsKeyPressed(ImGuiKey_R)) {
+        showSpectrogram = !showSpectrogram;
+    }
 
     if (ImGui::IsKeyPressed(ImGuiKey_KeypadAdd) && ImGui::GetIO().KeyCtrl) {
         zoomLevel = std::min(maxZoomLevel, zoomLevel * 1.2f);
@@ -1030,14 +1064,14 @@ void Editor::handleKeyboardInput() {
 
     if (ImGui::IsKeyPressed(ImGuiKey_LeftArrow)) {
         double newPosition = std::max(0.0, currentPosition - seekAmount);
-        if (soundManager->seekTo("timeline_song", newPosition)) {
+        if (soundManager->seekTo(songHandle, newPosition)) {
             currentPosition = newPosition;
         }
     }
 
     if (ImGui::IsKeyPressed(ImGuiKey_RightArrow)) {
         double newPosition = std::min(songDuration, currentPosition + seekAmount);
-        if (soundManager->seekTo("timeline_song", newPosition)) {
+        if (soundManager->seekTo(songHandle, newPosition)) {
             currentPosition = newPosition;
         }
     }
@@ -1045,8 +1079,7 @@ void Editor::handleKeyboardInput() {
     if (ImGui::IsKeyPressed(ImGuiKey_F)) {
         double snapped = currentPosition;
         if (shouldSnap()) {
-            float snapSpacing = getSnapSpacing();
-            snapped = std::round(currentPosition / snapSpacing) * snapSpacing;
+            snapped = snapTime(currentPosition);
         }
 
         snapped = std::clamp(snapped, 0.0, songDuration);
@@ -1067,8 +1100,7 @@ void Editor::handleKeyboardInput() {
     if (ImGui::IsKeyPressed(ImGuiKey_J)) {
         double snapped = currentPosition;
         if (shouldSnap()) {
-            float snapSpacing = getSnapSpacing();
-            snapped = std::round(currentPosition / snapSpacing) * snapSpacing;
+            snapped = snapTime(currentPosition);
         }
 
         snapped = std::clamp(snapped, 0.0, songDuration);
@@ -1149,14 +1181,14 @@ void Editor::drawTimelineGrid() {
     float visible_start = scrollOffset;
     float visible_end = visible_start + visible_duration;
 
-    float first_grid_line = std::floor(visible_start / gridSpacing) * gridSpacing;
+    float first_grid_line = gridOffset + std::floor((visible_start - gridOffset) / gridSpacing) * gridSpacing;
 
     if (showSubGrid && subGridDivisions > 1) {
         float subGridSpacing = gridSpacing / subGridDivisions;
-        float first_sub_grid_line = std::floor(visible_start / subGridSpacing) * subGridSpacing;
+        float first_sub_grid_line = gridOffset + std::floor((visible_start - gridOffset) / subGridSpacing) * subGridSpacing;
 
         for (float time = first_sub_grid_line; time <= visible_end + subGridSpacing; time += subGridSpacing) {
-            if (std::fmod(time, gridSpacing) < 0.001f) continue;
+            if (std::fmod(std::abs(time - gridOffset), gridSpacing) < 0.001f) continue;
 
             float x = content_pos.x + (time - visible_start) * pixels_per_second;
 
@@ -1283,11 +1315,17 @@ void Editor::drawPlaybackCursor() {
 }
 
 void Editor::update() {
+    collectAnalysis();
     updatePlayback();
     updateMetronome();
     updateSpectrum();
     handleKeyboardInput();
     updateAutoscroll();
+
+    // Playback, analysis progress and smooth scrolling move without any input
+    if (isPlaying || isAnalyzing || scrollOffset != targetScrollOffset) {
+        Core::getFrameScheduler().requestAnimation();
+    }
 }
 
 void Editor::render() {
@@ -1340,10 +1378,10 @@ void Editor::drawControlsWindow() {
             if (ImGui::Button(isPlaying ? "Pause" : "Play", ImVec2(80, 30))) {
                 if (soundManager && isSongLoaded) {
                     if (isPlaying) {
-                        soundManager->pauseSound("timeline_song");
+                        soundManager->pauseSound(songHandle);
                         isPlaying = false;
                     } else {
-                        soundManager->resumeSound("timeline_song");
+                        soundManager->resumeSound(songHandle);
                         isPlaying = true;
                     }
                 }
@@ -1351,9 +1389,9 @@ void Editor::drawControlsWindow() {
             ImGui::SameLine();
             if (ImGui::Button("Stop", ImVec2(80, 30))) {
                 if (soundManager && isSongLoaded) {
-                    soundManager->stopSound("timeline_song");
+                    soundManager->stopSound(songHandle);
                     isPlaying = false;
-                    soundManager->setPosition("timeline_song", 0.0);
+                    soundManager->setPosition(songHandle, 0.0);
                     currentPosition = 0.0;
                     scrollOffset = 0.0f;
                     targetScrollOffset = 0.0f;
@@ -1372,10 +1410,10 @@ void Editor::drawControlsWindow() {
                 speedOverrideEnabled = !speedOverrideEnabled;
                 if (soundManager && isSongLoaded) {
                     if (speedOverrideEnabled) {
-                        originalPlaybackSpeed = soundManager->getCurrentPlaybackSpeed("timeline_song");
-                        soundManager->setPlaybackSpeed("timeline_song", playbackSpeed);
+                        originalPlaybackSpeed = soundManager->getCurrentPlaybackSpeed(songHandle);
+                        soundManager->setPlaybackSpeed(songHandle, playbackSpeed);
                     } else {
-                        soundManager->setPlaybackSpeed("timeline_song", originalPlaybackSpeed);
+                        soundManager->setPlaybackSpeed(songHandle, originalPlaybackSpeed);
                     }
                 }
             }
@@ -1383,11 +1421,11 @@ void Editor::drawControlsWindow() {
             ImGui::TextColored(ImVec4(0.7f, 0.7f, 0.7f, 1.0f), "(S to toggle)");
 
             if (speedOverrideEnabled) {
-                float currentSpeed = soundManager ? soundManager->getCurrentPlaybackSpeed("timeline_song") : playbackSpeed;
+                float currentSpeed = soundManager ? soundManager->getCurrentPlaybackSpeed(songHandle) : playbackSpeed;
                 ImGui::Text("Current Speed: %.2fx", currentSpeed);
                 if (ImGui::SliderFloat("##playbackSpeed", &playbackSpeed, 0.1f, 2.0f, "%.2fx")) {
                     if (soundManager && isSongLoaded) {
-                        soundManager->setPlaybackSpeed("timeline_song", playbackSpeed);
+                        soundManager->setPlaybackSpeed(songHandle, playbackSpeed);
                     }
                 }
                 ImGui::TextColored(ImVec4(0.7f, 0.7f, 0.7f, 1.0f), "(+/- keys to adjust)");
@@ -1405,12 +1443,7 @@ void Editor::drawControlsWindow() {
 
             if (ImGui::Checkbox("Enable Metronome", &metronomeEnabled)) {
                 if (metronomeEnabled && soundManager) {
-                    if (!soundManager->isSoundLoaded("metronome1")) {
-                        soundManager->loadSound("metronome1", "assets/metronome1.wav");
-                    }
-                    if (!soundManager->isSoundLoaded("metronome2")) {
-                        soundManager->loadSound("metronome2", "assets/metronome2.wav");
-                    }
+                    loadMetronomeSounds();
                     lastMetronomeBeat = 0.0;
                     metronomeBeatCount = 0;
                     metronomeSound1 = true;
@@ -1515,6 +1548,8 @@ void Editor::drawControlsWindow() {
             ImGui::Checkbox("Show milliseconds (M)", &showMilliseconds);
             ImGui::SameLine();
             ImGui::Checkbox("Show Waveform (W)", &showWaveform);
+            ImGui::SameLine();
+            ImGui::Checkbox("Show Spectrogram (R)", &showSpectrogram);
 
             ImGui::Spacing();
 
@@ -1542,7 +1577,7 @@ void Editor::drawControlsWindow() {
 
             if (isSongLoaded && !isAnalyzing && !waveformLoaded) {
                 if (ImGui::Button("Generate Waveform", ImVec2(160, 25))) {
-                    analyzeAudioFile(currentSongPath);
+                    analyzeAudioFile(currentSongSource);
                 }
             } else if (isAnalyzing) {
                 ImGui::BeginDisabled();
@@ -1550,7 +1585,7 @@ void Editor::drawControlsWindow() {
                 ImGui::EndDisabled();
             } else if (waveformLoaded) {
                 if (ImGui::Button("Regenerate Waveform", ImVec2(160, 25))) {
-                    analyzeAudioFile(currentSongPath);
+                    analyzeAudioFile(currentSongSource);
                 }
             } else {
                 ImGui::BeginDisabled();
@@ -1581,6 +1616,21 @@ void Editor::drawControlsWindow() {
                 showBpmFinder = true;
             }
 
+            ImGui::Text("Grid Offset:");
+            ImGui::SameLine();
+            if (ImGui::InputFloat("##gridOffset", &gridOffset, 0.001f, 0.01f, "%.3fs", ImGuiInputTextFlags_CharsDecimal)) {
+                gridOffset = std::max(0.0f, gridOffset);
+            }
+
+            if (detectedTempo.bpm > 0.0) {
+                ImGui::TextColored(ImVec4(0.7f, 0.7f, 0.7f, 1.0f), "Detected: %.2f BPM, first beat at %.3fs (confidence %.1f)",
+                                   detectedTempo.bpm, detectedTempo.offset, detectedTempo.confidence);
+                ImGui::SameLine();
+                if (ImGui::Button("Apply Detected", ImVec2(120, 20))) {
+                    applyDetectedTempo();
+                }
+            }
+
             if (showSubGrid) {
                 ImGui::Text("Sub-Grid Divisions:");
                 ImGui::SameLine();
@@ -1638,7 +1688,7 @@ void Editor::drawControlsWindow() {
                 ImGui::Text("Song Duration: %.2fs", songDuration);
                 ImGui::Text("Current Position: %.2fs", currentPosition);
                 ImGui::Text("Status: %s", isPlaying ? "Playing" : "Paused");
-                ImGui::Text("Total Notes: %zu", nodeManager.getNotes().size());
+                ImGui::Text("Total Notes: %zu", nodeManager.getNoteCount());
                 ImGui::Text("Selected Note: %s", selectedNoteId == -1 ? "None" : std::to_string(selectedNoteId).c_str());
 
                 ImGui::Spacing();
@@ -1703,7 +1753,14 @@ void Editor::drawTimelineWindow() {
         }
     }
 
+    if (!waveformTilesValid) {
+        waveformTiles.clear();
+        spectrogramTiles.clear();
+        waveformTilesValid = true;
+    }
+
     drawTimelineGrid();
+    drawSpectrogram();
     drawWaveform();
     drawTimelineLanes();
     handleNotePlacementAndInteraction();
@@ -2068,7 +2125,7 @@ void Editor::drawNotesList() {
 
     ImGui::Begin("Notes List", &showNotesList, ImGuiWindowFlags_AlwaysAutoResize);
 
-    ImGui::Text("Notes (%zu total)", nodeManager.getNotes().size());
+    ImGui::Text("Notes (%zu total)", nodeManager.getNoteCount());
     ImGui::Separator();
 
     ImGui::Text("Sort by:");
@@ -2092,8 +2149,10 @@ void Editor::drawNotesList() {
 
     if (ImGui::Button("Select All")) {
         selectedNoteIds.clear();
-        for (const auto& note : nodeManager.getNotes()) {
-            selectedNoteIds.push_back(note.id);
+        std::vector<const Core::Note*> notes;
+        nodeManager.getAllNotes(notes);
+        for (const Core::Note* note : notes) {
+            selectedNoteIds.push_back(note->id);
         }
     }
     ImGui::SameLine();
@@ -2128,54 +2187,67 @@ void Editor::drawNotesList() {
         ImGui::TableSetupColumn("Actions");
         ImGui::TableHeadersRow();
 
-        for (const auto& note : nodeManager.getNotes()) {
-            ImGui::TableNextRow();
+        if (noteListRevision != nodeManager.getRevision() || noteListSortOrder != sortOrder) {
+            sortNotes();
+        }
 
-            ImGui::TableSetColumnIndex(0);
-            bool isSelected = std::find(selectedNoteIds.begin(), selectedNoteIds.end(), note.id) != selectedNoteIds.end();
-            if (ImGui::Checkbox(("##select" + std::to_string(note.id)).c_str(), &isSelected)) {
-                if (isSelected) {
-                    selectedNoteIds.push_back(note.id);
-                } else {
-                    selectedNoteIds.erase(std::remove(selectedNoteIds.begin(), selectedNoteIds.end(), note.id), selectedNoteIds.end());
+        // Only the rows that are scrolled into view are submitted
+        ImGuiListClipper clipper;
+        clipper.Begin(static_cast<int>(noteListView.size()));
+        bool listModified = false;
+        while (!listModified && clipper.Step()) {
+            for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row) {
+                const Core::Note& note = *noteListView[row];
+                ImGui::TableNextRow();
+
+                ImGui::TableSetColumnIndex(0);
+                bool isSelected = std::find(selectedNoteIds.begin(), selectedNoteIds.end(), note.id) != selectedNoteIds.end();
+                if (ImGui::Checkbox(("##select" + std::to_string(note.id)).c_str(), &isSelected)) {
+                    if (isSelected) {
+                        selectedNoteIds.push_back(note.id);
+                    } else {
+                        selectedNoteIds.erase(std::remove(selectedNoteIds.begin(), selectedNoteIds.end(), note.id), selectedNoteIds.end());
+                    }
                 }
-            }
 
-            ImGui::TableSetColumnIndex(1);
-            ImGui::Text("%d", note.id);
+                ImGui::TableSetColumnIndex(1);
+                ImGui::Text("%d", note.id);
 
-            ImGui::TableSetColumnIndex(2);
-            ImGui::Text("%s", note.type == Core::NoteType::HOLD ? "HOLD" : "TAP");
+                ImGui::TableSetColumnIndex(2);
+                ImGui::Text("%s", note.type == Core::NoteType::HOLD ? "HOLD" : "TAP");
 
-            ImGui::TableSetColumnIndex(3);
-            ImGui::Text("%s", note.lane == Core::Lane::TOP ? "Top" : "Bottom");
+                ImGui::TableSetColumnIndex(3);
+                ImGui::Text("%s", note.lane == Core::Lane::TOP ? "Top" : "Bottom");
 
-            ImGui::TableSetColumnIndex(4);
-            if (note.type == Core::NoteType::HOLD) {
-                int start_min = (int)note.timestamp / 60;
-                int start_sec = (int)note.timestamp % 60;
-                int start_cs = (int)((note.timestamp - (int)note.timestamp) * 100);
-                int end_min = (int)note.endTimestamp / 60;
-                int end_sec = (int)note.endTimestamp % 60;
-                int end_cs = (int)((note.endTimestamp - (int)note.endTimestamp) * 100);
-                ImGui::Text("%d:%02d.%02d - %d:%02d.%02d", start_min, start_sec, start_cs, end_min, end_sec, end_cs);
-            } else {
-                int minutes = (int)note.timestamp / 60;
-                int seconds = (int)note.timestamp % 60;
-                int centiseconds = (int)((note.timestamp - (int)note.timestamp) * 100);
-                ImGui::Text("%d:%02d.%02d", minutes, seconds, centiseconds);
-            }
+                ImGui::TableSetColumnIndex(4);
+                if (note.type == Core::NoteType::HOLD) {
+                    int start_min = (int)note.timestamp / 60;
+                    int start_sec = (int)note.timestamp % 60;
+                    int start_cs = (int)((note.timestamp - (int)note.timestamp) * 100);
+                    int end_min = (int)note.endTimestamp / 60;
+                    int end_sec = (int)note.endTimestamp % 60;
+                    int end_cs = (int)((note.endTimestamp - (int)note.endTimestamp) * 100);
+                    ImGui::Text("%d:%02d.%02d - %d:%02d.%02d", start_min, start_sec, start_cs, end_min, end_sec, end_cs);
+                } else {
+                    int minutes = (int)note.timestamp / 60;
+                    int seconds = (int)note.timestamp % 60;
+                    int centiseconds = (int)((note.timestamp - (int)note.timestamp) * 100);
+                    ImGui::Text("%d:%02d.%02d", minutes, seconds, centiseconds);
+                }
 
-            ImGui::TableSetColumnIndex(5);
-            if (ImGui::Button(("Select##" + std::to_string(note.id)).c_str())) {
-                selectedNoteId = note.id;
-            }
-            ImGui::SameLine();
-            if (ImGui::Button(("Delete##" + std::to_string(note.id)).c_str())) {
-                nodeManager.removeNote(note.id);
-                selectedNoteIds.erase(std::remove(selectedNoteIds.begin(), selectedNoteIds.end(), note.id), selectedNoteIds.end());
-                if (selectedNoteId == note.id) selectedNoteId = -1;
-                break;
+                ImGui::TableSetColumnIndex(5);
+                if (ImGui::Button(("Select##" + std::to_string(note.id)).c_str())) {
+                    selectedNoteId = note.id;
+                }
+                ImGui::SameLine();
+                if (ImGui::Button(("Delete##" + std::to_string(note.id)).c_str())) {
+                    int removedId = note.id;
+                    nodeManager.removeNote(removedId);
+                    selectedNoteIds.erase(std::remove(selectedNoteIds.begin(), selectedNoteIds.end(), removedId), selectedNoteIds.end());
+                    if (selectedNoteId == removedId) selectedNoteId = -1;
+                    listModified = true;
+                    break;
+                }
             }
         }
 
@@ -2187,7 +2259,7 @@ void Editor::drawNotesList() {
 
 void Editor::jumpToPosition(Core::Note* note) {
     currentPosition = note->timestamp;
-    soundManager->seekTo("timeline_song", currentPosition);
+    soundManager->seekTo(songHandle, currentPosition);
 
     float visible_duration = songDuration / zoomLevel;
     float visible_start = scrollOffset;
@@ -2216,10 +2288,12 @@ void Editor::drawPropertiesPanel() {
             ImGui::Text("Lane:");
             if (ImGui::RadioButton("Top", selectedNote->lane == Core::Lane::TOP)) {
                 nodeManager.moveNote(selectedNote->id, 0, selectedNote->timestamp);
+                selectedNote = nodeManager.getNoteById(selectedNoteId);
             }
             ImGui::SameLine();
             if (ImGui::RadioButton("Bottom", selectedNote->lane == Core::Lane::BOTTOM)) {
                 nodeManager.moveNote(selectedNote->id, 1, selectedNote->timestamp);
+                selectedNote = nodeManager.getNoteById(selectedNoteId);
             }
 
             ImGui::Text("Note Type:");
@@ -2251,8 +2325,7 @@ void Editor::drawPropertiesPanel() {
                 if (ImGui::InputFloat("##startTime", &startTimeValue, 0.1f, 1.0f, "%.3f")) {
                     double newStartTime = std::clamp(static_cast<double>(startTimeValue), 0.0, selectedNote->endTimestamp);
                     if (shouldSnap()) {
-                        float snapSpacing = getSnapSpacing();
-                        newStartTime = std::round(newStartTime / snapSpacing) * snapSpacing;
+                        newStartTime = snapTime(newStartTime);
                     }
                     nodeManager.moveHoldNote(selectedNote->id, selectedNote->lane, newStartTime, selectedNote->endTimestamp);
                     selectedNote = nodeManager.getNoteById(selectedNoteId);
@@ -2263,8 +2336,7 @@ void Editor::drawPropertiesPanel() {
                 if (ImGui::InputFloat("##endTime", &endTimeValue, 0.1f, 1.0f, "%.3f")) {
                     double newEndTime = std::clamp(static_cast<double>(endTimeValue), selectedNote->timestamp, songDuration);
                     if (shouldSnap()) {
-                        float snapSpacing = getSnapSpacing();
-                        newEndTime = std::round(newEndTime / snapSpacing) * snapSpacing;
+                        newEndTime = snapTime(newEndTime);
                     }
                     nodeManager.moveHoldNote(selectedNote->id, selectedNote->lane, selectedNote->timestamp, newEndTime);
                     selectedNote = nodeManager.getNoteById(selectedNoteId);
@@ -2277,8 +2349,7 @@ void Editor::drawPropertiesPanel() {
                     double newEndTime = selectedNote->timestamp + static_cast<double>(duration);
                     newEndTime = std::clamp(newEndTime, selectedNote->timestamp, songDuration);
                     if (shouldSnap()) {
-                        float snapSpacing = getSnapSpacing();
-                        newEndTime = std::round(newEndTime / snapSpacing) * snapSpacing;
+                        newEndTime = snapTime(newEndTime);
                     }
                     nodeManager.moveHoldNote(selectedNote->id, selectedNote->lane, selectedNote->timestamp, newEndTime);
                     selectedNote = nodeManager.getNoteById(selectedNoteId);
@@ -2305,8 +2376,7 @@ void Editor::drawPropertiesPanel() {
                 if (ImGui::InputFloat("##time", &timeValue, 0.1f, 1.0f, "%.3f")) {
                     double newTime = std::clamp(static_cast<double>(timeValue), 0.0, songDuration);
                     if (shouldSnap()) {
-                        float snapSpacing = getSnapSpacing();
-                        newTime = std::round(newTime / snapSpacing) * snapSpacing;
+                        newTime = snapTime(newTime);
                     }
                     nodeManager.moveNote(selectedNote->id, selectedNote->lane, newTime);
                     // Refresh the note pointer after modification
@@ -2345,134 +2415,193 @@ void Editor::drawPropertiesPanel() {
 }
 
 void Editor::sortNotes() {
-    std::vector<Core::Note>& notes = nodeManager.getNotes();
+    // NodeManager hands the notes out in time order; the list shows a sorted view of them
+    nodeManager.getAllNotes(noteListView);
 
     switch (sortOrder) {
         case SortOrder::TIME:
-            std::sort(notes.begin(), notes.end(), [](const Core::Note& a, const Core::Note& b) {
-                return a.timestamp < b.timestamp;
-            });
             break;
         case SortOrder::LANE:
-            std::sort(notes.begin(), notes.end(), [](const Core::Note& a, const Core::Note& b) {
-                if (a.lane != b.lane) return a.lane < b.lane;
-                return a.timestamp < b.timestamp;
+            std::stable_sort(noteListView.begin(), noteListView.end(), [](const Core::Note* a, const Core::Note* b) {
+                return a->lane < b->lane;
             });
             break;
         case SortOrder::ID:
-            std::sort(notes.begin(), notes.end(), [](const Core::Note& a, const Core::Note& b) {
-                return a.id < b.id;
+            std::sort(noteListView.begin(), noteListView.end(), [](const Core::Note* a, const Core::Note* b) {
+                return a->id < b->id;
             });
             break;
     }
+
+    noteListRevision = nodeManager.getRevision();
+    noteListSortOrder = sortOrder;
 }
 
 bool Editor::saveChartFile(const std::string& filepath) {
-    if (!isSongLoaded || currentSongPath.empty()) {
+    if (!isSongLoaded || currentSongSource.empty()) {
         std::cerr << "No song loaded to save" << std::endl;
         return false;
     }
 
-    std::vector<char> audioData = readAudioFile(currentSongPath);
-    if (audioData.empty()) {
-        std::cerr << "Failed to read audio file: " << currentSongPath << std::endl;
+    std::vector<const Core::Note*> notes;
+    nodeManager.getAllNotes(notes);
+    std::vector<char> analysisData;
+    if (waveformLoaded && !isAnalyzing) {
+        analysisData = AnalysisCache::serialize(waveformData);
+    }
+
+    // Layout: header, section directory, notes, analysis, audio; sections are 8-byte aligned
+    auto align = [](uint64_t offset) { return (offset + 7) & ~static_cast<uint64_t>(7); };
+    std::vector<ChartSection> sections;
+    uint64_t offset = sizeof(ChartHeader) + (analysisData.empty() ? 2 : 3) * sizeof(ChartSection);
+
+    offset = align(offset);
+    sections.push_back({CHART_SECTION_NOTES, 0, offset, notes.size() * sizeof(ChartNoteRecord)});
+    offset += sections.back().size;
+
+    if (!analysisData.empty()) {
+        offset = align(offset);
+        sections.push_back({CHART_SECTION_ANALYSIS, 0, offset, analysisData.size()});
+        offset += sections.back().size;
+    }
+
+    offset = align(offset);
+    uint64_t audioOffset = offset;
+
+    // The whole file is assembled in memory and written at once; the audio is read straight into place
+    std::vector<char> buffer(audioOffset, 0);
+    if (!readAudioFile(currentSongSource, buffer)) {
+        std::cerr << "Failed to read audio file: " << currentSongSource.path << std::endl;
         return false;
     }
+    uint64_t audioSize = buffer.size() - audioOffset;
+    sections.push_back({CHART_SECTION_AUDIO, 0, audioOffset, audioSize});
 
     ChartHeader header;
     memset(&header, 0, sizeof(ChartHeader));
     strcpy(header.magic, "NOTARHYTHM");
-    header.version = 2; // Updated version for TAP/HOLD support
+    header.version = CHART_FORMAT_VERSION;
     header.headerSize = sizeof(ChartHeader);
-    header.audioSize = static_cast<uint32_t>(audioData.size());
-    header.notesCount = static_cast<uint32_t>(nodeManager.getNotes().size());
+    header.audioSize = static_cast<uint32_t>(audioSize);
+    header.notesCount = static_cast<uint32_t>(notes.size());
     header.bpm = bpm;
+    header.gridOffset = gridOffset;
     header.duration = songDuration;
+    header.sectionCount = static_cast<uint32_t>(sections.size());
 
     strncpy(header.title, chartTitle.c_str(), sizeof(header.title) - 1);
     strncpy(header.artist, chartArtist.c_str(), sizeof(header.artist) - 1);
 
-    std::ofstream file(filepath, std::ios::binary);
+    memcpy(buffer.data(), &header, sizeof(ChartHeader));
+    memcpy(buffer.data() + sizeof(ChartHeader), sections.data(), sections.size() * sizeof(ChartSection));
+
+    ChartNoteRecord* records = reinterpret_cast<ChartNoteRecord*>(buffer.data() + sections[0].offset);
+    for (size_t i = 0; i < notes.size(); ++i) {
+        records[i].id = notes[i]->id;
+        records[i].lane = static_cast<uint8_t>(notes[i]->lane);
+        records[i].type = static_cast<uint8_t>(notes[i]->type);
+        records[i].reserved = 0;
+        records[i].timestamp = notes[i]->timestamp;
+        records[i].endTimestamp = notes[i]->endTimestamp;
+    }
+
+    if (!analysisData.empty()) {
+        memcpy(buffer.data() + sections[1].offset, analysisData.data(), analysisData.size());
+    }
+
+    // Write next to the target and rename, so a chart that is being streamed from is never truncated
+    std::string tempPath = filepath + ".tmp";
+    std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
     if (!file.is_open()) {
         std::cerr << "Failed to create chart file: " << filepath << std::endl;
         return false;
     }
 
-    file.write(reinterpret_cast<const char*>(&header), sizeof(ChartHeader));
+    file.write(buffer.data(), buffer.size());
+    file.close();
     if (!file.good()) {
-        std::cerr << "Failed to write header" << std::endl;
+        std::cerr << "Failed to write chart file: " << filepath << std::endl;
+        std::error_code removeError;
+        std::filesystem::remove(tempPath, removeError);
         return false;
     }
 
-    file.write(audioData.data(), audioData.size());
-    if (!file.good()) {
-        std::cerr << "Failed to write audio data" << std::endl;
-        return false;
+    // BASS holds the chart open while the timeline streams from it, which blocks the replace on Windows
+    bool streamsFromTarget = currentSongSource.path == filepath;
+    bool wasPlaying = isPlaying;
+    double position = currentPosition;
+    if (streamsFromTarget) {
+        soundManager->stopSound(songHandle);
+        soundManager->unloadSound(songHandle);
+    }
+
+    std::error_code error;
+    std::filesystem::rename(tempPath, filepath, error);
+    if (error) {
+        std::cerr << "Failed to replace chart file: " << error.message() << std::endl;
+        std::error_code removeError;
+        std::filesystem::remove(tempPath, removeError);
+    } else if (streamsFromTarget) {
+        // The song now lives at a different offset of the rewritten chart
+        currentSongSource = AudioSource(filepath, audioOffset, audioSize);
+        if (audioAnalyzer) {
+            audioAnalyzer->clearAudioCache();
+        }
     }
 
-    for (const auto& note : nodeManager.getNotes()) {
-        file.write(reinterpret_cast<const char*>(&note.id), sizeof(note.id));
-        file.write(reinterpret_cast<const char*>(&note.lane), sizeof(note.lane));
-        file.write(reinterpret_cast<const char*>(&note.type), sizeof(note.type));
-        file.write(reinterpret_cast<const char*>(&note.timestamp), sizeof(note.timestamp));
-        file.write(reinterpret_cast<const char*>(&note.endTimestamp), sizeof(note.endTimestamp));
+    if (streamsFromTarget) {
+        reopenSong(position, wasPlaying);
     }
 
-    file.close();
-    return true;
+    return !error;
 }
 
-bool Editor::loadChartFile(const std::string& filepath) {
-    std::ifstream file(filepath, std::ios::binary);
-    if (!file.is_open()) {
-        std::cerr << "Failed to open chart file: " << filepath << std::endl;
-        return false;
-    }
-
-    ChartHeader header;
-    file.read(reinterpret_cast<char*>(&header), sizeof(ChartHeader));
-    if (!file.good()) {
-        std::cerr << "Failed to read chart header" << std::endl;
-        return false;
-    }
-
-    if (strcmp(header.magic, "NOTARHYTHM") != 0) {
-        std::cerr << "Invalid chart file format - wrong magic number: " << header.magic << std::endl;
-        return false;
+void Editor::reopenSong(double position, bool resume) {
+    songHandle = soundManager->loadSoundFromFile("timeline_song", currentSongSource.path, currentSongSource.offset, currentSongSource.length);
+    if (!songHandle) {
+        std::cerr << "Failed to reopen song: " << currentSongSource.path << std::endl;
+        isSongLoaded = false;
+        isPlaying = false;
+        return;
     }
 
-    if (header.version < 1 || header.version > 2) {
-        std::cerr << "Unsupported chart file version: " << header.version << std::endl;
-        return false;
+    soundManager->seekTo(songHandle, position);
+    if (speedOverrideEnabled) {
+        soundManager->setPlaybackSpeed(songHandle, playbackSpeed);
     }
+    isPlaying = resume && soundManager->resumeSound(songHandle);
+}
 
-    std::vector<char> audioData(header.audioSize);
-    file.read(audioData.data(), header.audioSize);
-    if (!file.good()) {
-        std::cerr << "Failed to read audio data" << std::endl;
+bool Editor::loadChartFile(const std::string& filepath) {
+    ChartFile chart;
+    if (!chart.open(filepath)) {
+        std::cerr << chart.getLastError() << std::endl;
         return false;
     }
 
-    std::filesystem::path chartPath(filepath);
-    std::string tempAudioPath = chartPath.parent_path().string() + "/temp_audio_" + chartPath.stem().string() + ".wav";
-    if (!writeAudioFile(tempAudioPath, audioData)) {
-        std::cerr << "Failed to write temporary audio file: " << tempAudioPath << std::endl;
+    const ChartHeader& header = chart.getHeader();
+    if (chart.getAudioSize() == 0) {
+        std::cerr << "Chart has no embedded audio" << std::endl;
         return false;
     }
 
-    if (!soundManager->loadSound("timeline_song", tempAudioPath)) {
+    // The embedded audio is played and analyzed in place; the chart stays
+    // unmapped afterwards so it can be saved over
+    AudioSource chartAudio(filepath, chart.getAudioOffset(), chart.getAudioSize());
+    songHandle = soundManager->loadSoundFromFile("timeline_song", chartAudio.path, chartAudio.offset, chartAudio.length);
+    if (!songHandle) {
         std::cerr << "Failed to load audio from chart" << std::endl;
-        std::filesystem::remove(tempAudioPath);
         return false;
     }
 
-    currentSongPath = tempAudioPath;
+    currentSongSource = chartAudio;
     currentSongName = header.title;
     isSongLoaded = true;
     currentPosition = 0.0;
     isPlaying = false;
     songDuration = header.duration;
     bpm = header.bpm;
+    gridOffset = std::max(0.0f, header.gridOffset);
     chartTitle = header.title;
     chartArtist = header.artist;
 
@@ -2481,61 +2610,58 @@ bool Editor::loadChartFile(const std::string& filepath) {
     hoveredNoteId = -1;
     selectedNoteIds.clear();
 
-    for (uint32_t i = 0; i < header.notesCount; ++i) {
-        int id;
-        Core::Lane lane;
-        Core::NoteType type;
-        double timestamp;
-        double endTimestamp;
-
-        file.read(reinterpret_cast<char*>(&id), sizeof(id));
-        file.read(reinterpret_cast<char*>(&lane), sizeof(lane));
-
-        if (header.version >= 2) {
-            file.read(reinterpret_cast<char*>(&type), sizeof(type));
-            file.read(reinterpret_cast<char*>(&timestamp), sizeof(timestamp));
-            file.read(reinterpret_cast<char*>(&endTimestamp), sizeof(endTimestamp));
+    // Charts saved with an analysis section show their waveform without re-analyzing
+    if (chart.getAnalysisData() && audioAnalyzer && !isAnalyzing) {
+        AudioWaveform storedWaveform;
+        if (AnalysisCache::deserialize(reinterpret_cast<const char*>(chart.getAnalysisData()), chart.getAnalysisSize(), storedWaveform)) {
+            waveformData = std::move(storedWaveform);
+            waveformLoaded = true;
+            waveformTilesValid = false;
         } else {
-            // Version 1 compatibility - all notes are TAP notes
-            type = Core::NoteType::TAP;
-            file.read(reinterpret_cast<char*>(&timestamp), sizeof(timestamp));
-            endTimestamp = timestamp;
-        }
-
-        if (!file.good()) {
-            std::cerr << "Failed to read note " << i << std::endl;
-            break;
+            waveformLoaded = false;
         }
+    }
 
-        if (type == Core::NoteType::HOLD) {
-            nodeManager.addHoldNoteWithId(id, static_cast<int>(lane), timestamp, endTimestamp);
+    for (size_t i = 0; i < chart.getNoteCount(); ++i) {
+        Core::Note note = chart.getNote(i);
+        if (note.type == Core::NoteType::HOLD) {
+            nodeManager.addHoldNoteWithId(note.id, static_cast<int>(note.lane), note.timestamp, note.endTimestamp);
         } else {
-            nodeManager.addNoteWithId(id, static_cast<int>(lane), timestamp);
+            nodeManager.addNoteWithId(note.id, static_cast<int>(note.lane), note.timestamp);
         }
     }
 
-    file.close();
     calculateGridSpacing();
 
     return true;
 }
 
-std::vector<char> Editor::readAudioFile(const std::string& filepath) {
-    std::ifstream file(filepath, std::ios::binary);
+bool Editor::readAudioFile(const AudioSource& source, std::vector<char>& buffer) {
+    std::ifstream file(source.path, std::ios::binary);
     if (!file.is_open()) {
-        std::cerr << "Failed to open audio file: " << filepath << std::endl;
-        return {};
+        std::cerr << "Failed to open audio file: " << source.path << std::endl;
+        return false;
     }
 
     file.seekg(0, std::ios::end);
-    std::streamsize size = file.tellg();
-    file.seekg(0, std::ios::beg);
+    std::streamsize fileSize = file.tellg();
+    std::streamsize offset = static_cast<std::streamsize>(source.offset);
+    std::streamsize size = source.length ? static_cast<std::streamsize>(source.length) : fileSize - offset;
+    if (offset < 0 || size <= 0 || offset + size > fileSize) {
+        std::cerr << "Audio section lies outside of " << source.path << std::endl;
+        return false;
+    }
+    file.seekg(offset, std::ios::beg);
 
-    std::vector<char> buffer(size);
-    file.read(buffer.data(), size);
-    file.close();
+    // Appended so callers can read straight into a larger output buffer
+    size_t start = buffer.size();
+    buffer.resize(start + static_cast<size_t>(size));
+    if (!file.read(buffer.data() + start, size)) {
+        buffer.resize(start);
+        return false;
+    }
 
-    return buffer;
+    return true;
 }
 
 bool Editor::writeAudioFile(const std::string& filepath, const std::vector<char>& audioData) {
@@ -2551,27 +2677,17 @@ bool Editor::writeAudioFile(const std::string& filepath, const std::vector<char>
 }
 
 void Editor::extractAudioFromChart(const std::string& chartPath, const std::string& outputPath) {
-    std::ifstream file(chartPath, std::ios::binary);
-    if (!file.is_open()) {
-        std::cerr << "Failed to open chart file: " << chartPath << std::endl;
-        return;
-    }
-
-    ChartHeader header;
-    file.read(reinterpret_cast<char*>(&header), sizeof(ChartHeader));
-    if (!file.good() || strcmp(header.magic, "NOTARHYTHM") != 0) {
-        std::cerr << "Invalid chart file format" << std::endl;
+    ChartFile chart;
+    if (!chart.open(chartPath)) {
+        std::cerr << chart.getLastError() << std::endl;
         return;
     }
 
-    std::vector<char> audioData(header.audioSize);
-    file.read(audioData.data(), header.audioSize);
-    file.close();
-
-    writeAudioFile(outputPath, audioData);
+    const char* audio = reinterpret_cast<const char*>(chart.getAudioData());
+    writeAudioFile(outputPath, std::vector<char>(audio, audio + chart.getAudioSize()));
 }
 
-void Editor::analyzeAudioFile(const std::string& filepath) {
+void Editor::analyzeAudioFile(const AudioSource& source) {
     if (!audioAnalyzer) return;
 
     waveformLoaded = false;
@@ -2583,25 +2699,68 @@ void Editor::analyzeAudioFile(const std::string& filepath) {
         this->onAnalysisProgress(progress);
     });
 
-    std::thread analysisThread([this, filepath]() {
-        try {
-            AudioWaveform localWaveformData = audioAnalyzer->analyzeAudio(filepath);
+    {
+        std::lock_guard<std::mutex> lock(analysisMutex);
+        analysisSlot = {source, analysisProgress, 0.0f, false, false, {}, {0.0, 0.0, 0.0}};
+    }
 
-            waveformData = std::move(localWaveformData);
-            waveformLoaded = true;
+    analysisPool->enqueue([this, source]() {
+        AudioWaveform localWaveformData;
+        TempoEstimate tempo = {0.0, 0.0, 0.0};
+        std::string failure;
+        try {
+            localWaveformData = audioAnalyzer->analyzeAudio(source);
+            tempo = TempoEstimator().estimate(localWaveformData.spectrogram);
         } catch (const std::exception& e) {
             std::cerr << "Waveform analysis failed: " << e.what() << std::endl;
-            analysisProgress = "Analysis failed: " + std::string(e.what());
+            failure = "Analysis failed: " + std::string(e.what());
         }
-        isAnalyzing = false;
-    });
 
-    analysisThread.detach();
+        std::lock_guard<std::mutex> lock(analysisMutex);
+        analysisSlot.finished = true;
+        analysisSlot.succeeded = failure.empty();
+        if (failure.empty()) {
+            analysisSlot.waveform = std::move(localWaveformData);
+            analysisSlot.tempo = tempo;
+        } else {
+            analysisSlot.stage = failure;
+        }
+    });
 }
 
 void Editor::onAnalysisProgress(const AnalysisProgress& progress) {
-    analysisProgress = progress.stage;
-    analysisProgressPercent = static_cast<float>(progress.progress);
+    // Called from the analysis job
+    std::lock_guard<std::mutex> lock(analysisMutex);
+    analysisSlot.stage = progress.stage;
+    analysisSlot.percent = static_cast<float>(progress.progress);
+}
+
+void Editor::collectAnalysis() {
+    if (!isAnalyzing) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(analysisMutex);
+    analysisProgress = analysisSlot.stage;
+    analysisProgressPercent = analysisSlot.percent;
+    if (!analysisSlot.finished) {
+        return;
+    }
+
+    // The spectrogram tiles read waveformData while drawing, so it is only replaced here
+    if (analysisSlot.succeeded && analysisSlot.source == currentSongSource) {
+        waveformData = std::move(analysisSlot.waveform);
+        waveformLoaded = true;
+        waveformTilesValid = false;
+
+        // Existing notes were placed on the current grid, only an empty chart follows the detection
+        detectedTempo = analysisSlot.tempo;
+        if (nodeManager.getNoteCount() == 0) {
+            applyDetectedTempo();
+        }
+    }
+    analysisSlot.finished = false;
+    isAnalyzing = false;
 }
 
 void Editor::drawWaveform() {
@@ -2638,31 +2797,10 @@ void Editor::drawWaveform() {
     float visible_duration = songDuration / zoomLevel;
     float visible_start = scrollOffset;
 
-    std::string resolutionLevel = "medium";
-    if (zoomLevel >= 10.0f) {
-        resolutionLevel = "high";
-    } else if (zoomLevel <= 2.0f) {
-        resolutionLevel = "low";
-    }
-
-    const std::vector<double>* waveform = &waveformData.data;
-    if (waveformData.levels.find(resolutionLevel) != waveformData.levels.end()) {
-        waveform = &waveformData.levels[resolutionLevel].peaks;
-    }
-
-    if (waveform->empty() || waveformData.duration <= 0.0) {
+    if (waveformData.duration <= 0.0) {
         return;
     }
 
-    double timePerSample = waveformData.duration / waveform->size();
-    size_t startIndex = static_cast<size_t>(visible_start / timePerSample);
-    size_t endIndex = static_cast<size_t>((visible_start + visible_duration) / timePerSample);
-
-    startIndex = std::min(startIndex, waveform->size() - 1);
-    endIndex = std::min(endIndex, waveform->size());
-
-    if (startIndex >= endIndex || startIndex >= waveform->size()) return;
-
     float waveformHeight = timelineHeight * 0.4f;
     float waveformY = timeline_y + (timelineHeight - waveformHeight) * 0.5f;
 
@@ -2672,44 +2810,11 @@ void Editor::drawWaveform() {
         IM_COL32(20, 20, 20, 80)
     );
 
-    float stepX = timelineWidth / (endIndex - startIndex);
-
-    for (size_t i = startIndex; i < endIndex - 1; ++i) {
-        float x1 = content_pos.x + (i - startIndex) * stepX;
-        float x2 = content_pos.x + (i + 1 - startIndex) * stepX;
-
-        float amplitude1 = static_cast<float>((*waveform)[i]) * waveformHeight * 0.45f * WAVEFORM_HEIGHT_MULTIPLIER;
-        float amplitude2 = static_cast<float>((*waveform)[i + 1]) * waveformHeight * 0.45f * WAVEFORM_HEIGHT_MULTIPLIER;
-
-        float y1 = waveformY + waveformHeight * 0.5f - amplitude1;
-        float y2 = waveformY + waveformHeight * 0.5f - amplitude2;
-
-        ImU32 waveformColor;
-        float intensity = (static_cast<float>((*waveform)[i]) + static_cast<float>((*waveform)[i + 1])) * 0.5f;
-        if (intensity > 0.8f) {
-            waveformColor = IM_COL32(255, 100, 100, 220); // Red for strong bass/rhythm
-        } else if (intensity > 0.6f) {
-            waveformColor = IM_COL32(255, 150, 100, 200); // Orange for medium intensity
-        } else if (intensity > 0.4f) {
-            waveformColor = IM_COL32(100, 200, 255, 180); // Blue for moderate intensity
-        } else {
-            waveformColor = IM_COL32(100, 150, 255, 150); // Light blue for low intensity
-        }
-
-        draw_list->AddLine(
-            ImVec2(x1, y1),
-            ImVec2(x2, y2),
-            waveformColor,
-            1.0f
-        );
-
-        draw_list->AddLine(
-            ImVec2(x1, waveformY + waveformHeight * 0.5f + amplitude1),
-            ImVec2(x2, waveformY + waveformHeight * 0.5f + amplitude2),
-            waveformColor,
-            1.0f
-        );
-    }
+    // One or two cached textured quads, whatever the zoom and scroll
+    waveformTiles.draw(draw_list, waveformData, visible_start, visible_duration,
+                       ImVec2(content_pos.x, waveformY),
+                       ImVec2(content_pos.x + timelineWidth, waveformY + waveformHeight),
+                       0.45f * WAVEFORM_HEIGHT_MULTIPLIER);
 
     draw_list->AddLine(
         ImVec2(content_pos.x, waveformY + waveformHeight * 0.5f),
@@ -2719,6 +2824,26 @@ void Editor::drawWaveform() {
     );
 }
 
+void Editor::drawSpectrogram() {
+    if (!showSpectrogram || !waveformLoaded || waveformData.spectrogram.empty()) {
+        return;
+    }
+
+    ImDrawList* draw_list = ImGui::GetWindowDrawList();
+    ImVec2 content_pos = ImGui::GetCursorScreenPos();
+    float timeline_y = content_pos.y + 30.0f;
+    float visible_duration = songDuration / zoomLevel;
+    float visible_start = scrollOffset;
+
+    // Spans both lanes, which are drawn over it; scrolling only moves textured quads
+    bool complete = spectrogramTiles.draw(draw_list, waveformData.spectrogram, visible_start, visible_duration,
+                                          ImVec2(content_pos.x, timeline_y),
+                                          ImVec2(content_pos.x + timelineWidth, timeline_y + timelineHeight));
+    if (!complete) {
+        Core::getFrameScheduler().requestAnimation();
+    }
+}
+
 void Editor::drawHelpWindow() {
     if (!showHelpWindow) return;
 
@@ -2753,6 +2878,7 @@ void Editor::drawHelpWindow() {
     ImGui::Text("I - Toggle note IDs");
     ImGui::Text("M - Toggle milliseconds");
     ImGui::Text("W - Toggle waveform");
+    ImGui::Text("R - Toggle spectrogram");
     ImGui::Text("Ctrl++/Ctrl+- - Zoom in/out");
     ImGui::Text("Ctrl+0 - Reset zoom");
 
@@ -2962,7 +3088,7 @@ void Editor::drawBpmFinder() {
                 lastTapTime = 0.0;
 
                 if (soundManager && isSongLoaded && !isPlaying) {
-                    soundManager->resumeSound("timeline_song");
+                    soundManager->resumeSound(songHandle);
                     isPlaying = true;
                 }
             }
@@ -2981,7 +3107,7 @@ void Editor::drawBpmFinder() {
                 bpmTapTimes.clear();
 
                 if (soundManager && isSongLoaded && isPlaying) {
-                    soundManager->pauseSound("timeline_song");
+                    soundManager->pauseSound(songHandle);
                     isPlaying = false;
                 }
             }
@@ -3037,7 +3163,7 @@ void Editor::drawBpmFinder() {
                         bpmTapTimes.clear();
 
                         if (soundManager && isSongLoaded && isPlaying) {
-                            soundManager->pauseSound("timeline_song");
+                            soundManager->pauseSound(songHandle);
                             isPlaying = false;
                         }
                     }
@@ -3063,7 +3189,7 @@ void Editor::drawBpmFinder() {
                     bpmTapTimes.clear();
 
                     if (soundManager && isSongLoaded && isPlaying) {
-                        soundManager->pauseSound("timeline_song");
+                        soundManager->pauseSound(songHandle);
                         isPlaying = false;
                     }
                 }
@@ -3077,7 +3203,7 @@ void Editor::drawBpmFinder() {
                     bpmTapTimes.clear();
 
                     if (soundManager && isSongLoaded && isPlaying) {
-                        soundManager->pauseSound("timeline_song");
+                        soundManager->pauseSound(songHandle);
                         isPlaying = false;
                     }
                 }
@@ -3091,7 +3217,7 @@ void Editor::drawBpmFinder() {
                     bpmTapTimes.clear();
 
                     if (soundManager && isSongLoaded && isPlaying) {
-                        soundManager->pauseSound("timeline_song");
+                        soundManager->pauseSound(songHandle);
                         isPlaying = false;
                     }
                 }
@@ -3112,7 +3238,7 @@ void Editor::drawBpmFinder() {
             bpmTapTimes.clear();
 
             if (soundManager && isSongLoaded && isPlaying) {
-                soundManager->pauseSound("timeline_song");
+                soundManager->pauseSound(songHandle);
                 isPlaying = false;
             }
         }
@@ -3208,9 +3334,45 @@ void Editor::drawSpectrumWindow() {
         }
     }
 
-    ImGui::SetCursorScreenPos(ImVec2(content_pos.x + 20.0f, content_pos.y + spectrum_height + 20.0f));
-    ImGui::TextColored(ImVec4(0.7f, 0.7f, 0.7f, 1.0f), "Frequency Range: 0 - %.0f Hz", 22050.0f * spectrumData.size() / 64.0f);
-    ImGui::TextColored(ImVec4(0.7f, 0.7f, 0.7f, 1.0f), "Bars: %zu | Position: %.2fs | Real-time FFT", spectrumData.size(), currentPosition);
+    // Scrolling spectrogram, oldest frame on the left and low frequencies at the bottom
+    float history_height = 120.0f;
+    ImVec2 history_start = ImVec2(spectrum_start.x, spectrum_end.y + 10.0f);
+    draw_list->AddRectFilled(
+        history_start,
+        ImVec2(history_start.x + spectrum_width, history_start.y + history_height),
+        IM_COL32(20, 20, 20, 255)
+    );
+
+    int historyRows = static_cast<int>(spectrumHistory.size());
+    int bandCount = static_cast<int>(spectrumData.size());
+    if (historyRows > 0 && bandCount > 0) {
+        float cell_width = spectrum_width / historyRows;
+        float cell_height = history_height / bandCount;
+
+        draw_list->PrimReserve(historyRows * bandCount * 6, historyRows * bandCount * 4);
+        for (int column = 0; column < historyRows; ++column) {
+            const std::vector<float>& frame = spectrumHistory[(spectrumHistoryHead + column) % historyRows];
+            float x = history_start.x + column * cell_width;
+
+            for (int band = 0; band < bandCount; ++band) {
+                float value = frame[band];
+                float y = history_start.y + history_height - (band + 1) * cell_height;
+                ImU32 cell_color = IM_COL32(
+                    static_cast<int>(255 * std::min(1.0f, value * 1.5f)),
+                    static_cast<int>(255 * value * value),
+                    static_cast<int>(120 * (1.0f - value) * value * 4.0f),
+                    255
+                );
+                draw_list->PrimRect(ImVec2(x, y), ImVec2(x + cell_width, y + cell_height), cell_color);
+            }
+        }
+    }
+
+    const SpectrumStream& stream = audioAnalyzer->getSpectrumStream();
+    ImGui::SetCursorScreenPos(ImVec2(content_pos.x + 20.0f, history_start.y + history_height + 10.0f));
+    ImGui::TextColored(ImVec4(0.7f, 0.7f, 0.7f, 1.0f), "Frequency Range: %.0f - %.0f Hz (log)",
+                       stream.getBandFrequency(0), stream.getSampleRate() * 0.5);
+    ImGui::TextColored(ImVec4(0.7f, 0.7f, 0.7f, 1.0f), "Bands: %zu | Position: %.2fs | Streaming FFT", spectrumData.size(), currentPosition);
 
     if (!spectrumData.empty()) {
         float max_value = *std::max_element(spectrumData.begin(), spectrumData.end());
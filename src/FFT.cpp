@@ -0,0 +1,123 @@
+#include "FFT.hpp"
+#include <cmath>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+
+FFTPlan::FFTPlan(size_t size) : size(size), halfSize(size / 2) {
+    if (size < 2 || (size & (size - 1)) != 0) {
+        throw std::runtime_error("FFT size must be a power of two: " + std::to_string(size));
+    }
+
+    int bits = 0;
+    while ((static_cast<size_t>(1) << bits) < halfSize) {
+        bits++;
+    }
+
+    bitReverse.resize(halfSize);
+    for (size_t i = 0; i < halfSize; i++) {
+        size_t reversed = 0;
+        for (int b = 0; b < bits; b++) {
+            if (i & (static_cast<size_t>(1) << b)) {
+                reversed |= static_cast<size_t>(1) << (bits - 1 - b);
+            }
+        }
+        bitReverse[i] = reversed;
+    }
+
+    // Twiddles of the half-size complex transform: exp(-2*pi*i*j / (N/2))
+    twiddles.resize(std::max<size_t>(1, halfSize / 2));
+    for (size_t j = 0; j < twiddles.size(); j++) {
+        double angle = -2.0 * M_PI * static_cast<double>(j) / static_cast<double>(halfSize);
+        twiddles[j] = std::complex<float>(static_cast<float>(std::cos(angle)), static_cast<float>(std::sin(angle)));
+    }
+
+    // Twiddles used to split the packed spectrum: exp(-2*pi*i*k / N)
+    realTwiddles.resize(halfSize / 2 + 1);
+    for (size_t k = 0; k < realTwiddles.size(); k++) {
+        double angle = -2.0 * M_PI * static_cast<double>(k) / static_cast<double>(size);
+        realTwiddles[k] = std::complex<float>(static_cast<float>(std::cos(angle)), static_cast<float>(std::sin(angle)));
+    }
+}
+
+void FFTPlan::transformComplex(std::complex<float>* data) const {
+    for (size_t i = 0; i < halfSize; i++) {
+        size_t j = bitReverse[i];
+        if (i < j) {
+            std::swap(data[i], data[j]);
+        }
+    }
+
+    // Complex products are written out by hand so the compiler does not emit
+    // the NaN-checking library calls std::complex multiplication falls back to
+    for (size_t length = 2; length <= halfSize; length <<= 1) {
+        size_t half = length / 2;
+        size_t step = halfSize / length;
+
+        for (size_t start = 0; start < halfSize; start += length) {
+            std::complex<float>* lower = data + start;
+            std::complex<float>* upper = lower + half;
+
+            for (size_t j = 0; j < half; j++) {
+                const std::complex<float>& w = twiddles[j * step];
+                float vr = upper[j].real() * w.real() - upper[j].imag() * w.imag();
+                float vi = upper[j].real() * w.imag() + upper[j].imag() * w.real();
+                float ur = lower[j].real();
+                float ui = lower[j].imag();
+
+                lower[j] = std::complex<float>(ur + vr, ui + vi);
+                upper[j] = std::complex<float>(ur - vr, ui - vi);
+            }
+        }
+    }
+}
+
+void FFTPlan::forwardReal(const float* input, std::complex<float>* output) const {
+    // Pack even samples into the real part and odd samples into the imaginary part
+    for (size_t i = 0; i < halfSize; i++) {
+        output[i] = std::complex<float>(input[2 * i], input[2 * i + 1]);
+    }
+
+    transformComplex(output);
+
+    std::complex<float> first = output[0];
+    output[0] = std::complex<float>(first.real() + first.imag(), 0.0f);
+    output[halfSize] = std::complex<float>(first.real() - first.imag(), 0.0f);
+
+    for (size_t k = 1; k <= halfSize / 2; k++) {
+        size_t mirror = halfSize - k;
+        std::complex<float> a = output[k];
+        std::complex<float> b = output[mirror];
+
+        // Even/odd halves of the original sequence at bin k
+        float evenRe = 0.5f * (a.real() + b.real());
+        float evenIm = 0.5f * (a.imag() - b.imag());
+        float diffRe = 0.5f * (a.real() - b.real());
+        float diffIm = 0.5f * (a.imag() + b.imag());
+
+        const std::complex<float>& w = realTwiddles[k];
+        float pr = w.real() * diffRe - w.imag() * diffIm;
+        float pi = w.real() * diffIm + w.imag() * diffRe;
+
+        output[k] = std::complex<float>(evenRe + pi, evenIm - pr);
+        if (mirror != k) {
+            output[mirror] = std::complex<float>(evenRe - pi, -evenIm - pr);
+        }
+    }
+}
+
+std::shared_ptr<const FFTPlan> FFTPlan::get(size_t size) {
+    static std::mutex cacheMutex;
+    static std::map<size_t, std::shared_ptr<const FFTPlan>> cache;
+
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    auto it = cache.find(size);
+    if (it != cache.end()) {
+        return it->second;
+    }
+
+    auto plan = std::make_shared<const FFTPlan>(size);
+    cache[size] = plan;
+    return plan;
+}
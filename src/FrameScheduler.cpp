@@ -0,0 +1,103 @@
+#include "FrameScheduler.hpp"
+#include <algorithm>
+#include <thread>
+
+namespace App {
+namespace Core {
+
+    FrameScheduler::FrameScheduler()
+        : mode(FRAME_MODE_ADAPTIVE),
+          pacing(PACING_VSYNC),
+          targetFps(144),
+          animationRequested(false),
+          lowLatencyRequested(false),
+          frameStart(),
+          previousStart(),
+          waitStart(),
+          activeUntil(),
+          hasPreviousFrame(false),
+          intervals(),
+          workTimes(),
+          historyCount(0),
+          historyNext(0) {}
+
+    void FrameScheduler::beginFrame(Clock::time_point now) {
+        // An idle wait that ended well before its timeout was cut short by an input event
+        if (pacing == PACING_IDLE && now - waitStart < std::chrono::duration<double>(IDLE_TIMEOUT * 0.9)) {
+            activeUntil = now + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(INPUT_LINGER));
+        }
+
+        previousStart = frameStart;
+        frameStart = now;
+        animationRequested = false;
+        lowLatencyRequested = false;
+    }
+
+    void FrameScheduler::endFrame() {
+        Clock::time_point now = Clock::now();
+
+        // Idle intervals say nothing about rendering cost, only drawn-on-demand frames are kept
+        if (hasPreviousFrame && pacing != PACING_IDLE) {
+            intervals[historyNext] = std::chrono::duration<float, std::milli>(frameStart - previousStart).count();
+            workTimes[historyNext] = std::chrono::duration<float, std::milli>(now - frameStart).count();
+            historyNext = (historyNext + 1) % HISTORY;
+            historyCount = std::min(historyCount + 1, HISTORY);
+        }
+        hasPreviousFrame = true;
+
+        bool active = animationRequested || now < activeUntil;
+        bool limited = targetFps > 0;
+        switch (mode) {
+            case FRAME_MODE_VSYNC:
+                pacing = PACING_VSYNC;
+                break;
+            case FRAME_MODE_UNCAPPED:
+                pacing = PACING_LOW_LATENCY;
+                break;
+            case FRAME_MODE_LIMITED:
+                pacing = (lowLatencyRequested || active) ? (limited ? PACING_LIMITED : PACING_VSYNC) : PACING_IDLE;
+                break;
+            case FRAME_MODE_ADAPTIVE:
+            default:
+                pacing = lowLatencyRequested ? PACING_LOW_LATENCY : (active ? PACING_VSYNC : PACING_IDLE);
+                break;
+        }
+
+        if (pacing == PACING_LIMITED) {
+            std::this_thread::sleep_until(frameStart + std::chrono::duration_cast<Clock::duration>(
+                                                           std::chrono::duration<double>(1.0 / targetFps)));
+        }
+        waitStart = Clock::now();
+    }
+
+    FrameStats FrameScheduler::getStats() const {
+        FrameStats stats = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, historyCount};
+        if (historyCount == 0) {
+            return stats;
+        }
+
+        std::array<float, HISTORY> sortedWork;
+        for (size_t i = 0; i < historyCount; i++) {
+            stats.averageInterval += intervals[i];
+            stats.worstInterval = std::max(stats.worstInterval, static_cast<double>(intervals[i]));
+            stats.averageWork += workTimes[i];
+            stats.worstWork = std::max(stats.worstWork, static_cast<double>(workTimes[i]));
+            sortedWork[i] = workTimes[i];
+        }
+        stats.averageInterval /= historyCount;
+        stats.averageWork /= historyCount;
+        stats.fps = stats.averageInterval > 0.0 ? 1000.0 / stats.averageInterval : 0.0;
+
+        size_t p99 = std::min(historyCount - 1, static_cast<size_t>(0.99 * (historyCount - 1)));
+        std::nth_element(sortedWork.begin(), sortedWork.begin() + p99, sortedWork.begin() + historyCount);
+        stats.p99Work = sortedWork[p99];
+        return stats;
+    }
+
+    FrameScheduler& getFrameScheduler() {
+        static FrameScheduler scheduler;
+        return scheduler;
+    }
+
+} // Core
+} // App
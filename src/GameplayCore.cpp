@@ -0,0 +1,381 @@
+#include "GameplayCore.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace App {
+namespace Windows {
+
+GameplayCore::GameplayCore()
+    : laneCursors{0, 0},
+      laneHeld{false, false},
+      stats({0, 0, 0, 0, 0, 0, 0.0, 0}),
+      lastTime(0.0),
+      chartHash(0),
+      settings({0.2, 0.05, 0.10, 0.15, 0.1}) {
+}
+
+void GameplayCore::loadNotes(const std::vector<Core::Note>& chartNotes) {
+    notes.clear();
+    notes.reserve(chartNotes.size());
+    for (const Core::Note& source : chartNotes) {
+        GameNote note;
+        note.id = source.id;
+        note.lane = source.lane;
+        note.type = source.type;
+        note.timestamp = source.timestamp;
+        note.endTimestamp = source.endTimestamp;
+        notes.push_back(note);
+    }
+
+    buildQueues();
+    reset();
+}
+
+void GameplayCore::loadChart(const ChartFile& chart) {
+    std::vector<Core::Note> chartNotes;
+    chartNotes.reserve(chart.getNoteCount());
+    for (size_t i = 0; i < chart.getNoteCount(); ++i) {
+        chartNotes.push_back(chart.getNote(i));
+    }
+    loadNotes(chartNotes);
+}
+
+void GameplayCore::buildQueues() {
+    std::stable_sort(notes.begin(), notes.end(), [](const GameNote& a, const GameNote& b) {
+        return a.timestamp < b.timestamp;
+    });
+
+    noteMaxEnd.clear();
+    noteMaxEnd.reserve(notes.size());
+    for (auto& queue : laneQueues) {
+        queue.clear();
+    }
+
+    for (size_t i = 0; i < notes.size(); i++) {
+        const GameNote& note = notes[i];
+        if (note.lane == Core::Lane::TOP || note.lane == Core::Lane::BOTTOM) {
+            laneQueues[note.lane].push_back(i);
+        }
+        noteMaxEnd.push_back(noteMaxEnd.empty() ? note.endTimestamp : std::max(noteMaxEnd.back(), note.endTimestamp));
+    }
+
+    // FNV-1a over the fields that affect judgement, in play order
+    chartHash = 14695981039346656037ULL;
+    auto mix = [this](const void* data, size_t size) {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < size; i++) {
+            chartHash = (chartHash ^ bytes[i]) * 1099511628211ULL;
+        }
+    };
+    for (const GameNote& note : notes) {
+        int32_t id = note.id;
+        uint8_t lane = static_cast<uint8_t>(note.lane);
+        uint8_t type = static_cast<uint8_t>(note.type);
+        mix(&id, sizeof(id));
+        mix(&lane, sizeof(lane));
+        mix(&type, sizeof(type));
+        mix(&note.timestamp, sizeof(note.timestamp));
+        mix(&note.endTimestamp, sizeof(note.endTimestamp));
+    }
+}
+
+void GameplayCore::reset() {
+    stats = {0, 0, 0, 0, 0, 0, 0.0, 0};
+    recentJudgements.clear();
+    events.clear();
+    inputLog.clear();
+    lastTime = 0.0;
+
+    for (auto& note : notes) {
+        note.hit = false;
+        note.judgement = MISS;
+        note.hitTime = 0.0;
+        note.isActive = true;
+        note.isHolding = false;
+        note.holdStartTime = 0.0;
+        note.holdCompleted = false;
+        note.holdAccuracy = 0.0;
+        note.holdTicks = 0;
+        note.totalHoldTicks = 0;
+        note.lastHoldTickTime = 0.0;
+    }
+
+    laneCursors[0] = 0;
+    laneCursors[1] = 0;
+    laneHeld[0] = false;
+    laneHeld[1] = false;
+    activeHolds.clear();
+}
+
+double GameplayCore::advanceTime(double time) {
+    lastTime = std::max(lastTime, time);
+    return lastTime;
+}
+
+void GameplayCore::press(Core::Lane lane, double time) {
+    if (lane != Core::Lane::TOP && lane != Core::Lane::BOTTOM) return;
+
+    time = advanceTime(time);
+    inputLog.push_back(ScriptedInput{time, lane, true});
+    laneHeld[lane] = true;
+
+    // Misses that happened before the press come first, whatever the frame rate
+    checkNoteHits(time);
+
+    const std::vector<size_t>& queue = laneQueues[lane];
+    GameNote* bestNote = nullptr;
+    double bestTimeDiff = settings.judgementWindow;
+
+    // Everything before the cursor is judged, and the queue is time sorted,
+    // so only the notes inside the judgement window are looked at
+    for (size_t i = laneCursors[lane]; i < queue.size(); i++) {
+        GameNote& note = notes[queue[i]];
+        if (note.timestamp - time > settings.judgementWindow) break;
+        if (!note.isActive || note.hit || note.isHolding) continue;
+
+        double time_diff = std::abs(time - note.timestamp);
+        if (time_diff < bestTimeDiff) {
+            bestNote = &note;
+            bestTimeDiff = time_diff;
+        }
+    }
+
+    if (bestNote) {
+        hitNote(*bestNote, time);
+    }
+}
+
+void GameplayCore::release(Core::Lane lane, double time) {
+    if (lane != Core::Lane::TOP && lane != Core::Lane::BOTTOM) return;
+
+    time = advanceTime(time);
+    inputLog.push_back(ScriptedInput{time, lane, false});
+    laneHeld[lane] = false;
+    checkNoteHits(time);
+
+    // Holds of that lane end at the release itself, not at the next update
+    for (size_t i = 0; i < activeHolds.size();) {
+        GameNote& note = notes[activeHolds[i]];
+        if (note.lane != lane) {
+            i++;
+            continue;
+        }
+
+        advanceHoldTicks(note, time);
+        if (time >= note.endTimestamp) {
+            completeHold(note, time);
+        } else {
+            breakHold(note, time);
+        }
+        activeHolds[i] = activeHolds.back();
+        activeHolds.pop_back();
+    }
+}
+
+void GameplayCore::update(double currentTime) {
+    currentTime = advanceTime(currentTime);
+    checkNoteHits(currentTime);
+    updateHoldNotes(currentTime);
+}
+
+void GameplayCore::hitNote(GameNote& note, double time) {
+    note.hitTime = time;
+    Judgement judgement = calculateJudgement(time, note.timestamp);
+    note.judgement = judgement;
+
+    if (note.type == Core::NoteType::HOLD) {
+        note.isHolding = true;
+        note.holdStartTime = time;
+        note.lastHoldTickTime = time;
+        note.holdTicks = 0;
+        note.totalHoldTicks = static_cast<int>((note.endTimestamp - note.timestamp) / settings.holdTickInterval) + 1;
+        activeHolds.push_back(static_cast<size_t>(&note - notes.data()));
+        updateStats(judgement);
+        pushEvent(EVENT_HOLD_START, note, judgement, time);
+    } else {
+        note.hit = true;
+        updateStats(judgement);
+        pushEvent(EVENT_HIT, note, judgement, time);
+    }
+}
+
+void GameplayCore::missNote(GameNote& note, double time) {
+    note.hit = true;
+    note.judgement = MISS;
+    note.holdCompleted = false;
+    updateStats(MISS);
+    stats.combo = 0;
+    pushEvent(EVENT_MISS, note, MISS, time);
+}
+
+void GameplayCore::breakHold(GameNote& note, double time) {
+    note.isHolding = false;
+    note.hit = true;
+    note.holdCompleted = false;
+    note.judgement = MISS;
+    updateStats(MISS);
+    stats.combo = 0;
+    pushEvent(EVENT_HOLD_BREAK, note, MISS, time);
+}
+
+void GameplayCore::completeHold(GameNote& note, double time) {
+    note.isHolding = false;
+    note.hit = true;
+    note.holdCompleted = true;
+
+    if (note.totalHoldTicks > 0) {
+        note.holdAccuracy = static_cast<double>(note.holdTicks) / note.totalHoldTicks;
+    }
+
+    int holdBonus = static_cast<int>(note.holdAccuracy * 50);
+    stats.score += holdBonus;
+    pushEvent(EVENT_HOLD_COMPLETE, note, note.judgement, time);
+}
+
+void GameplayCore::advanceHoldTicks(GameNote& note, double time) {
+    // Ticks sit on a grid from the hold start and stop at its end, so they
+    // don't depend on when updates happen
+    double limit = std::min(time, note.endTimestamp);
+    while (note.lastHoldTickTime + settings.holdTickInterval <= limit) {
+        note.lastHoldTickTime += settings.holdTickInterval;
+        note.holdTicks++;
+        stats.score += 5;
+    }
+
+    if (note.totalHoldTicks > 0) {
+        note.holdAccuracy = static_cast<double>(note.holdTicks) / note.totalHoldTicks;
+    }
+}
+
+void GameplayCore::checkNoteHits(double currentTime) {
+    for (int lane = 0; lane < 2; lane++) {
+        const std::vector<size_t>& queue = laneQueues[lane];
+        size_t& cursor = laneCursors[lane];
+
+        // The cursor only moves forward: past judged notes, held notes (tracked
+        // in activeHolds) and notes that left the judgement window unhit
+        while (cursor < queue.size()) {
+            GameNote& note = notes[queue[cursor]];
+
+            if (note.isActive && !note.hit && !note.isHolding) {
+                if (currentTime - note.timestamp <= settings.judgementWindow) break;
+                missNote(note, currentTime);
+            }
+
+            cursor++;
+        }
+    }
+}
+
+void GameplayCore::updateHoldNotes(double currentTime) {
+    for (size_t i = 0; i < activeHolds.size();) {
+        GameNote& note = notes[activeHolds[i]];
+
+        if (note.isActive && note.isHolding && !note.hit) {
+            advanceHoldTicks(note, currentTime);
+            if (currentTime >= note.endTimestamp) {
+                completeHold(note, currentTime);
+            } else {
+                i++;
+                continue;
+            }
+        }
+
+        activeHolds[i] = activeHolds.back();
+        activeHolds.pop_back();
+    }
+}
+
+Judgement GameplayCore::calculateJudgement(double hitTime, double noteTime) const {
+    double time_diff = std::abs(hitTime - noteTime);
+
+    if (time_diff <= settings.perfectWindow) {
+        return PERFECT;
+    } else if (time_diff <= settings.greatWindow) {
+        return GREAT;
+    } else if (time_diff <= settings.goodWindow) {
+        return GOOD;
+    } else {
+        return MISS;
+    }
+}
+
+void GameplayCore::updateStats(Judgement judgement) {
+    switch (judgement) {
+        case PERFECT:
+            stats.perfect++;
+            stats.combo++;
+            stats.score += 100;
+            break;
+        case GREAT:
+            stats.great++;
+            stats.combo++;
+            stats.score += 50;
+            break;
+        case GOOD:
+            stats.good++;
+            stats.combo++;
+            stats.score += 25;
+            break;
+        case MISS:
+            stats.miss++;
+            stats.combo = 0;
+            break;
+    }
+
+    if (stats.combo > stats.maxCombo) {
+        stats.maxCombo = stats.combo;
+    }
+
+    int total_notes = stats.perfect + stats.great + stats.good + stats.miss;
+    if (total_notes > 0) {
+        double weighted_score = (stats.perfect * 100.0) + (stats.great * 80.0) + (stats.good * 60.0);
+        stats.accuracy = weighted_score / total_notes;
+    }
+
+    recentJudgements.push_back(judgement);
+    if (recentJudgements.size() > 10) {
+        recentJudgements.pop_front();
+    }
+}
+
+void GameplayCore::pushEvent(GameplayEventType type, const GameNote& note, Judgement judgement, double time) {
+    events.push_back(GameplayEvent{type, note.lane, judgement, time});
+}
+
+GameStats GameplayCore::simulate(const std::vector<ScriptedInput>& inputs, double endTime, double frameTime) {
+    reset();
+
+    size_t next = 0;
+    for (long frame = 0;; frame++) {
+        double frameEnd = std::min(frame * frameTime, endTime);
+
+        // Inputs carry their own timestamps, the frame only decides when they are seen
+        while (next < inputs.size() && inputs[next].time <= frameEnd) {
+            const ScriptedInput& input = inputs[next++];
+            if (input.pressed) {
+                press(input.lane, input.time);
+            } else {
+                release(input.lane, input.time);
+            }
+        }
+
+        update(frameEnd);
+        events.clear();
+
+        if (frameEnd >= endTime) break;
+    }
+
+    return stats;
+}
+
+size_t GameplayCore::firstNoteEndingAfter(double time) const {
+    return static_cast<size_t>(std::lower_bound(noteMaxEnd.begin(), noteMaxEnd.end(), time) - noteMaxEnd.begin());
+}
+
+bool GameplayCore::isLaneHeld(Core::Lane lane) const {
+    return (lane == Core::Lane::TOP || lane == Core::Lane::BOTTOM) && laneHeld[lane];
+}
+
+} // Windows
+} // App
@@ -0,0 +1,40 @@
+#include "InputQueue.hpp"
+
+namespace App {
+namespace Core {
+
+    InputQueue::InputQueue() : events(), head(0), tail(0) {}
+
+    bool InputQueue::push(const InputEvent& event) {
+        size_t currentHead = head.load(std::memory_order_relaxed);
+        if (currentHead - tail.load(std::memory_order_acquire) >= CAPACITY) {
+            return false;
+        }
+
+        events[currentHead & (CAPACITY - 1)] = event;
+        head.store(currentHead + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool InputQueue::pop(InputEvent& event) {
+        size_t currentTail = tail.load(std::memory_order_relaxed);
+        if (currentTail == head.load(std::memory_order_acquire)) {
+            return false;
+        }
+
+        event = events[currentTail & (CAPACITY - 1)];
+        tail.store(currentTail + 1, std::memory_order_release);
+        return true;
+    }
+
+    void InputQueue::clear() {
+        tail.store(head.load(std::memory_order_acquire), std::memory_order_release);
+    }
+
+    InputQueue& getInputQueue() {
+        static InputQueue queue;
+        return queue;
+    }
+
+} // Core
+} // App
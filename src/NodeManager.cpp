@@ -1,72 +1,242 @@
 #include "NodeManager.hpp"
 
+#include <iterator>
+#include <limits>
+
 namespace App {
 namespace Core {
 
-    NodeManager::NodeManager() : nextId(1) {}
+    NodeManager::NodeManager() : laneRoots{NO_SLOT, NO_SLOT}, nextId(1), revision(0), priorityState(0x9e3779b9u) {}
+
+    int NodeManager::insertNote(const Note& note) {
+        Note inserted = note;
+        if (slotById.count(inserted.id)) {
+            // Ids must stay unique for the lookup map, duplicates from old files get a fresh one
+            inserted.id = nextId;
+        }
+        if (inserted.id >= nextId) {
+            nextId = inserted.id + 1;
+        }
+        if (inserted.lane != TOP && inserted.lane != BOTTOM) {
+            // Lanes outside the two tracks only come from damaged files
+            inserted.lane = BOTTOM;
+        }
+
+        int slot;
+        if (!freeSlots.empty()) {
+            slot = freeSlots.back();
+            freeSlots.pop_back();
+        } else {
+            slot = static_cast<int>(slots.size());
+            slots.emplace_back();
+        }
+
+        // xorshift32, any well mixed sequence keeps the treaps balanced
+        priorityState ^= priorityState << 13;
+        priorityState ^= priorityState >> 17;
+        priorityState ^= priorityState << 5;
+
+        slots[slot] = NoteSlot{inserted, priorityState, NO_SLOT, NO_SLOT, inserted.endTimestamp};
+        slotById[inserted.id] = slot;
+        linkSlot(slot);
+
+        revision++;
+        return inserted.id;
+    }
+
+    bool NodeManager::precedes(int a, int b) const {
+        const Note& first = slots[a].note;
+        const Note& second = slots[b].note;
+        if (first.timestamp != second.timestamp) return first.timestamp < second.timestamp;
+        return first.id < second.id;
+    }
+
+    void NodeManager::updateSlot(int slot) {
+        NoteSlot& node = slots[slot];
+        node.maxEnd = node.note.endTimestamp;
+        if (node.left != NO_SLOT) node.maxEnd = std::max(node.maxEnd, slots[node.left].maxEnd);
+        if (node.right != NO_SLOT) node.maxEnd = std::max(node.maxEnd, slots[node.right].maxEnd);
+    }
+
+    // Splits root into the notes ordered before slot and the rest
+    void NodeManager::split(int root, int slot, int& left, int& right) {
+        if (root == NO_SLOT) {
+            left = NO_SLOT;
+            right = NO_SLOT;
+            return;
+        }
+
+        if (precedes(root, slot)) {
+            split(slots[root].right, slot, slots[root].right, right);
+            left = root;
+        } else {
+            split(slots[root].left, slot, left, slots[root].left);
+            right = root;
+        }
+        updateSlot(root);
+    }
+
+    // Joins two treaps where every note of left is ordered before every note of right
+    int NodeManager::merge(int left, int right) {
+        if (left == NO_SLOT) return right;
+        if (right == NO_SLOT) return left;
+
+        if (slots[left].priority > slots[right].priority) {
+            slots[left].right = merge(slots[left].right, right);
+            updateSlot(left);
+            return left;
+        }
+        slots[right].left = merge(left, slots[right].left);
+        updateSlot(right);
+        return right;
+    }
+
+    int NodeManager::eraseFrom(int root, int slot) {
+        if (root == NO_SLOT) return NO_SLOT;
+
+        if (root == slot) {
+            return merge(slots[root].left, slots[root].right);
+        }
+        if (precedes(slot, root)) {
+            slots[root].left = eraseFrom(slots[root].left, slot);
+        } else {
+            slots[root].right = eraseFrom(slots[root].right, slot);
+        }
+        updateSlot(root);
+        return root;
+    }
+
+    void NodeManager::linkSlot(int slot) {
+        NoteSlot& node = slots[slot];
+        node.left = NO_SLOT;
+        node.right = NO_SLOT;
+        node.maxEnd = node.note.endTimestamp;
+
+        int& root = laneRoots[node.note.lane];
+        int left;
+        int right;
+        split(root, slot, left, right);
+        root = merge(merge(left, slot), right);
+    }
+
+    // Must run while the note still has the timestamp it was linked with
+    void NodeManager::unlinkSlot(int slot) {
+        int& root = laneRoots[slots[slot].note.lane];
+        root = eraseFrom(root, slot);
+    }
 
     int NodeManager::addNote(int lane, double timestamp) {
-        notes.push_back(Note{nextId, static_cast<Lane>(lane), TAP, timestamp, timestamp});
-        return nextId++;
+        return insertNote(Note{nextId, static_cast<Lane>(lane), TAP, timestamp, timestamp});
     }
 
     int NodeManager::addNoteWithId(int id, int lane, double timestamp) {
-        notes.push_back(Note{id, static_cast<Lane>(lane), TAP, timestamp, timestamp});
-        if (id >= nextId) {
-            nextId = id + 1;
-        }
-        return id;
+        return insertNote(Note{id, static_cast<Lane>(lane), TAP, timestamp, timestamp});
     }
 
     int NodeManager::addHoldNote(int lane, double startTimestamp, double endTimestamp) {
-        notes.push_back(Note{nextId, static_cast<Lane>(lane), HOLD, startTimestamp, endTimestamp});
-        return nextId++;
+        return insertNote(Note{nextId, static_cast<Lane>(lane), HOLD, startTimestamp, endTimestamp});
     }
 
     int NodeManager::addHoldNoteWithId(int id, int lane, double startTimestamp, double endTimestamp) {
-        notes.push_back(Note{id, static_cast<Lane>(lane), HOLD, startTimestamp, endTimestamp});
-        if (id >= nextId) {
-            nextId = id + 1;
-        }
-        return id;
+        return insertNote(Note{id, static_cast<Lane>(lane), HOLD, startTimestamp, endTimestamp});
     }
 
     void NodeManager::removeNote(int id) {
-        notes.erase(std::remove_if(notes.begin(), notes.end(), [id](const Note& n){ return n.id == id; }), notes.end());
+        auto it = slotById.find(id);
+        if (it == slotById.end()) return;
+
+        int slot = it->second;
+        unlinkSlot(slot);
+        freeSlots.push_back(slot);
+        slotById.erase(it);
+        revision++;
     }
 
     void NodeManager::moveNote(int id, int newLane, double newTimestamp) {
-        for (auto& n : notes) {
-            if (n.id == id) {
-                n.lane = static_cast<Lane>(newLane);
-                n.timestamp = newTimestamp;
-                if (n.type == TAP) {
-                    n.endTimestamp = newTimestamp;
-                }
-                break;
-            }
-        }
+        Note* note = getNoteById(id);
+        if (!note) return;
+
+        double newEndTimestamp = note->type == TAP ? newTimestamp : note->endTimestamp;
+        moveHoldNote(id, newLane, newTimestamp, newEndTimestamp);
     }
 
     void NodeManager::moveHoldNote(int id, int newLane, double newStartTimestamp, double newEndTimestamp) {
-        for (auto& n : notes) {
-            if (n.id == id) {
-                n.lane = static_cast<Lane>(newLane);
-                n.timestamp = newStartTimestamp;
-                n.endTimestamp = newEndTimestamp;
-                break;
-            }
+        auto it = slotById.find(id);
+        if (it == slotById.end()) return;
+
+        int slot = it->second;
+        Note& note = slots[slot].note;
+        Lane lane = newLane == TOP ? TOP : BOTTOM;
+        // Dragging calls this every frame, most of them with the note already in place
+        if (note.lane == lane && note.timestamp == newStartTimestamp && note.endTimestamp == newEndTimestamp) {
+            return;
         }
+
+        unlinkSlot(slot);
+        note.lane = lane;
+        note.timestamp = newStartTimestamp;
+        note.endTimestamp = newEndTimestamp;
+        linkSlot(slot);
+        revision++;
     }
 
     Note* NodeManager::getNoteById(int id) {
-        for (auto& n : notes) if (n.id == id) return &n;
-        return nullptr;
+        auto it = slotById.find(id);
+        return it != slotById.end() ? &slots[it->second].note : nullptr;
+    }
+
+    // In-order walk that skips subtrees ending before the range and stops past its end
+    void NodeManager::collect(int root, double startTime, double endTime, std::vector<const Note*>& result) const {
+        while (root != NO_SLOT && slots[root].maxEnd >= startTime) {
+            const NoteSlot& node = slots[root];
+            collect(node.left, startTime, endTime, result);
+            if (node.note.timestamp > endTime) return;
+            if (node.note.endTimestamp >= startTime) {
+                result.push_back(&node.note);
+            }
+            root = node.right;
+        }
+    }
+
+    void NodeManager::queryRange(double startTime, double endTime, int lane, std::vector<const Note*>& result) const {
+        result.clear();
+        if (lane == TOP || lane == BOTTOM) {
+            collect(laneRoots[lane], startTime, endTime, result);
+            return;
+        }
+        if (lane != ALL_LANES) return;
+
+        for (int i = 0; i < 2; i++) {
+            laneResults[i].clear();
+            collect(laneRoots[i], startTime, endTime, laneResults[i]);
+        }
+        result.reserve(laneResults[0].size() + laneResults[1].size());
+        std::merge(laneResults[0].begin(), laneResults[0].end(), laneResults[1].begin(), laneResults[1].end(),
+                   std::back_inserter(result), [](const Note* a, const Note* b) {
+            if (a->timestamp != b->timestamp) return a->timestamp < b->timestamp;
+            return a->id < b->id;
+        });
+    }
+
+    size_t NodeManager::getNoteCount() const { return slotById.size(); }
+
+    void NodeManager::getAllNotes(std::vector<const Note*>& result) const {
+        double infinity = std::numeric_limits<double>::infinity();
+        queryRange(-infinity, infinity, ALL_LANES, result);
+    }
+
+    void NodeManager::clear() {
+        slots.clear();
+        freeSlots.clear();
+        slotById.clear();
+        laneRoots[0] = NO_SLOT;
+        laneRoots[1] = NO_SLOT;
+        nextId = 1;
+        revision++;
     }
 
-    std::vector<Note>& NodeManager::getNotes() { return notes; }
-    void NodeManager::clear() { notes.clear(); nextId = 1; }
     int NodeManager::getNextId() const { return nextId; }
+    uint64_t NodeManager::getRevision() const { return revision; }
 
 } // Core
 } // App
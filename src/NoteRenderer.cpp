@@ -0,0 +1,227 @@
+#include "NoteRenderer.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+
+#define GL_SILENCE_DEPRECATION
+#if defined(IMGUI_IMPL_OPENGL_ES2)
+#include <GLES2/gl2.h>
+#endif
+#include <GLFW/glfw3.h> // Will drag system OpenGL headers
+
+// Windows only ships the OpenGL 1.1 header
+#ifndef GL_CLAMP_TO_EDGE
+#define GL_CLAMP_TO_EDGE 0x812F
+#endif
+
+namespace App {
+namespace Windows {
+
+namespace {
+
+const int ATLAS_CELL = 128;
+const int ATLAS_COLUMNS = 4;
+const int ATLAS_SIZE = ATLAS_CELL * ATLAS_COLUMNS;
+const int CELL_PADDING = 2; // Transparent border so bilinear filtering never reads a neighbour cell
+const int SUPERSAMPLE = 4;  // Samples per texel side for the anti-aliased edges
+const size_t QUADS_PER_RESERVE = 4096; // Keeps each reservation far below 16-bit index limits
+
+// A filled disc of one alpha, radius relative to the sprite's outer radius
+struct Layer {
+    float radius;
+    float alpha;
+};
+
+// Alpha of same-coloured discs drawn on top of each other, at distance d
+float layeredAlpha(const Layer* layers, int count, float d) {
+    float transparency = 1.0f;
+    for (int i = 0; i < count; i++) {
+        if (d <= layers[i].radius) {
+            transparency *= 1.0f - layers[i].alpha;
+        }
+    }
+    return 1.0f - transparency;
+}
+
+// Rasterizes a radial alpha profile (distance 0..1 from the centre) into a cell
+template <typename Profile>
+void fillCell(std::vector<unsigned char>& pixels, int cell, Profile profile) {
+    int originX = (cell % ATLAS_COLUMNS) * ATLAS_CELL;
+    int originY = (cell / ATLAS_COLUMNS) * ATLAS_CELL;
+    float contentRadius = ATLAS_CELL * 0.5f - CELL_PADDING;
+
+    for (int y = 0; y < ATLAS_CELL; y++) {
+        for (int x = 0; x < ATLAS_CELL; x++) {
+            float alpha = 0.0f;
+            for (int sy = 0; sy < SUPERSAMPLE; sy++) {
+                for (int sx = 0; sx < SUPERSAMPLE; sx++) {
+                    float px = x + (sx + 0.5f) / SUPERSAMPLE - ATLAS_CELL * 0.5f;
+                    float py = y + (sy + 0.5f) / SUPERSAMPLE - ATLAS_CELL * 0.5f;
+                    alpha += profile(std::sqrt(px * px + py * py) / contentRadius);
+                }
+            }
+            alpha /= SUPERSAMPLE * SUPERSAMPLE;
+
+            unsigned char* texel = &pixels[((originY + y) * ATLAS_SIZE + originX + x) * 4];
+            texel[0] = 255;
+            texel[1] = 255;
+            texel[2] = 255;
+            texel[3] = static_cast<unsigned char>(std::clamp(alpha, 0.0f, 1.0f) * 255.0f + 0.5f);
+        }
+    }
+}
+
+ImVec2 cellUv(int cell, float x, float y) {
+    return ImVec2(((cell % ATLAS_COLUMNS) * ATLAS_CELL + x) / ATLAS_SIZE,
+                  ((cell / ATLAS_COLUMNS) * ATLAS_CELL + y) / ATLAS_SIZE);
+}
+
+} // namespace
+
+NoteRenderer::NoteRenderer()
+    : texture(0),
+      bakedRadius(0.0f),
+      atlasFailed(false),
+      drawList(nullptr) {
+}
+
+bool NoteRenderer::buildAtlas(float noteRadius) {
+    std::vector<unsigned char> pixels(ATLAS_SIZE * ATLAS_SIZE * 4, 0);
+
+    // Same layers as the old AddCircleFilled stack: glow 1.8r, body 1.2r, core 0.8r
+    for (int level = 0; level < TAP_LEVELS; level++) {
+        float intensity = static_cast<float>(level) / (TAP_LEVELS - 1);
+        Layer layers[] = {
+            {1.0f, (40.0f + intensity * 60.0f) / 255.0f},
+            {1.2f / 1.8f, (200.0f + intensity * 55.0f) / 255.0f},
+            {0.8f / 1.8f, 1.0f},
+        };
+        fillCell(pixels, SPRITE_TAP + level, [&](float d) { return layeredAlpha(layers, 3, d); });
+    }
+
+    Layer holdStart[] = {{1.0f, 30.0f / 255.0f}, {1.2f / 1.8f, 200.0f / 255.0f}, {0.8f / 1.8f, 1.0f}};
+    fillCell(pixels, SPRITE_HOLD_START, [&](float d) { return layeredAlpha(holdStart, 3, d); });
+
+    Layer holdEnd[] = {{1.0f, 30.0f / 255.0f}, {1.0f / 1.5f, 180.0f / 255.0f}, {0.6f / 1.5f, 220.0f / 255.0f}};
+    fillCell(pixels, SPRITE_HOLD_END, [&](float d) { return layeredAlpha(holdEnd, 3, d); });
+
+    // Two pixel stroke centred on the ring radius, as AddCircle drew it; one cell per
+    // radius the Player draws, since scaling a cell scales its stroke too
+    auto bakeRing = [&](int cell, float ringRadius) {
+        float ringInner = (ringRadius - 1.0f) / (ringRadius + 1.0f);
+        fillCell(pixels, cell, [&](float d) { return (d >= ringInner && d <= 1.0f) ? 1.0f : 0.0f; });
+    };
+    bakeRing(SPRITE_RING, noteRadius * 1.2f);
+    bakeRing(SPRITE_RING_SMALL, noteRadius * 1.0f);
+
+    fillCell(pixels, SPRITE_DOT, [](float d) { return d <= 1.0f ? 1.0f : 0.0f; });
+    fillCell(pixels, SPRITE_WHITE, [](float) { return 1.0f; });
+
+    GLint previousTexture = 0;
+    glGetIntegerv(GL_TEXTURE_BINDING_2D, &previousTexture);
+
+    if (texture == 0) {
+        GLuint created = 0;
+        glGenTextures(1, &created);
+        texture = created;
+    }
+    if (texture == 0) {
+        std::cerr << "Failed to create the note atlas texture" << std::endl;
+        return false;
+    }
+
+    glBindTexture(GL_TEXTURE_2D, texture);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, ATLAS_SIZE, ATLAS_SIZE, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+    glBindTexture(GL_TEXTURE_2D, static_cast<GLuint>(previousTexture));
+
+    bakedRadius = noteRadius;
+    return true;
+}
+
+void NoteRenderer::begin(ImDrawList* list, float noteRadius) {
+    drawList = list;
+    quads.clear();
+
+    if (!atlasFailed && (texture == 0 || bakedRadius != noteRadius)) {
+        atlasFailed = !buildAtlas(noteRadius);
+    }
+}
+
+void NoteRenderer::end() {
+    if (!drawList || texture == 0 || atlasFailed || quads.empty()) {
+        quads.clear();
+        drawList = nullptr;
+        return;
+    }
+
+    // The white cell is sampled at its centre only, so plain rectangles stay solid
+    ImVec2 whiteUv = cellUv(SPRITE_WHITE, ATLAS_CELL * 0.5f, ATLAS_CELL * 0.5f);
+
+    drawList->PushTexture(ImTextureRef(static_cast<ImTextureID>(texture)));
+    for (size_t first = 0; first < quads.size(); first += QUADS_PER_RESERVE) {
+        size_t count = std::min(QUADS_PER_RESERVE, quads.size() - first);
+        drawList->PrimReserve(static_cast<int>(count * 6), static_cast<int>(count * 4));
+
+        for (size_t i = first; i < first + count; i++) {
+            const Quad& quad = quads[i];
+            if (quad.sprite == SPRITE_WHITE) {
+                drawList->PrimRectUV(quad.min, quad.max, whiteUv, whiteUv, quad.color);
+            } else {
+                drawList->PrimRectUV(quad.min, quad.max,
+                                     cellUv(quad.sprite, CELL_PADDING, CELL_PADDING),
+                                     cellUv(quad.sprite, ATLAS_CELL - CELL_PADDING, ATLAS_CELL - CELL_PADDING),
+                                     quad.color);
+            }
+        }
+    }
+    drawList->PopTexture();
+
+    quads.clear();
+    drawList = nullptr;
+}
+
+void NoteRenderer::addSprite(ImVec2 center, float radius, int sprite, ImU32 color) {
+    quads.push_back(Quad{ImVec2(center.x - radius, center.y - radius),
+                         ImVec2(center.x + radius, center.y + radius), sprite, color});
+}
+
+void NoteRenderer::tapNote(ImVec2 center, float noteRadius, ImU32 color, float intensity) {
+    int level = static_cast<int>(std::clamp(intensity, 0.0f, 1.0f) * (TAP_LEVELS - 1) + 0.5f);
+    addSprite(center, noteRadius * 1.8f, SPRITE_TAP + level, color);
+}
+
+void NoteRenderer::holdStart(ImVec2 center, float noteRadius, ImU32 color) {
+    addSprite(center, noteRadius * 1.8f, SPRITE_HOLD_START, color);
+}
+
+void NoteRenderer::holdEnd(ImVec2 center, float noteRadius, ImU32 color) {
+    addSprite(center, noteRadius * 1.5f, SPRITE_HOLD_END, color);
+}
+
+void NoteRenderer::ring(ImVec2 center, float radius, ImU32 color) {
+    int sprite = radius < bakedRadius * 1.1f ? SPRITE_RING_SMALL : SPRITE_RING;
+    addSprite(center, radius + 1.0f, sprite, color);
+}
+
+void NoteRenderer::dot(ImVec2 center, float radius, ImU32 color) {
+    addSprite(center, radius, SPRITE_DOT, color);
+}
+
+void NoteRenderer::rect(ImVec2 min, ImVec2 max, ImU32 color) {
+    quads.push_back(Quad{min, max, SPRITE_WHITE, color});
+}
+
+void NoteRenderer::rectOutline(ImVec2 min, ImVec2 max, ImU32 color, float thickness) {
+    rect(min, ImVec2(max.x, min.y + thickness), color);
+    rect(ImVec2(min.x, max.y - thickness), max, color);
+    rect(ImVec2(min.x, min.y + thickness), ImVec2(min.x + thickness, max.y - thickness), color);
+    rect(ImVec2(max.x - thickness, min.y + thickness), ImVec2(max.x, max.y - thickness), color);
+}
+
+} // Windows
+} // App
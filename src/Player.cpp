@@ -12,13 +12,11 @@ Player::Player()
       currentPosition(0.0),
       songDuration(0.0),
       gameState(MENU),
-      stats({0, 0, 0, 0, 0, 0, 0.0, 0}),
-      judgementWindow(0.2),
-      perfectWindow(0.05),
-      greatWindow(0.10),
-      goodWindow(0.15),
       hitEffects(),
+      hitEffectHead(0),
+      hitEffectCount(0),
       hitSoundPath("assets/hit.wav"),
+      hitSoundLoadFailed(false),
       bpm(120.0f),
       showGrid(true),
       markerInterval(5.0f),
@@ -75,12 +73,7 @@ Player::Player()
       noteBottomColor(ImVec4(1.0f, 0.4f, 0.6f, 1.0f)),
       hitZoneColor(ImVec4(1.0f, 1.0f, 0.0f, 1.0f)),
       comboColor(ImVec4(1.0f, 0.8f, 0.0f, 1.0f)),
-      scoreColor(ImVec4(0.0f, 1.0f, 0.8f, 1.0f)),
-      holdTickInterval(0.1),
-      holdMissThreshold(0.2),
-      holdBreakTime(0.0),
-      fKeyHolding(false),
-      jKeyHolding(false)
+      scoreColor(ImVec4(0.0f, 1.0f, 0.8f, 1.0f))
 {
     calculateGridSpacing();
     refreshFileList();
@@ -96,13 +89,11 @@ Player::Player(SoundManager* soundManager)
       currentPosition(0.0),
       songDuration(0.0),
       gameState(MENU),
-      stats({0, 0, 0, 0, 0, 0, 0.0, 0}),
-      judgementWindow(0.2),
-      perfectWindow(0.05),
-      greatWindow(0.10),
-      goodWindow(0.15),
       hitEffects(),
+      hitEffectHead(0),
+      hitEffectCount(0),
       hitSoundPath("assets/hit.wav"),
+      hitSoundLoadFailed(false),
       bpm(120.0f),
       showGrid(true),
       markerInterval(5.0f),
@@ -159,18 +150,18 @@ Player::Player(SoundManager* soundManager)
       noteBottomColor(ImVec4(1.0f, 0.4f, 0.6f, 1.0f)),
       hitZoneColor(ImVec4(1.0f, 1.0f, 0.0f, 1.0f)),
       comboColor(ImVec4(1.0f, 0.8f, 0.0f, 1.0f)),
-      scoreColor(ImVec4(0.0f, 1.0f, 0.8f, 1.0f)),
-      holdTickInterval(0.1),
-      holdMissThreshold(0.2),
-      holdBreakTime(0.0),
-      fKeyHolding(false),
-      jKeyHolding(false)
+      scoreColor(ImVec4(0.0f, 1.0f, 0.8f, 1.0f))
 {
     calculateGridSpacing();
     refreshFileList();
     loadRecentCharts();
 }
 
+Player::~Player() {
+    // The song may stream from chartFile, which is unmapped right after this body
+    unloadSong();
+}
+
 void Player::render() {
     displaySize = ImGui::GetIO().DisplaySize;
 
@@ -210,11 +201,12 @@ void Player::update() {
     handleKeyboardInput();
     updateAutoscroll();
     updateVisualEffects();
-    updateHitEffects();
     if (gameState == PLAYING) {
         updateGameLogic();
-        updateHoldNotes();
+        // Effects age with the song clock, so they only need frames while it runs
+        Core::getFrameScheduler().requestLowLatency();
     }
+    handleGameplayEvents();
 }
 
 bool Player::loadSong(const std::string& filepath) {
@@ -224,12 +216,14 @@ bool Player::loadSong(const std::string& filepath) {
     if (extension == ".chart") {
         return loadChartFile(filepath);
     } else {
+        unloadSong();
         std::string songName = std::filesystem::path(filepath).filename().string();
-        if (soundManager->loadSound(songName, filepath)) {
+        songHandle = soundManager->loadSound(songName, filepath);
+        if (songHandle) {
             currentSongPath = filepath;
             currentSongName = songName;
             isSongLoaded = true;
-            songDuration = soundManager->getDuration(songName);
+            songDuration = soundManager->getDuration(songHandle);
             currentPosition = 0.0;
 
             std::string chartPath = filepath.substr(0, filepath.find_last_of('.')) + ".chart";
@@ -245,43 +239,45 @@ bool Player::loadSong(const std::string& filepath) {
 void Player::updatePlayback() {
     if (!soundManager || !isSongLoaded || !isPlaying) return;
 
-    currentPosition = soundManager->getPosition(currentSongName);
+    currentPosition = soundManager->getClockTime(songHandle);
 
     if (currentPosition >= songDuration) {
+        // Judge this frame's keys and the tail of the song before the replay is written,
+        // otherwise the live stats would include inputs the replay never saw
+        drainInputQueue();
+        gameplay.update(currentPosition);
         isPlaying = false;
         gameState = RESULTS;
+        clearEffects();
+        saveReplay();
     }
 }
 
-void Player::handleKeyboardInput() {
-    bool fKeyJustPressed = ImGui::IsKeyPressed(ImGuiKey_F);
-    bool jKeyJustPressed = ImGui::IsKeyPressed(ImGuiKey_J);
-    bool fKeyJustReleased = ImGui::IsKeyReleased(ImGuiKey_F);
-    bool jKeyJustReleased = ImGui::IsKeyReleased(ImGuiKey_J);
-
-    if (fKeyJustPressed) {
-        fKeyHolding = true;
-        fKeyPressed = true;
-        lastFKeyTime = currentPosition;
-    }
-    if (fKeyJustReleased) {
-        fKeyHolding = false;
-        fKeyPressed = false;
-    }
+void Player::drainInputQueue() {
+    // Key events come stamped from the GLFW callback, so hits are judged at the
+    // moment they happened instead of at the frame they are noticed in
+    Core::InputEvent event;
+    while (Core::getInputQueue().pop(event)) {
+        double hitTime = currentPosition;
+        if (soundManager && isSongLoaded && isPlaying) {
+            hitTime = soundManager->getClockTimeAt(songHandle, event.time);
+        }
 
-    if (jKeyJustPressed) {
-        jKeyHolding = true;
-        jKeyPressed = true;
-        lastJKeyTime = currentPosition;
-    }
-    if (jKeyJustReleased) {
-        jKeyHolding = false;
-        jKeyPressed = false;
-    }
+        bool& pressed = (event.lane == Core::Lane::TOP) ? fKeyPressed : jKeyPressed;
+        double& lastKeyTime = (event.lane == Core::Lane::TOP) ? lastFKeyTime : lastJKeyTime;
 
-    if (fKeyJustPressed || jKeyJustPressed) {
-        processInput();
+        pressed = event.pressed;
+        if (event.pressed) {
+            lastKeyTime = hitTime;
+            gameplay.press(event.lane, hitTime);
+        } else {
+            gameplay.release(event.lane, hitTime);
+        }
     }
+}
+
+void Player::handleKeyboardInput() {
+    drainInputQueue();
 
     if (ImGui::IsKeyPressed(ImGuiKey_Space) && gameState == PLAYING) {
         pauseGame();
@@ -300,14 +296,6 @@ void Player::calculateGridSpacing() {
     gridSpacing = beat_duration / 4.0f;
 }
 
-bool Player::isKeyHeldForLane(Core::Lane lane) {
-    if (lane == Core::Lane::TOP) {
-        return fKeyHolding;
-    } else {
-        return jKeyHolding;
-    }
-}
-
 void Player::updateAutoscroll() {
     if (gameState == PLAYING) {
         float target_x = currentPosition * zoomLevel;
@@ -345,6 +333,7 @@ void Player::refreshFileList() {
 
         directories.clear();
         files.clear();
+        chartHeaders.clear();
 
         for (const auto& entry : std::filesystem::directory_iterator(currentDirectory)) {
             if (entry.is_directory()) {
@@ -353,6 +342,12 @@ void Player::refreshFileList() {
                 std::string ext = entry.path().extension().string();
                 if (ext == ".chart") {
                     files.push_back(entry.path().filename().string());
+
+                    // Only the header page of each chart is touched
+                    ChartFile chart;
+                    if (chart.open(entry.path().string())) {
+                        chartHeaders[files.back()] = chart.getHeader();
+                    }
                 }
             }
         }
@@ -401,7 +396,7 @@ void Player::drawJudgement() {
 }
 
 void Player::updateGameLogic() {
-    checkNoteHits();
+    gameplay.update(currentPosition);
 
     if (showJudgement) {
         judgementDisplayTime -= ImGui::GetIO().DeltaTime;
@@ -412,315 +407,63 @@ void Player::updateGameLogic() {
     }
 }
 
-void Player::processInput() {
-    double currentTime = currentPosition;
-
-    GameNote* bestTopNote = nullptr;
-    GameNote* bestBottomNote = nullptr;
-    double bestTopTimeDiff = judgementWindow;
-    double bestBottomTimeDiff = judgementWindow;
-
-    for (auto& note : gameNotes) {
-        if (note.isActive && !note.hit) {
-            if (note.type == Core::NoteType::TAP) {
-                double time_diff = std::abs(currentTime - note.timestamp);
-
-                if (time_diff <= judgementWindow) {
-                    if (note.lane == Core::Lane::TOP && time_diff < bestTopTimeDiff) {
-                        bestTopNote = &note;
-                        bestTopTimeDiff = time_diff;
-                    } else if (note.lane == Core::Lane::BOTTOM && time_diff < bestBottomTimeDiff) {
-                        bestBottomNote = &note;
-                        bestBottomTimeDiff = time_diff;
-                    }
-                }
-            } else if (note.type == Core::NoteType::HOLD && !note.isHolding) {
-                double time_diff = std::abs(currentTime - note.timestamp);
-
-                if (time_diff <= judgementWindow) {
-                    if (note.lane == Core::Lane::TOP && time_diff < bestTopTimeDiff) {
-                        bestTopNote = &note;
-                        bestTopTimeDiff = time_diff;
-                    } else if (note.lane == Core::Lane::BOTTOM && time_diff < bestBottomTimeDiff) {
-                        bestBottomNote = &note;
-                        bestBottomTimeDiff = time_diff;
-                    }
-                }
-            }
-        }
-    }
-
-    if (fKeyPressed && bestTopNote) {
-        processNoteHit(*bestTopNote, currentTime);
-    }
-
-    if (jKeyPressed && bestBottomNote) {
-        processNoteHit(*bestBottomNote, currentTime);
-    }
-}
-
-void Player::processNoteHit(GameNote& note, double currentTime) {
-    if (note.type == Core::NoteType::TAP) {
-        note.hit = true;
-        note.hitTime = currentTime;
-        Judgement judgement = calculateJudgement(currentTime, note.timestamp);
-        note.judgement = judgement;
-        updateStats(judgement);
-
-        ImVec2 hitPosition = ImVec2(50.0f, displaySize.y * 0.5f);
-        if (note.lane == Core::Lane::BOTTOM) {
-            hitPosition.y += laneHeight * 0.25f;
+void Player::handleGameplayEvents() {
+    for (const GameplayEvent& event : gameplay.getEvents()) {
+        ImVec2 position = ImVec2(50.0f, displaySize.y * 0.5f);
+        if (event.lane == Core::Lane::BOTTOM) {
+            position.y += laneHeight * 0.25f;
         } else {
-            hitPosition.y -= laneHeight * 0.25f;
+            position.y -= laneHeight * 0.25f;
         }
-        createHitEffect(hitPosition, judgement);
-
-        playHitSound();
-
-        showJudgement = true;
-        judgementDisplayTime = 0.5;
-        switch (judgement) {
-            case PERFECT:
-                lastJudgementText = "PERFECT";
-                lastJudgementColor = ImVec4(1.0f, 1.0f, 0.0f, 1.0f);
-                break;
-            case GREAT:
-                lastJudgementText = "GREAT";
-                lastJudgementColor = ImVec4(0.0f, 1.0f, 0.0f, 1.0f);
-                break;
-            case GOOD:
-                lastJudgementText = "GOOD";
-                lastJudgementColor = ImVec4(0.0f, 0.0f, 1.0f, 1.0f);
+        createHitEffect(position, event.judgement);
+
+        switch (event.type) {
+            case EVENT_HIT:
+            case EVENT_HOLD_START:
+                playHitSound();
+                showJudgement = true;
+                judgementDisplayTime = 0.5;
+                switch (event.judgement) {
+                    case PERFECT:
+                        lastJudgementText = event.type == EVENT_HIT ? "PERFECT" : "HOLD START";
+                        lastJudgementColor = ImVec4(1.0f, 1.0f, 0.0f, 1.0f);
+                        break;
+                    case GREAT:
+                        lastJudgementText = event.type == EVENT_HIT ? "GREAT" : "HOLD START";
+                        lastJudgementColor = ImVec4(0.0f, 1.0f, 0.0f, 1.0f);
+                        break;
+                    case GOOD:
+                        lastJudgementText = event.type == EVENT_HIT ? "GOOD" : "HOLD START";
+                        lastJudgementColor = ImVec4(0.0f, 0.0f, 1.0f, 1.0f);
+                        break;
+                    case MISS:
+                        lastJudgementText = "MISS";
+                        lastJudgementColor = ImVec4(1.0f, 0.0f, 0.0f, 1.0f);
+                        break;
+                }
                 break;
-            case MISS:
-                lastJudgementText = "MISS";
+            case EVENT_HOLD_BREAK:
+                showJudgement = true;
+                judgementDisplayTime = 0.5;
+                lastJudgementText = "HOLD BREAK";
                 lastJudgementColor = ImVec4(1.0f, 0.0f, 0.0f, 1.0f);
                 break;
-        }
-    } else if (note.type == Core::NoteType::HOLD) {
-        note.isHolding = true;
-        note.holdStartTime = currentTime;
-        note.hitTime = currentTime;
-        note.lastHoldTickTime = currentTime;
-        note.holdTicks = 0;
-        note.totalHoldTicks = static_cast<int>((note.endTimestamp - note.timestamp) / holdTickInterval) + 1;
-
-        Judgement judgement = calculateJudgement(currentTime, note.timestamp);
-        note.judgement = judgement;
-        updateStats(judgement);
-
-        ImVec2 hitPosition = ImVec2(50.0f, displaySize.y * 0.5f);
-        if (note.lane == Core::Lane::BOTTOM) {
-            hitPosition.y += laneHeight * 0.25f;
-        } else {
-            hitPosition.y -= laneHeight * 0.25f;
-        }
-        createHitEffect(hitPosition, judgement);
-
-        playHitSound();
-
-        showJudgement = true;
-        judgementDisplayTime = 0.5;
-        switch (judgement) {
-            case PERFECT:
-                lastJudgementText = "HOLD START";
-                lastJudgementColor = ImVec4(1.0f, 1.0f, 0.0f, 1.0f);
-                break;
-            case GREAT:
-                lastJudgementText = "HOLD START";
+            case EVENT_HOLD_COMPLETE:
+                showJudgement = true;
+                judgementDisplayTime = 0.5;
+                lastJudgementText = "HOLD COMPLETE";
                 lastJudgementColor = ImVec4(0.0f, 1.0f, 0.0f, 1.0f);
                 break;
-            case GOOD:
-                lastJudgementText = "HOLD START";
-                lastJudgementColor = ImVec4(0.0f, 0.0f, 1.0f, 1.0f);
+            case EVENT_MISS:
                 break;
-            case MISS:
-                lastJudgementText = "MISS";
-                lastJudgementColor = ImVec4(1.0f, 0.0f, 0.0f, 1.0f);
-                break;
-        }
-    }
-}
-
-void Player::updateHoldNotes() {
-    double currentTime = currentPosition;
-
-    for (auto& note : gameNotes) {
-        if (note.isActive && note.isHolding && !note.hit) {
-            if (!isKeyHeldForLane(note.lane)) {
-                breakHoldNote(note, "Key released");
-                continue;
-            }
-
-            if (currentTime >= note.endTimestamp) {
-                completeHoldNote(note);
-                continue;
-            }
-
-            if (currentTime - note.lastHoldTickTime >= holdTickInterval) {
-                processHoldTick(note);
-            }
-        }
-    }
-}
-
-void Player::processHoldTick(GameNote& note) {
-    double currentTime = currentPosition;
-    note.lastHoldTickTime = currentTime;
-    note.holdTicks++;
-
-    stats.score += 5;
-
-    if (note.totalHoldTicks > 0) {
-        note.holdAccuracy = static_cast<double>(note.holdTicks) / note.totalHoldTicks;
-    }
-}
-
-void Player::breakHoldNote(GameNote& note, const std::string& reason) {
-    note.isHolding = false;
-    note.hit = true;
-    note.holdCompleted = false;
-    note.judgement = MISS;
-    updateStats(MISS);
-    stats.combo = 0;
-
-    ImVec2 missPosition = ImVec2(50.0f, displaySize.y * 0.5f);
-    if (note.lane == Core::Lane::BOTTOM) {
-        missPosition.y += laneHeight * 0.25f;
-    } else {
-        missPosition.y -= laneHeight * 0.25f;
-    }
-    createHitEffect(missPosition, MISS);
-
-    showJudgement = true;
-    judgementDisplayTime = 0.5;
-    lastJudgementText = "HOLD BREAK";
-    lastJudgementColor = ImVec4(1.0f, 0.0f, 0.0f, 1.0f);
-}
-
-void Player::completeHoldNote(GameNote& note) {
-    note.isHolding = false;
-    note.hit = true;
-    note.holdCompleted = true;
-
-    if (note.totalHoldTicks > 0) {
-        note.holdAccuracy = static_cast<double>(note.holdTicks) / note.totalHoldTicks;
-    }
-
-    int holdBonus = static_cast<int>(note.holdAccuracy * 50);
-    stats.score += holdBonus;
-
-    ImVec2 hitPosition = ImVec2(50.0f, displaySize.y * 0.5f);
-    if (note.lane == Core::Lane::BOTTOM) {
-        hitPosition.y += laneHeight * 0.25f;
-    } else {
-        hitPosition.y -= laneHeight * 0.25f;
-    }
-    createHitEffect(hitPosition, note.judgement);
-
-    showJudgement = true;
-    judgementDisplayTime = 0.5;
-    lastJudgementText = "HOLD COMPLETE";
-    lastJudgementColor = ImVec4(0.0f, 1.0f, 0.0f, 1.0f);
-}
-
-void Player::checkNoteHits() {
-    double currentTime = currentPosition;
-
-    for (auto& note : gameNotes) {
-        if (note.isActive && !note.hit) {
-            if (note.type == Core::NoteType::TAP) {
-                if (currentTime - note.timestamp > judgementWindow) {
-                    note.hit = true;
-                    note.judgement = MISS;
-                    updateStats(MISS);
-                    stats.combo = 0;
-
-                    ImVec2 missPosition = ImVec2(50.0f, displaySize.y * 0.5f);
-                    if (note.lane == Core::Lane::BOTTOM) {
-                        missPosition.y += laneHeight * 0.25f;
-                    } else {
-                        missPosition.y -= laneHeight * 0.25f;
-                    }
-                    createHitEffect(missPosition, MISS);
-                }
-            } else if (note.type == Core::NoteType::HOLD) {
-                if (!note.isHolding && currentTime - note.timestamp > judgementWindow) {
-                    note.hit = true;
-                    note.judgement = MISS;
-                    note.holdCompleted = false;
-                    updateStats(MISS);
-                    stats.combo = 0;
-
-                    ImVec2 missPosition = ImVec2(50.0f, displaySize.y * 0.5f);
-                    if (note.lane == Core::Lane::BOTTOM) {
-                        missPosition.y += laneHeight * 0.25f;
-                    } else {
-                        missPosition.y -= laneHeight * 0.25f;
-                    }
-                    createHitEffect(missPosition, MISS);
-                }
-            }
         }
     }
+    gameplay.clearEvents();
 }
 
-Judgement Player::calculateJudgement(double hitTime, double noteTime) {
-    double time_diff = std::abs(hitTime - noteTime);
-
-    if (time_diff <= perfectWindow) {
-        return PERFECT;
-    } else if (time_diff <= greatWindow) {
-        return GREAT;
-    } else if (time_diff <= goodWindow) {
-        return GOOD;
-    } else {
-        return MISS;
-    }
-}
-
-void Player::updateStats(Judgement judgement) {
-    switch (judgement) {
-        case PERFECT:
-            stats.perfect++;
-            stats.combo++;
-            stats.score += 100;
-            break;
-        case GREAT:
-            stats.great++;
-            stats.combo++;
-            stats.score += 50;
-            break;
-        case GOOD:
-            stats.good++;
-            stats.combo++;
-            stats.score += 25;
-            break;
-        case MISS:
-            stats.miss++;
-            stats.combo = 0;
-            break;
-    }
-
-    if (stats.combo > stats.maxCombo) {
-        stats.maxCombo = stats.combo;
-    }
-
-    int total_notes = stats.perfect + stats.great + stats.good + stats.miss;
-    if (total_notes > 0) {
-        double weighted_score = (stats.perfect * 100.0) + (stats.great * 80.0) + (stats.good * 60.0);
-        stats.accuracy = weighted_score / total_notes;
-    }
-
-    recentJudgements.push_back(judgement);
-    if (recentJudgements.size() > 10) {
-        recentJudgements.pop_front();
-    }
-}
-
-
-
 void Player::drawResults() {
+    const GameStats& stats = gameplay.getStats();
+
     ImGui::SetNextWindowPos(ImVec2(displaySize.x * 0.5f - 200, displaySize.y * 0.5f - 150));
     ImGui::SetNextWindowSize(ImVec2(400, 300));
 
@@ -744,6 +487,10 @@ void Player::drawResults() {
     ImGui::TextColored(ImVec4(0.0f, 0.0f, 1.0f, 1.0f), "Good: %d", stats.good);
     ImGui::TextColored(ImVec4(1.0f, 0.0f, 0.0f, 1.0f), "Miss: %d", stats.miss);
 
+    if (!lastReplayPath.empty()) {
+        ImGui::TextColored(ImVec4(0.6f, 0.6f, 0.6f, 1.0f), "Replay: %s", lastReplayPath.c_str());
+    }
+
     ImGui::Separator();
 
     if (ImGui::Button("PLAY AGAIN", ImVec2(120, 30))) {
@@ -760,6 +507,33 @@ void Player::drawResults() {
     ImGui::End();
 }
 
+bool Player::saveReplay() {
+    lastReplayPath.clear();
+
+    std::error_code error;
+    std::filesystem::create_directories(REPLAY_DIRECTORY, error);
+    if (error) {
+        std::cerr << "Failed to create replay directory: " << error.message() << std::endl;
+        return false;
+    }
+
+    char stamp[32];
+    std::time_t now = std::time(nullptr);
+    std::strftime(stamp, sizeof(stamp), "%Y%m%d_%H%M%S", std::localtime(&now));
+
+    std::string chartName = std::filesystem::path(currentSongPath).stem().string();
+    std::string path = (std::filesystem::path(REPLAY_DIRECTORY) / (chartName + "_" + stamp + REPLAY_EXTENSION)).string();
+
+    // The recorded end time is the last time the core judged, so a verifier stops where the play did
+    if (!Replay::record(gameplay).save(path)) {
+        return false;
+    }
+
+    lastReplayPath = path;
+    std::cout << "Replay saved: " << path << std::endl;
+    return true;
+}
+
 void Player::drawMainMenu() {
     const ImGuiViewport* main_viewport = ImGui::GetMainViewport();
     ImGui::SetNextWindowPos(ImVec2(main_viewport->WorkPos.x + 50, main_viewport->WorkPos.y + 50), ImGuiCond_FirstUseEver);
@@ -812,7 +586,7 @@ void Player::drawMainMenu() {
         ImGui::TextColored(ImVec4(1.0f, 0.8f, 0.0f, 1.0f), "Current Chart:");
         ImGui::TextColored(ImVec4(1.0f, 1.0f, 1.0f, 1.0f), "Title: %s", chartTitle.c_str());
         ImGui::TextColored(ImVec4(1.0f, 1.0f, 1.0f, 1.0f), "Artist: %s", chartArtist.c_str());
-        ImGui::TextColored(ImVec4(1.0f, 1.0f, 1.0f, 1.0f), "Notes: %zu", gameNotes.size());
+        ImGui::TextColored(ImVec4(1.0f, 1.0f, 1.0f, 1.0f), "Notes: %zu", gameplay.getNotes().size());
 
         ImGui::Spacing();
         if (ImGui::Button("Chart Details", ImVec2(120, 25))) {
@@ -915,6 +689,14 @@ void Player::drawChartBrowser() {
                 selectedFileIndex = static_cast<int>(i);
             }
 
+            auto headerIt = chartHeaders.find(files[i]);
+            if (headerIt != chartHeaders.end()) {
+                ImGui::SameLine();
+                ImGui::TextColored(ImVec4(0.7f, 0.7f, 0.7f, 1.0f), "%s - %s | %u notes | %.0f BPM | %.1fs",
+                                   headerIt->second.title, headerIt->second.artist, headerIt->second.notesCount,
+                                   headerIt->second.bpm, headerIt->second.duration);
+            }
+
             if (ImGui::IsMouseDoubleClicked(0) && ImGui::IsItemHovered()) {
                 std::string fullPath = currentDirectory + "/" + files[i];
                 if (loadSong(fullPath)) {
@@ -947,21 +729,16 @@ void Player::drawChartBrowser() {
 }
 
 void Player::resetGame() {
-    stats = {0, 0, 0, 0, 0, 0, 0.0, 0};
     currentPosition = 0.0;
-    recentJudgements.clear();
-    hitEffects.clear();
-
-    for (auto& note : gameNotes) {
-        note.hit = false;
-        note.isActive = true;
-        note.isHolding = false;
-        note.holdCompleted = false;
-        note.holdAccuracy = 0.0;
-        note.holdTicks = 0;
-        note.totalHoldTicks = 0;
-        note.lastHoldTickTime = 0.0;
-    }
+    clearEffects();
+    gameplay.reset();
+}
+
+void Player::clearEffects() {
+    hitEffectHead = 0;
+    hitEffectCount = 0;
+    showJudgement = false;
+    lastJudgementText.clear();
 }
 
 void Player::startGame() {
@@ -970,7 +747,8 @@ void Player::startGame() {
     gameState = PLAYING;
     isPlaying = true;
     currentPosition = 0.0;
-    soundManager->playSound(currentSongName);
+    loadHitSound();
+    soundManager->playSound(songHandle);
     resetGame();
 }
 
@@ -979,7 +757,8 @@ void Player::pauseGame() {
 
     gameState = PAUSED;
     isPlaying = false;
-    soundManager->pauseSound(currentSongName);
+    clearEffects();
+    soundManager->pauseSound(songHandle);
 }
 
 void Player::resumeGame() {
@@ -987,129 +766,60 @@ void Player::resumeGame() {
 
     gameState = PLAYING;
     isPlaying = true;
-    soundManager->resumeSound(currentSongName);
+    soundManager->resumeSound(songHandle);
 }
 
-bool Player::loadChartFile(const std::string& filepath) {
-    cleanupTempFiles();
-
-    std::ifstream file(filepath, std::ios::binary);
-    if (!file.is_open()) {
-        std::cerr << "Failed to open chart file: " << filepath << std::endl;
-        return false;
+void Player::unloadSong() {
+    if (soundManager && isSongLoaded) {
+        soundManager->stopSound(songHandle);
+        soundManager->unloadSound(songHandle);
     }
+    isSongLoaded = false;
+    isPlaying = false;
+}
 
-    ChartHeader header;
-    file.read(reinterpret_cast<char*>(&header), sizeof(ChartHeader));
-
-    if (std::string(header.magic) != "NOTARHYTHM") {
-        std::cerr << "Invalid chart file format - wrong magic number: " << header.magic << std::endl;
-        return false;
-    }
+bool Player::loadChartFile(const std::string& filepath) {
+    // The previous song may still be streaming from the current mapping
+    unloadSong();
 
-    if (header.version < 1 || header.version > 2) {
-        std::cerr << "Unsupported chart file version: " << header.version << std::endl;
+    if (!chartFile.open(filepath)) {
+        std::cerr << chartFile.getLastError() << std::endl;
         return false;
     }
 
+    const ChartHeader& header = chartFile.getHeader();
     chartTitle = header.title;
     chartArtist = header.artist;
     bpm = header.bpm;
     songDuration = header.duration;
 
-    std::vector<char> audioData(header.audioSize);
-    file.read(audioData.data(), header.audioSize);
-    if (!file.good()) {
-        std::cerr << "Failed to read audio data from chart" << std::endl;
+    if (chartFile.getAudioSize() == 0) {
+        std::cerr << "Chart has no embedded audio" << std::endl;
         return false;
     }
 
-    std::filesystem::path chartPath(filepath);
-    std::string tempAudioPath = chartPath.parent_path().string() + "/temp_audio_" + chartPath.stem().string() + ".wav";
-
-    if (!writeAudioFile(tempAudioPath, audioData)) {
-        std::cerr << "Failed to write temporary audio file: " << tempAudioPath << std::endl;
-        return false;
-    }
-
-    std::string songName = chartPath.stem().string();
-    if (!soundManager->loadSound(songName, tempAudioPath)) {
+    // BASS streams the embedded audio straight out of the mapping
+    std::string songName = std::filesystem::path(filepath).stem().string();
+    songHandle = soundManager->loadSoundFromMemory(songName, chartFile.getAudioData(), chartFile.getAudioSize());
+    if (!songHandle) {
         std::cerr << "Failed to load audio from chart" << std::endl;
-        std::filesystem::remove(tempAudioPath);
         return false;
     }
 
-    currentSongPath = tempAudioPath;
+    currentSongPath = filepath;
     currentSongName = songName;
     isSongLoaded = true;
     currentPosition = 0.0;
     isPlaying = false;
 
-    gameNotes.clear();
-    for (uint32_t i = 0; i < header.notesCount; ++i) {
-        GameNote note;
-        file.read(reinterpret_cast<char*>(&note.id), sizeof(int));
-        file.read(reinterpret_cast<char*>(&note.lane), sizeof(Core::Lane));
-
-        if (header.version >= 2) {
-            file.read(reinterpret_cast<char*>(&note.type), sizeof(Core::NoteType));
-            file.read(reinterpret_cast<char*>(&note.timestamp), sizeof(double));
-            file.read(reinterpret_cast<char*>(&note.endTimestamp), sizeof(double));
-        } else {
-            // Version 1 compatibility - all notes are TAP notes
-            note.type = Core::NoteType::TAP;
-            file.read(reinterpret_cast<char*>(&note.timestamp), sizeof(double));
-            note.endTimestamp = note.timestamp;
-        }
-
-        note.hit = false;
-        note.judgement = MISS;
-        note.hitTime = 0.0;
-        note.isActive = true;
-        note.isHolding = false;
-        note.holdStartTime = 0.0;
-        note.holdCompleted = false;
-        note.holdAccuracy = 0.0;
-        note.holdTicks = 0;
-        note.totalHoldTicks = 0;
-        note.lastHoldTickTime = 0.0;
-        gameNotes.push_back(note);
-    }
+    gameplay.loadChart(chartFile);
 
     calculateGridSpacing();
     std::cout << "Successfully loaded chart: " << chartTitle << " by " << chartArtist << std::endl;
-    std::cout << "Notes loaded: " << gameNotes.size() << std::endl;
+    std::cout << "Notes loaded: " << gameplay.getNotes().size() << std::endl;
     return true;
 }
 
-std::vector<char> Player::readAudioFile(const std::string& filepath) {
-    std::ifstream file(filepath, std::ios::binary);
-    if (!file.is_open()) {
-        return {};
-    }
-
-    file.seekg(0, std::ios::end);
-    size_t file_size = file.tellg();
-    file.seekg(0, std::ios::beg);
-
-    std::vector<char> buffer(file_size);
-    file.read(buffer.data(), file_size);
-
-    return buffer;
-}
-
-bool Player::writeAudioFile(const std::string& filepath, const std::vector<char>& audioData) {
-    std::ofstream file(filepath, std::ios::binary);
-    if (!file.is_open()) {
-        return false;
-    }
-
-    file.write(audioData.data(), audioData.size());
-    return true;
-}
-
-
-
 void Player::drawGameplayWindow() {
     ImGui::Begin("Not A Game", nullptr, ImGuiWindowFlags_NoCollapse);
 
@@ -1132,6 +842,8 @@ void Player::drawGameplayWindow() {
 }
 
 void Player::drawStatsWindow() {
+    const GameStats& stats = gameplay.getStats();
+
     ImGui::Begin("Stats", nullptr, ImGuiWindowFlags_NoCollapse);
 
     ImGui::PushStyleColor(ImGuiCol_WindowBg, ImVec4(0.1f, 0.1f, 0.15f, 0.9f));
@@ -1215,7 +927,7 @@ void Player::drawSongInfoWindow() {
     ImGui::TextColored(ImVec4(1.0f, 1.0f, 1.0f, 1.0f), "Artist: %s", chartArtist.c_str());
     ImGui::TextColored(ImVec4(1.0f, 1.0f, 1.0f, 1.0f), "BPM: %.1f", bpm);
     ImGui::TextColored(ImVec4(1.0f, 1.0f, 1.0f, 1.0f), "Duration: %.1fs", songDuration);
-    ImGui::TextColored(ImVec4(1.0f, 1.0f, 1.0f, 1.0f), "Notes: %zu", gameNotes.size());
+    ImGui::TextColored(ImVec4(1.0f, 1.0f, 1.0f, 1.0f), "Notes: %zu", gameplay.getNotes().size());
 
     ImGui::PopStyleColor();
     ImGui::End();
@@ -1225,7 +937,7 @@ void Player::updateVisualEffects() {
     float deltaTime = ImGui::GetIO().DeltaTime;
     effectTimer += deltaTime;
 
-    if (stats.combo > 0) {
+    if (gameplay.getStats().combo > 0) {
         comboScale = 1.0f + std::sin(effectTimer * 5.0f) * 0.1f;
     } else {
         comboScale = 1.0f;
@@ -1272,13 +984,24 @@ void Player::drawGameplayLanes() {
 
 void Player::drawApproachingNotes() {
     ImDrawList* draw_list = ImGui::GetWindowDrawList();
+    noteRenderer.begin(draw_list, noteRadius);
     ImVec2 window_pos = ImGui::GetWindowPos();
     ImVec2 window_size = ImGui::GetWindowSize();
 
     float lane_y = window_pos.y + window_size.y * 0.5f;
     float lane_width = window_size.x - 100.0f;
 
-    for (const auto& note : gameNotes) {
+    // Notes whose end is before the lower bound are gone, and a note starting
+    // more than the approach time (plus the hit zone margin) ahead is off screen
+    const std::vector<GameNote>& notes = gameplay.getNotes();
+    double judgementWindow = gameplay.getJudgementWindow();
+    double visibleFrom = currentPosition - judgementWindow;
+    double visibleUntil = currentPosition + approachTime * (1.0 + 50.0 / std::max(lane_width, 1.0f));
+
+    for (size_t i = gameplay.firstNoteEndingAfter(visibleFrom); i < notes.size(); i++) {
+        const GameNote& note = notes[i];
+        if (note.timestamp > visibleUntil) break;
+
         if (note.isActive) {
             if (note.type == Core::NoteType::TAP) {
                 if (note.hit) continue;
@@ -1301,23 +1024,11 @@ void Player::drawApproachingNotes() {
                         ImVec2 note_center(note_x, note_y);
 
                         float approach_intensity = 1.0f - progress;
-                        float glow_alpha = 40 + (int)(approach_intensity * 60);
-                        float main_alpha = 200 + (int)(approach_intensity * 55);
 
-                        draw_list->AddCircleFilled(note_center, noteRadius * 1.8f,
-                                                 IM_COL32(note_color.x * 255, note_color.y * 255,
-                                                        note_color.z * 255, (int)glow_alpha));
-
-                        draw_list->AddCircleFilled(note_center, noteRadius * 1.2f,
-                                                 IM_COL32(note_color.x * 255, note_color.y * 255,
-                                                        note_color.z * 255, (int)main_alpha));
-
-                        draw_list->AddCircleFilled(note_center, noteRadius * 0.8f,
-                                                 IM_COL32(note_color.x * 255, note_color.y * 255,
-                                                        note_color.z * 255, 255));
-
-                        draw_list->AddCircle(note_center, noteRadius * 1.2f,
-                                           IM_COL32(255, 255, 255, 200), 24, 2.0f);
+                        noteRenderer.tapNote(note_center, noteRadius,
+                                             IM_COL32(note_color.x * 255, note_color.y * 255, note_color.z * 255, 255),
+                                             approach_intensity);
+                        noteRenderer.ring(note_center, noteRadius * 1.2f, IM_COL32(255, 255, 255, 200));
                     }
                 }
             } else if (note.type == Core::NoteType::HOLD) {
@@ -1356,38 +1067,31 @@ void Player::drawApproachingNotes() {
 
                         float hold_height = noteRadius * 1.2f;
 
-                        draw_list->AddRectFilled(
+                        noteRenderer.rect(
                             ImVec2(display_start_x, note_y - hold_height * 0.5f),
                             ImVec2(display_end_x, note_y + hold_height * 0.5f),
                             IM_COL32(note_color.x * 255, note_color.y * 255, note_color.z * 255, (int)(120 * alpha))
                         );
 
-                        draw_list->AddRect(
+                        noteRenderer.rectOutline(
                             ImVec2(display_start_x, note_y - hold_height * 0.5f),
                             ImVec2(display_end_x, note_y + hold_height * 0.5f),
                             IM_COL32(note_color.x * 255, note_color.y * 255, note_color.z * 255, (int)(200 * alpha)),
-                            0.0f, 0, 2.0f
+                            2.0f
                         );
 
+                        int cap_alpha = std::min(255, (int)(255 * alpha));
+
                         if (start_x >= window_pos.x - noteRadius * 2.0f &&
                             start_x <= window_pos.x + window_size.x + noteRadius * 2.0f) {
 
                             ImVec2 start_center(start_x, note_y);
 
-                            draw_list->AddCircleFilled(start_center, noteRadius * 1.8f,
-                                                     IM_COL32(note_color.x * 255, note_color.y * 255,
-                                                            note_color.z * 255, 30));
-
-                            draw_list->AddCircleFilled(start_center, noteRadius * 1.2f,
-                                                     IM_COL32(note_color.x * 255, note_color.y * 255,
-                                                            note_color.z * 255, (int)(200 * alpha)));
-
-                            draw_list->AddCircleFilled(start_center, noteRadius * 0.8f,
-                                                     IM_COL32(note_color.x * 255, note_color.y * 255,
-                                                            note_color.z * 255, (int)(255 * alpha)));
-
-                            draw_list->AddCircle(start_center, noteRadius * 1.2f,
-                                               IM_COL32(255, 255, 255, (int)(200 * alpha)), 24, 2.0f);
+                            noteRenderer.holdStart(start_center, noteRadius,
+                                                   IM_COL32(note_color.x * 255, note_color.y * 255,
+                                                          note_color.z * 255, cap_alpha));
+                            noteRenderer.ring(start_center, noteRadius * 1.2f,
+                                              IM_COL32(255, 255, 255, std::min(255, (int)(200 * alpha))));
                         }
 
                         if (end_x >= window_pos.x - noteRadius * 2.0f &&
@@ -1395,20 +1099,11 @@ void Player::drawApproachingNotes() {
 
                             ImVec2 end_center(end_x, note_y);
 
-                            draw_list->AddCircleFilled(end_center, noteRadius * 1.5f,
-                                                     IM_COL32(note_color.x * 255, note_color.y * 255,
-                                                            note_color.z * 255, 30));
-
-                            draw_list->AddCircleFilled(end_center, noteRadius * 1.0f,
-                                                     IM_COL32(note_color.x * 255, note_color.y * 255,
-                                                            note_color.z * 255, (int)(180 * alpha)));
-
-                            draw_list->AddCircleFilled(end_center, noteRadius * 0.6f,
-                                                     IM_COL32(note_color.x * 255, note_color.y * 255,
-                                                            note_color.z * 255, (int)(220 * alpha)));
-
-                            draw_list->AddCircle(end_center, noteRadius * 1.0f,
-                                               IM_COL32(255, 255, 255, (int)(180 * alpha)), 24, 2.0f);
+                            noteRenderer.holdEnd(end_center, noteRadius,
+                                                 IM_COL32(note_color.x * 255, note_color.y * 255,
+                                                        note_color.z * 255, cap_alpha));
+                            noteRenderer.ring(end_center, noteRadius * 1.0f,
+                                              IM_COL32(255, 255, 255, std::min(255, (int)(180 * alpha))));
                         }
 
                         if (note.isHolding) {
@@ -1424,7 +1119,7 @@ void Player::drawApproachingNotes() {
                             float pulse_x = display_start_x + (display_end_x - display_start_x) * static_cast<float>(hold_progress);
 
                             if (pulse_x >= window_pos.x && pulse_x <= window_pos.x + window_size.x) {
-                                draw_list->AddCircleFilled(
+                                noteRenderer.dot(
                                     ImVec2(pulse_x, note_y),
                                     pulse_radius,
                                     IM_COL32(255, 255, 255, (int)(100 * pulse))
@@ -1436,33 +1131,46 @@ void Player::drawApproachingNotes() {
             }
         }
     }
+
+    noteRenderer.end();
 }
 
 void Player::drawHitEffects() {
     ImDrawList* draw_list = ImGui::GetWindowDrawList();
     ImVec2 window_pos = ImGui::GetWindowPos();
 
-    for (const auto& effect : hitEffects) {
-        if (!effect.active) continue;
+    // Expired effects are retired from the head, the rest are aged and drawn in the same pass
+    while (hitEffectCount > 0 && currentPosition - hitEffects[hitEffectHead].startTime >= hitEffects[hitEffectHead].duration) {
+        hitEffectHead = (hitEffectHead + 1) % HIT_EFFECT_CAPACITY;
+        hitEffectCount--;
+    }
+
+    for (size_t i = 0; i < hitEffectCount; i++) {
+        const HitEffect& effect = hitEffects[(hitEffectHead + i) % HIT_EFFECT_CAPACITY];
+        float progress = (float)((currentPosition - effect.startTime) / effect.duration);
+        if (progress >= 1.0f) continue;
+
+        float scale = 0.3f + progress * 1.0f;
+        float alpha = 0.7f - progress * 0.7f;
 
         ImVec4 color;
         switch (effect.judgement) {
             case PERFECT:
-                color = ImVec4(1.0f, 1.0f, 0.0f, effect.alpha);
+                color = ImVec4(1.0f, 1.0f, 0.0f, alpha);
                 break;
             case GREAT:
-                color = ImVec4(0.0f, 1.0f, 0.0f, effect.alpha);
+                color = ImVec4(0.0f, 1.0f, 0.0f, alpha);
                 break;
             case GOOD:
-                color = ImVec4(0.0f, 0.0f, 1.0f, effect.alpha);
+                color = ImVec4(0.0f, 0.0f, 1.0f, alpha);
                 break;
             case MISS:
-                color = ImVec4(1.0f, 0.0f, 0.0f, effect.alpha);
+                color = ImVec4(1.0f, 0.0f, 0.0f, alpha);
                 break;
         }
 
         ImVec2 center = ImVec2(window_pos.x + effect.position.x, window_pos.y + effect.position.y);
-        float radius = noteRadius * effect.scale;
+        float radius = noteRadius * scale;
 
         draw_list->AddCircleFilled(center, radius * 1.2f,
                                   IM_COL32(color.x * 255, color.y * 255, color.z * 255,
@@ -1475,7 +1183,7 @@ void Player::drawHitEffects() {
         draw_list->AddCircleFilled(center, radius * 0.7f,
                                   IM_COL32(255, 255, 255, (int)(color.w * 80)));
 
-        std::string judgementText;
+        const char* judgementText = "MISS";
         switch (effect.judgement) {
             case PERFECT: judgementText = "PERFECT"; break;
             case GREAT: judgementText = "GREAT"; break;
@@ -1483,27 +1191,27 @@ void Player::drawHitEffects() {
             case MISS: judgementText = "MISS"; break;
         }
 
-        ImVec2 text_size = ImGui::CalcTextSize(judgementText.c_str());
-        ImVec2 text_pos(center.x - text_size.x * 0.5f * effect.scale,
-                       center.y - text_size.y * 0.5f * effect.scale);
+        ImVec2 text_size = ImGui::CalcTextSize(judgementText);
+        ImVec2 text_pos(center.x - text_size.x * 0.5f * scale,
+                       center.y - text_size.y * 0.5f * scale);
 
-        draw_list->AddText(nullptr, text_size.x * effect.scale,
+        draw_list->AddText(nullptr, text_size.x * scale,
                           ImVec2(text_pos.x + 1, text_pos.y + 1),
                           IM_COL32(0, 0, 0, (int)(color.w * 100)),
-                          judgementText.c_str());
+                          judgementText);
 
-        draw_list->AddText(nullptr, text_size.x * effect.scale, text_pos,
+        draw_list->AddText(nullptr, text_size.x * scale, text_pos,
                           IM_COL32(color.x * 255, color.y * 255, color.z * 255,
                                   (int)(color.w * 180)),
-                          judgementText.c_str());
+                          judgementText);
 
         for (int i = 0; i < 4; ++i) {
             float angle = (float)i * 3.14159f * 2.0f / 4.0f;
-            float distance = radius * 0.8f * effect.scale;
+            float distance = radius * 0.8f * scale;
             ImVec2 particle_pos(center.x + cos(angle) * distance,
                                center.y + sin(angle) * distance);
 
-            draw_list->AddCircleFilled(particle_pos, 2.0f * effect.scale,
+            draw_list->AddCircleFilled(particle_pos, 2.0f * scale,
                                       IM_COL32(color.x * 255, color.y * 255, color.z * 255,
                                               (int)(color.w * 80)));
         }
@@ -1511,6 +1219,7 @@ void Player::drawHitEffects() {
 }
 
 void Player::drawComboDisplay() {
+    const GameStats& stats = gameplay.getStats();
     ImDrawList* draw_list = ImGui::GetWindowDrawList();
     ImVec2 window_pos = ImGui::GetWindowPos();
     ImVec2 window_size = ImGui::GetWindowSize();
@@ -1535,7 +1244,7 @@ void Player::drawScoreDisplay() {
     ImVec2 window_pos = ImGui::GetWindowPos();
     ImVec2 window_size = ImGui::GetWindowSize();
 
-    std::string score_text = std::to_string(stats.score);
+    std::string score_text = std::to_string(gameplay.getStats().score);
     ImVec2 text_size = ImGui::CalcTextSize(score_text.c_str());
     ImVec2 text_pos(window_pos.x + window_size.x * 0.5f - text_size.x * 0.5f * scoreScale,
                    window_pos.y + window_size.y * 0.1f - text_size.y * 0.5f * scoreScale);
@@ -1590,7 +1299,7 @@ void Player::drawChartInfo() {
         ImGui::TextColored(ImVec4(1.0f, 1.0f, 1.0f, 1.0f), "Artist: %s", chartArtist.c_str());
         ImGui::TextColored(ImVec4(1.0f, 1.0f, 1.0f, 1.0f), "BPM: %.1f", bpm);
         ImGui::TextColored(ImVec4(1.0f, 1.0f, 1.0f, 1.0f), "Duration: %.1fs", songDuration);
-        ImGui::TextColored(ImVec4(1.0f, 1.0f, 1.0f, 1.0f), "Notes: %zu", gameNotes.size());
+        ImGui::TextColored(ImVec4(1.0f, 1.0f, 1.0f, 1.0f), "Notes: %zu", gameplay.getNotes().size());
 
         ImGui::Spacing();
         ImGui::Separator();
@@ -1659,65 +1368,39 @@ void Player::addToRecentCharts(const std::string& chartPath) {
 }
 
 void Player::createHitEffect(const ImVec2& position, Judgement judgement) {
-    HitEffect effect;
+    size_t slot;
+    if (hitEffectCount < HIT_EFFECT_CAPACITY) {
+        slot = (hitEffectHead + hitEffectCount) % HIT_EFFECT_CAPACITY;
+        hitEffectCount++;
+    } else {
+        slot = hitEffectHead;
+        hitEffectHead = (hitEffectHead + 1) % HIT_EFFECT_CAPACITY;
+    }
+
+    HitEffect& effect = hitEffects[slot];
     effect.position = position;
-    effect.scale = 0.3f;
-    effect.alpha = 0.7f;
     effect.startTime = currentPosition;
     effect.duration = 0.5f;
     effect.judgement = judgement;
-    effect.active = true;
-
-    hitEffects.push_back(effect);
 }
 
-void Player::updateHitEffects() {
-    double currentTime = currentPosition;
-
-    for (auto it = hitEffects.begin(); it != hitEffects.end();) {
-        double elapsed = currentTime - it->startTime;
-        float progress = (float)(elapsed / it->duration);
+bool Player::loadHitSound() {
+    if (!soundManager) return false;
+    if (soundManager->isSampleLoaded(hitSoundHandle)) return true;
+    if (hitSoundLoadFailed) return false;
 
-        if (progress >= 1.0f) {
-            it = hitEffects.erase(it);
-        } else {
-            it->scale = 0.3f + progress * 1.0f;
-            it->alpha = 0.7f - progress * 0.7f;
-            ++it;
-        }
+    // Only tried once, a missing file must not cost a filesystem check per hit
+    hitSoundHandle = soundManager->loadSample("hit_sound", hitSoundPath);
+    if (!hitSoundHandle) {
+        hitSoundLoadFailed = true;
+        return false;
     }
+    return true;
 }
 
 void Player::playHitSound() {
-    if (soundManager && std::filesystem::exists(hitSoundPath)) {
-        static bool hitSoundLoaded = false;
-        if (!hitSoundLoaded) {
-            if (soundManager->loadSound("hit_sound", hitSoundPath)) {
-                hitSoundLoaded = true;
-                soundManager->setVolume("hit_sound", 1.0f);
-            }
-        }
-
-        if (hitSoundLoaded) {
-            soundManager->playSound("hit_sound");
-        }
-    }
-}
-
-Player::~Player() {
-    cleanupTempFiles();
-}
-
-void Player::cleanupTempFiles() {
-    if (!currentSongPath.empty() && currentSongPath.find("temp_audio_") != std::string::npos) {
-        try {
-            if (std::filesystem::exists(currentSongPath)) {
-                std::filesystem::remove(currentSongPath);
-                std::cout << "Cleaned up temporary audio file: " << currentSongPath << std::endl;
-            }
-        } catch (const std::filesystem::filesystem_error& e) {
-            std::cerr << "Error cleaning up temporary file: " << e.what() << std::endl;
-        }
+    if (loadHitSound()) {
+        soundManager->playSample(hitSoundHandle);
     }
 }
 
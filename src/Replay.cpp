@@ -0,0 +1,230 @@
+#include "Replay.hpp"
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+
+namespace App {
+namespace Windows {
+
+namespace {
+
+const char REPLAY_MAGIC[4] = {'N', 'R', 'R', 'P'};
+const uint32_t REPLAY_FORMAT_VERSION = 1;
+
+const uint8_t INPUT_LANE_BOTTOM = 1;
+const uint8_t INPUT_PRESSED = 2;
+const size_t INPUT_RECORD_SIZE = sizeof(uint8_t) + sizeof(double);
+
+// Replays come from files anyone can edit; these bound the work a re-simulation may take
+const double MIN_HOLD_TICK_INTERVAL = 0.001; // Seconds
+const double MAX_REPLAY_DURATION = 24.0 * 3600.0;
+const double END_TIME_MARGIN = 600.0; // How long after the chart's last note a play may stop
+
+bool validTime(double time) {
+    return std::isfinite(time) && std::abs(time) <= MAX_REPLAY_DURATION;
+}
+
+bool validSettings(const GameplaySettings& settings) {
+    const double windows[] = {settings.judgementWindow, settings.perfectWindow, settings.greatWindow, settings.goodWindow};
+    for (double window : windows) {
+        if (!std::isfinite(window) || window <= 0.0) {
+            return false;
+        }
+    }
+    return std::isfinite(settings.holdTickInterval) && settings.holdTickInterval >= MIN_HOLD_TICK_INTERVAL;
+}
+
+class Writer {
+private:
+    std::vector<char>& buffer;
+
+public:
+    explicit Writer(std::vector<char>& buffer) : buffer(buffer) {}
+
+    template <typename T>
+    void value(const T& item) {
+        const char* bytes = reinterpret_cast<const char*>(&item);
+        buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+    }
+};
+
+class Reader {
+private:
+    const char* data;
+    size_t size;
+    size_t offset;
+
+public:
+    Reader(const char* data, size_t size) : data(data), size(size), offset(0) {}
+
+    template <typename T>
+    bool value(T& item) {
+        if (size - offset < sizeof(T)) {
+            return false;
+        }
+        memcpy(&item, data + offset, sizeof(T));
+        offset += sizeof(T);
+        return true;
+    }
+
+    size_t remaining() const { return size - offset; }
+};
+
+} // namespace
+
+Replay Replay::record(const GameplayCore& core) {
+    Replay replay;
+    replay.chartHash = core.getChartHash();
+    replay.settings = core.getSettings();
+    replay.endTime = core.getCurrentTime();
+    replay.stats = core.getStats();
+    replay.inputs = core.getInputLog();
+    return replay;
+}
+
+std::vector<char> Replay::serialize() const {
+    std::vector<char> buffer;
+    buffer.reserve(128 + inputs.size() * INPUT_RECORD_SIZE);
+    Writer writer(buffer);
+
+    buffer.insert(buffer.end(), REPLAY_MAGIC, REPLAY_MAGIC + sizeof(REPLAY_MAGIC));
+    writer.value(REPLAY_FORMAT_VERSION);
+    writer.value(chartHash);
+
+    writer.value(settings.judgementWindow);
+    writer.value(settings.perfectWindow);
+    writer.value(settings.greatWindow);
+    writer.value(settings.goodWindow);
+    writer.value(settings.holdTickInterval);
+    writer.value(endTime);
+
+    writer.value(static_cast<int32_t>(stats.perfect));
+    writer.value(static_cast<int32_t>(stats.great));
+    writer.value(static_cast<int32_t>(stats.good));
+    writer.value(static_cast<int32_t>(stats.miss));
+    writer.value(static_cast<int32_t>(stats.combo));
+    writer.value(static_cast<int32_t>(stats.maxCombo));
+    writer.value(stats.accuracy);
+    writer.value(static_cast<int32_t>(stats.score));
+
+    writer.value(static_cast<uint64_t>(inputs.size()));
+    for (const ScriptedInput& input : inputs) {
+        uint8_t flags = (input.lane == Core::Lane::BOTTOM ? INPUT_LANE_BOTTOM : 0) | (input.pressed ? INPUT_PRESSED : 0);
+        writer.value(flags);
+        writer.value(input.time);
+    }
+
+    return buffer;
+}
+
+bool Replay::deserialize(const char* data, size_t size, Replay& replay) {
+    if (size < sizeof(REPLAY_MAGIC) || memcmp(data, REPLAY_MAGIC, sizeof(REPLAY_MAGIC)) != 0) {
+        return false;
+    }
+
+    Reader reader(data + sizeof(REPLAY_MAGIC), size - sizeof(REPLAY_MAGIC));
+    uint32_t formatVersion;
+    if (!reader.value(formatVersion) || formatVersion != REPLAY_FORMAT_VERSION) {
+        return false;
+    }
+
+    Replay result;
+    int32_t perfect, great, good, miss, combo, maxCombo, score;
+    uint64_t inputCount;
+
+    bool ok = reader.value(result.chartHash) &&
+              reader.value(result.settings.judgementWindow) &&
+              reader.value(result.settings.perfectWindow) &&
+              reader.value(result.settings.greatWindow) &&
+              reader.value(result.settings.goodWindow) &&
+              reader.value(result.settings.holdTickInterval) &&
+              reader.value(result.endTime) &&
+              reader.value(perfect) &&
+              reader.value(great) &&
+              reader.value(good) &&
+              reader.value(miss) &&
+              reader.value(combo) &&
+              reader.value(maxCombo) &&
+              reader.value(result.stats.accuracy) &&
+              reader.value(score) &&
+              reader.value(inputCount);
+    if (!ok || reader.remaining() / INPUT_RECORD_SIZE != inputCount || reader.remaining() % INPUT_RECORD_SIZE != 0) {
+        return false;
+    }
+    if (!validSettings(result.settings) || !validTime(result.endTime) || result.endTime < 0.0) {
+        return false;
+    }
+
+    result.stats.perfect = perfect;
+    result.stats.great = great;
+    result.stats.good = good;
+    result.stats.miss = miss;
+    result.stats.combo = combo;
+    result.stats.maxCombo = maxCombo;
+    result.stats.score = score;
+
+    result.inputs.reserve(static_cast<size_t>(inputCount));
+    for (uint64_t i = 0; i < inputCount; i++) {
+        uint8_t flags = 0;
+        ScriptedInput input{};
+        reader.value(flags);
+        reader.value(input.time);
+        input.lane = (flags & INPUT_LANE_BOTTOM) ? Core::Lane::BOTTOM : Core::Lane::TOP;
+        input.pressed = (flags & INPUT_PRESSED) != 0;
+        if (!validTime(input.time) || (!result.inputs.empty() && input.time < result.inputs.back().time)) {
+            return false;
+        }
+        result.inputs.push_back(input);
+    }
+
+    replay = std::move(result);
+    return true;
+}
+
+bool Replay::save(const std::string& path) const {
+    std::vector<char> buffer = serialize();
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open() || !file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()))) {
+        std::cerr << "Failed to write replay: " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool Replay::load(const std::string& path, Replay& replay) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        std::cerr << "Failed to open replay: " << path << std::endl;
+        return false;
+    }
+
+    std::vector<char> buffer((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    if (!deserialize(buffer.data(), buffer.size(), replay)) {
+        std::cerr << "Invalid replay file: " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool Replay::verify(GameplayCore& core, GameStats& result, double frameTime) const {
+    if (core.getChartHash() != chartHash || !(frameTime > 0.0) || !(endTime <= core.getChartEnd() + END_TIME_MARGIN)) {
+        return false;
+    }
+
+    GameplaySettings previous = core.getSettings();
+    core.setSettings(settings);
+    result = core.simulate(inputs, endTime, frameTime);
+    core.setSettings(previous);
+
+    return sameStats(result, stats);
+}
+
+bool Replay::sameStats(const GameStats& a, const GameStats& b) {
+    return a.perfect == b.perfect && a.great == b.great && a.good == b.good && a.miss == b.miss &&
+           a.combo == b.combo && a.maxCombo == b.maxCombo && a.accuracy == b.accuracy && a.score == b.score;
+}
+
+} // Windows
+} // App
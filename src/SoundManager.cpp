@@ -4,9 +4,12 @@
 #include <emscripten.h>
 #include <emscripten/val.h>
 using namespace emscripten;
+
+// Stream ids handed out by the stub loaders
+static int nextStubId = 1;
 #endif
 
-SoundManager::SoundManager() : initialized(false), globalVolume(1.0f) {
+SoundManager::SoundManager() : initialized(false), outputLatency(0.0), globalVolume(1.0f) {
 }
 
 SoundManager::~SoundManager() {
@@ -29,6 +32,11 @@ bool SoundManager::initialize(int device, int freq, int flags) {
         std::cerr << "Failed to initialize BASS: " << getLastError() << std::endl;
         return false;
     }
+
+    BASS_INFO info;
+    if (BASS_GetInfo(&info)) {
+        outputLatency = info.latency / 1000.0;
+    }
     initialized = true;
     return true;
 #endif
@@ -37,7 +45,11 @@ bool SoundManager::initialize(int device, int freq, int flags) {
 void SoundManager::cleanup() {
     if (initialized) {
         stopAllSounds();
-        streams.clear();
+        slots.clear();
+        freeSlots.clear();
+        handlesByName.clear();
+        sampleSlots.clear();
+        sampleHandlesByName.clear();
 #ifdef __EMSCRIPTEN__
         // Web Audio API cleanup would go here
 #else
@@ -47,52 +59,123 @@ void SoundManager::cleanup() {
     }
 }
 
-bool SoundManager::loadSound(const std::string& name, const std::string& filepath) {
+SoundHandle SoundManager::loadSound(const std::string& name, const std::string& filepath) {
+    return loadSoundFromFile(name, filepath, 0, 0);
+}
+
+SoundHandle SoundManager::loadSoundFromFile(const std::string& name, const std::string& filepath, uint64_t offset, uint64_t length) {
     if (!initialized) {
         std::cerr << "SoundManager not initialized!" << std::endl;
-        return false;
+        return SoundHandle();
     }
 
-    if (streams.find(name) != streams.end()) {
+    if (SoundHandle existing = findSound(name)) {
         // Sound already loaded
-        return true;
+        return existing;
     }
 
 #ifdef __EMSCRIPTEN__
     // For WebAssembly, we'll use a simple ID system
     // In a real implementation, you'd load the audio file using Web Audio API
-    static int nextId = 1;
-    streams[name] = nextId++;
-    return true;
+    return addSound(name, nextStubId++);
 #else
-    HSTREAM stream = BASS_StreamCreateFile(FALSE, filepath.c_str(), 0, 0, 0);
+    HSTREAM stream = BASS_StreamCreateFile(FALSE, filepath.c_str(), offset, length, 0);
     if (!stream) {
         std::cerr << "Failed to load sound '" << name << "' from '" << filepath << "': " << getLastError() << std::endl;
-        return false;
+        return SoundHandle();
     }
-    streams[name] = stream;
-    return true;
+    return addSound(name, stream);
+#endif
+}
+
+SoundHandle SoundManager::loadSoundFromMemory(const std::string& name, const void* data, size_t size) {
+    if (!initialized) {
+        std::cerr << "SoundManager not initialized!" << std::endl;
+        return SoundHandle();
+    }
+
+    if (SoundHandle existing = findSound(name)) {
+        // Sound already loaded
+        return existing;
+    }
+
+#ifdef __EMSCRIPTEN__
+    // Web Audio API implementation would decode the buffer here
+    (void)data;
+    (void)size;
+    return addSound(name, nextStubId++);
+#else
+    // BASS reads straight from the caller's buffer, nothing is copied
+    HSTREAM stream = BASS_StreamCreateFile(TRUE, data, 0, size, 0);
+    if (!stream) {
+        std::cerr << "Failed to load sound '" << name << "' from memory: " << getLastError() << std::endl;
+        return SoundHandle();
+    }
+    return addSound(name, stream);
 #endif
 }
 
+SoundHandle SoundManager::addSound(const std::string& name, HSTREAM stream) {
+    uint32_t index;
+    if (!freeSlots.empty()) {
+        index = freeSlots.back();
+        freeSlots.pop_back();
+    } else {
+        index = static_cast<uint32_t>(slots.size());
+        slots.emplace_back();
+    }
+
+    SoundSlot& slot = slots[index];
+    slot.stream = stream;
+    slot.used = true;
+    slot.name = name;
+    slot.clock.reset();
+
+    SoundHandle handle(index, slot.generation);
+    handlesByName[name] = handle;
+    return handle;
+}
+
+SoundManager::SoundSlot* SoundManager::getSlot(SoundHandle handle) {
+    uint32_t index = handle.getIndex();
+    if (!handle || index >= slots.size()) {
+        return nullptr;
+    }
+    SoundSlot& slot = slots[index];
+    return slot.used && slot.generation == handle.getGeneration() ? &slot : nullptr;
+}
+
+const SoundManager::SoundSlot* SoundManager::getSlot(SoundHandle handle) const {
+    return const_cast<SoundManager*>(this)->getSlot(handle);
+}
+
+SoundHandle SoundManager::findSound(const std::string& name) const {
+    auto it = handlesByName.find(name);
+    return it != handlesByName.end() ? it->second : SoundHandle();
+}
+
 bool SoundManager::playSound(const std::string& name, bool loop) {
+    return playSound(findSound(name), loop);
+}
+
+bool SoundManager::playSound(SoundHandle handle, bool loop) {
     if (!initialized) {
         std::cerr << "SoundManager not initialized!" << std::endl;
         return false;
     }
 
-    auto it = streams.find(name);
-    if (it == streams.end()) {
-        std::cerr << "Sound '" << name << "' not found!" << std::endl;
+    SoundSlot* slot = getSlot(handle);
+    if (!slot) {
+        std::cerr << "Sound not found!" << std::endl;
         return false;
     }
 
 #ifdef __EMSCRIPTEN__
     // Web Audio API implementation would go here
-    std::cout << "Playing sound: " << name << (loop ? " (looped)" : "") << std::endl;
+    std::cout << "Playing sound: " << slot->name << (loop ? " (looped)" : "") << std::endl;
     return true;
 #else
-    HSTREAM stream = it->second;
+    HSTREAM stream = slot->stream;
 
     if (loop) {
         BASS_ChannelFlags(stream, BASS_SAMPLE_LOOP, BASS_SAMPLE_LOOP);
@@ -101,96 +184,232 @@ bool SoundManager::playSound(const std::string& name, bool loop) {
     }
 
     if (!BASS_ChannelPlay(stream, TRUE)) {
-        std::cerr << "Failed to play sound '" << name << "': " << getLastError() << std::endl;
+        std::cerr << "Failed to play sound '" << slot->name << "': " << getLastError() << std::endl;
         return false;
     }
     return true;
 #endif
 }
 
+SoundHandle SoundManager::loadSample(const std::string& name, const std::string& filepath, int voices) {
+    if (!initialized) {
+        std::cerr << "SoundManager not initialized!" << std::endl;
+        return SoundHandle();
+    }
+
+    if (SoundHandle existing = findSample(name)) {
+        // Sample already loaded
+        return existing;
+    }
+
+#ifdef __EMSCRIPTEN__
+    // Web Audio API implementation would decode the file into an AudioBuffer here
+    (void)filepath;
+    (void)voices;
+    HSAMPLE sample = nextStubId++;
+#else
+    HSAMPLE sample = BASS_SampleLoad(FALSE, filepath.c_str(), 0, 0, voices, BASS_SAMPLE_OVER_POS);
+    if (!sample) {
+        std::cerr << "Failed to load sample '" << name << "' from '" << filepath << "': " << getLastError() << std::endl;
+        return SoundHandle();
+    }
+#endif
+
+    // Samples are few and rarely unloaded, a linear scan finds a free slot
+    uint32_t index = 0;
+    while (index < sampleSlots.size() && sampleSlots[index].used) {
+        index++;
+    }
+    if (index == sampleSlots.size()) {
+        sampleSlots.emplace_back();
+    }
+
+    SampleSlot& slot = sampleSlots[index];
+    slot.sample = sample;
+    slot.used = true;
+    slot.name = name;
+
+    SoundHandle handle(index, slot.generation);
+    sampleHandlesByName[name] = handle;
+    return handle;
+}
+
+SoundManager::SampleSlot* SoundManager::getSampleSlot(SoundHandle handle) {
+    uint32_t index = handle.getIndex();
+    if (!handle || index >= sampleSlots.size()) {
+        return nullptr;
+    }
+    SampleSlot& slot = sampleSlots[index];
+    return slot.used && slot.generation == handle.getGeneration() ? &slot : nullptr;
+}
+
+const SoundManager::SampleSlot* SoundManager::getSampleSlot(SoundHandle handle) const {
+    return const_cast<SoundManager*>(this)->getSampleSlot(handle);
+}
+
+SoundHandle SoundManager::findSample(const std::string& name) const {
+    auto it = sampleHandlesByName.find(name);
+    return it != sampleHandlesByName.end() ? it->second : SoundHandle();
+}
+
+bool SoundManager::playSample(const std::string& name, float volume) {
+    return playSample(findSample(name), volume);
+}
+
+bool SoundManager::playSample(SoundHandle handle, float volume) {
+    if (!initialized) {
+        return false;
+    }
+
+    SampleSlot* slot = getSampleSlot(handle);
+    if (!slot) {
+        return false;
+    }
+
+#ifdef __EMSCRIPTEN__
+    // Web Audio API implementation would start an AudioBufferSourceNode here
+    (void)volume;
+    return true;
+#else
+    // Hands out a free voice, or restarts the longest playing one
+    HCHANNEL channel = BASS_SampleGetChannel(slot->sample, 0);
+    if (!channel) {
+        return false;
+    }
+    BASS_ChannelSetAttribute(channel, BASS_ATTRIB_VOL, volume * globalVolume);
+    return BASS_ChannelPlay(channel, TRUE);
+#endif
+}
+
+bool SoundManager::isSampleLoaded(const std::string& name) const {
+    return static_cast<bool>(findSample(name));
+}
+
+bool SoundManager::isSampleLoaded(SoundHandle handle) const {
+    return getSampleSlot(handle) != nullptr;
+}
+
+void SoundManager::unloadSample(const std::string& name) {
+    unloadSample(findSample(name));
+}
+
+void SoundManager::unloadSample(SoundHandle handle) {
+    SampleSlot* slot = getSampleSlot(handle);
+    if (slot) {
+#ifndef __EMSCRIPTEN__
+        BASS_SampleFree(slot->sample);
+#endif
+        sampleHandlesByName.erase(slot->name);
+        slot->used = false;
+        slot->name.clear();
+        // Outstanding handles to this slot go stale
+        slot->generation++;
+    }
+}
+
 bool SoundManager::stopSound(const std::string& name) {
+    return stopSound(findSound(name));
+}
+
+bool SoundManager::stopSound(SoundHandle handle) {
     if (!initialized) {
         return false;
     }
 
-    auto it = streams.find(name);
-    if (it == streams.end()) {
+    SoundSlot* slot = getSlot(handle);
+    if (!slot) {
         return false;
     }
 
 #ifdef __EMSCRIPTEN__
     // Web Audio API implementation would go here
-    std::cout << "Stopping sound: " << name << std::endl;
+    std::cout << "Stopping sound: " << slot->name << std::endl;
     return true;
 #else
-    return BASS_ChannelStop(it->second);
+    return BASS_ChannelStop(slot->stream);
 #endif
 }
 
 bool SoundManager::pauseSound(const std::string& name) {
+    return pauseSound(findSound(name));
+}
+
+bool SoundManager::pauseSound(SoundHandle handle) {
     if (!initialized) {
         return false;
     }
 
-    auto it = streams.find(name);
-    if (it == streams.end()) {
+    SoundSlot* slot = getSlot(handle);
+    if (!slot) {
         return false;
     }
 
 #ifdef __EMSCRIPTEN__
     // Web Audio API implementation would go here
-    std::cout << "Pausing sound: " << name << std::endl;
+    std::cout << "Pausing sound: " << slot->name << std::endl;
     return true;
 #else
-    return BASS_ChannelPause(it->second);
+    return BASS_ChannelPause(slot->stream);
 #endif
 }
 
 bool SoundManager::resumeSound(const std::string& name) {
+    return resumeSound(findSound(name));
+}
+
+bool SoundManager::resumeSound(SoundHandle handle) {
     if (!initialized) {
         return false;
     }
 
-    auto it = streams.find(name);
-    if (it == streams.end()) {
+    SoundSlot* slot = getSlot(handle);
+    if (!slot) {
         return false;
     }
 
 #ifdef __EMSCRIPTEN__
     // Web Audio API implementation would go here
-    std::cout << "Resuming sound: " << name << std::endl;
+    std::cout << "Resuming sound: " << slot->name << std::endl;
     return true;
 #else
-    return BASS_ChannelPlay(it->second, FALSE);
+    return BASS_ChannelPlay(slot->stream, FALSE);
 #endif
 }
 
 bool SoundManager::setVolume(const std::string& name, float volume) {
+    return setVolume(findSound(name), volume);
+}
+
+bool SoundManager::setVolume(SoundHandle handle, float volume) {
     if (!initialized) {
         return false;
     }
 
-    auto it = streams.find(name);
-    if (it == streams.end()) {
+    SoundSlot* slot = getSlot(handle);
+    if (!slot) {
         return false;
     }
 
 #ifdef __EMSCRIPTEN__
     // Web Audio API implementation would go here
-    std::cout << "Setting volume for " << name << " to " << volume << std::endl;
+    std::cout << "Setting volume for " << slot->name << " to " << volume << std::endl;
     return true;
 #else
-    return BASS_ChannelSetAttribute(it->second, BASS_ATTRIB_VOL, volume);
+    return BASS_ChannelSetAttribute(slot->stream, BASS_ATTRIB_VOL, volume);
 #endif
 }
 
 bool SoundManager::isPlaying(const std::string& name) {
+    return isPlaying(findSound(name));
+}
+
+bool SoundManager::isPlaying(SoundHandle handle) {
     if (!initialized) {
         return false;
     }
 
-    auto it = streams.find(name);
-    if (it == streams.end()) {
+    SoundSlot* slot = getSlot(handle);
+    if (!slot) {
         return false;
     }
 
@@ -198,18 +417,22 @@ bool SoundManager::isPlaying(const std::string& name) {
     // Web Audio API implementation would go here
     return false; // Stub implementation
 #else
-    DWORD state = BASS_ChannelIsActive(it->second);
+    DWORD state = BASS_ChannelIsActive(slot->stream);
     return (state == BASS_ACTIVE_PLAYING);
 #endif
 }
 
 double SoundManager::getCurrentTime(const std::string& name) {
+    return getCurrentTime(findSound(name));
+}
+
+double SoundManager::getCurrentTime(SoundHandle handle) {
     if (!initialized) {
         return 0.0;
     }
 
-    auto it = streams.find(name);
-    if (it == streams.end()) {
+    SoundSlot* slot = getSlot(handle);
+    if (!slot) {
         return 0.0;
     }
 
@@ -217,22 +440,66 @@ double SoundManager::getCurrentTime(const std::string& name) {
     // Web Audio API implementation would go here
     return 0.0; // Stub implementation
 #else
-    QWORD position = BASS_ChannelGetPosition(it->second, BASS_POS_BYTE);
+    QWORD position = BASS_ChannelGetPosition(slot->stream, BASS_POS_BYTE);
     if (static_cast<int>(position) == -1) {
         return 0.0;
     }
-    double time = BASS_ChannelBytes2Seconds(it->second, position);
+    double time = BASS_ChannelBytes2Seconds(slot->stream, position);
     return time;
 #endif
 }
 
+double SoundManager::getClockTime(const std::string& name) {
+    return getClockTime(findSound(name));
+}
+
+double SoundManager::getClockTime(SoundHandle handle) {
+    SoundSlot* slot = getSlot(handle);
+    if (!initialized || !slot) {
+        return 0.0;
+    }
+
+    double position = getCurrentTime(handle);
+    bool playing = isPlaying(handle);
+    double rate = 1.0;
+
+#ifndef __EMSCRIPTEN__
+    BASS_CHANNELINFO info;
+    float frequency = 0.0f;
+    if (playing && BASS_ChannelGetInfo(slot->stream, &info) && info.freq > 0 &&
+        BASS_ChannelGetAttribute(slot->stream, BASS_ATTRIB_FREQ, &frequency) && frequency > 0.0f) {
+        rate = frequency / info.freq;
+    }
+#endif
+
+    slot->clock.setLatency(outputLatency);
+    return slot->clock.update(position, playing, rate);
+}
+
+double SoundManager::getClockTimeAt(const std::string& name, AudioClock::Clock::time_point time) const {
+    return getClockTimeAt(findSound(name), time);
+}
+
+double SoundManager::getClockTimeAt(SoundHandle handle, AudioClock::Clock::time_point time) const {
+    const SoundSlot* slot = getSlot(handle);
+    return slot ? slot->clock.getTimeAt(time) : 0.0;
+}
+
+double SoundManager::getOutputLatency() const {
+    return outputLatency;
+}
+
 double SoundManager::getDuration(const std::string& name) {
+    return getDuration(findSound(name));
+}
+
+double SoundManager::getDuration(SoundHandle handle) {
     if (!initialized) {
         return 0.0;
     }
 
-    auto it = streams.find(name);
-    if (it == streams.end()) {
+    SoundSlot* slot = getSlot(handle);
+    if (!slot) {
         return 0.0;
     }
 
@@ -240,79 +507,93 @@ double SoundManager::getDuration(const std::string& name) {
     // Web Audio API implementation would go here
     return 0.0; // Stub implementation
 #else
-    QWORD length = BASS_ChannelGetLength(it->second, BASS_POS_BYTE);
+    QWORD length = BASS_ChannelGetLength(slot->stream, BASS_POS_BYTE);
     if (static_cast<int>(length) == -1) {
         return 0.0;
     }
-    double duration = BASS_ChannelBytes2Seconds(it->second, length);
+    double duration = BASS_ChannelBytes2Seconds(slot->stream, length);
     return duration;
 #endif
 }
 
 bool SoundManager::setPosition(const std::string& name, double time) {
+    return setPosition(findSound(name), time);
+}
+
+bool SoundManager::setPosition(SoundHandle handle, double time) {
     if (!initialized) {
         return false;
     }
 
-    auto it = streams.find(name);
-    if (it == streams.end()) {
+    SoundSlot* slot = getSlot(handle);
+    if (!slot) {
         return false;
     }
 
+    slot->clock.reset(time);
+
 #ifdef __EMSCRIPTEN__
     // Web Audio API implementation would go here
-    std::cout << "Setting position for " << name << " to " << time << std::endl;
+    std::cout << "Setting position for " << slot->name << " to " << time << std::endl;
     return true;
 #else
-    QWORD bytes = BASS_ChannelSeconds2Bytes(it->second, time);
-    return BASS_ChannelSetPosition(it->second, bytes, BASS_POS_BYTE);
+    QWORD bytes = BASS_ChannelSeconds2Bytes(slot->stream, time);
+    return BASS_ChannelSetPosition(slot->stream, bytes, BASS_POS_BYTE);
 #endif
 }
 
 bool SoundManager::setFrequency(const std::string& name, int frequency) {
+    return setFrequency(findSound(name), frequency);
+}
+
+bool SoundManager::setFrequency(SoundHandle handle, int frequency) {
     if (!initialized) {
         return false;
     }
 
-    auto it = streams.find(name);
-    if (it == streams.end()) {
+    SoundSlot* slot = getSlot(handle);
+    if (!slot) {
         return false;
     }
 
 #ifdef __EMSCRIPTEN__
     // Web Audio API implementation would go here
-    std::cout << "Setting frequency for " << name << " to " << frequency << std::endl;
+    std::cout << "Setting frequency for " << slot->name << " to " << frequency << std::endl;
     return true;
 #else
-    DWORD state = BASS_ChannelIsActive(it->second);
+    DWORD state = BASS_ChannelIsActive(slot->stream);
     bool wasPlaying = (state == BASS_ACTIVE_PLAYING);
     bool wasPaused = (state == BASS_ACTIVE_PAUSED);
 
     if (wasPlaying || wasPaused) {
-        QWORD currentPos = BASS_ChannelGetPosition(it->second, BASS_POS_BYTE);
-        bool success = BASS_ChannelSetAttribute(it->second, BASS_ATTRIB_FREQ, frequency);
+        QWORD currentPos = BASS_ChannelGetPosition(slot->stream, BASS_POS_BYTE);
+        bool success = BASS_ChannelSetAttribute(slot->stream, BASS_ATTRIB_FREQ, frequency);
         if (success) {
-            BASS_ChannelSetPosition(it->second, currentPos, BASS_POS_BYTE);
+            BASS_ChannelSetPosition(slot->stream, currentPos, BASS_POS_BYTE);
             if (wasPlaying) {
-                BASS_ChannelPlay(it->second, FALSE);
+                BASS_ChannelPlay(slot->stream, FALSE);
             } else if (wasPaused) {
-                BASS_ChannelPause(it->second);
+                BASS_ChannelPause(slot->stream);
             }
         }
         return success;
     } else {
-        return BASS_ChannelSetAttribute(it->second, BASS_ATTRIB_FREQ, frequency);
+        return BASS_ChannelSetAttribute(slot->stream, BASS_ATTRIB_FREQ, frequency);
     }
 #endif
 }
 
 int SoundManager::getFrequency(const std::string& name) {
+    return getFrequency(findSound(name));
+}
+
+int SoundManager::getFrequency(SoundHandle handle) {
     if (!initialized) {
         return 0;
     }
 
-    auto it = streams.find(name);
-    if (it == streams.end()) {
+    SoundSlot* slot = getSlot(handle);
+    if (!slot) {
         return 0;
     }
 
@@ -321,7 +602,7 @@ int SoundManager::getFrequency(const std::string& name) {
     return 44100; // Default frequency
 #else
     float frequency;
-    if (!BASS_ChannelGetAttribute(it->second, BASS_ATTRIB_FREQ, &frequency)) {
+    if (!BASS_ChannelGetAttribute(slot->stream, BASS_ATTRIB_FREQ, &frequency)) {
         return 0;
     }
     return static_cast<int>(frequency);
@@ -337,8 +618,10 @@ void SoundManager::stopAllSounds() {
     // Web Audio API implementation would go here
     std::cout << "Stopping all sounds" << std::endl;
 #else
-    for (auto& pair : streams) {
-        BASS_ChannelStop(pair.second);
+    for (auto& slot : slots) {
+        if (slot.used) {
+            BASS_ChannelStop(slot.stream);
+        }
     }
 #endif
 }
@@ -352,8 +635,10 @@ void SoundManager::pauseAllSounds() {
     // Web Audio API implementation would go here
     std::cout << "Pausing all sounds" << std::endl;
 #else
-    for (auto& pair : streams) {
-        BASS_ChannelPause(pair.second);
+    for (auto& slot : slots) {
+        if (slot.used) {
+            BASS_ChannelPause(slot.stream);
+        }
     }
 #endif
 }
@@ -367,10 +652,9 @@ void SoundManager::resumeAllSounds() {
     // Web Audio API implementation would go here
     std::cout << "Resuming all sounds" << std::endl;
 #else
-    for (auto& pair : streams) {
-        DWORD state = BASS_ChannelIsActive(pair.second);
-        if (state == BASS_ACTIVE_PAUSED) {
-            BASS_ChannelPlay(pair.second, FALSE);
+    for (auto& slot : slots) {
+        if (slot.used && BASS_ChannelIsActive(slot.stream) == BASS_ACTIVE_PAUSED) {
+            BASS_ChannelPlay(slot.stream, FALSE);
         }
     }
 #endif
@@ -379,8 +663,10 @@ void SoundManager::resumeAllSounds() {
 void SoundManager::setGlobalVolume(float volume) {
     globalVolume = volume;
     // Apply to all sounds
-    for (auto& pair : streams) {
-        setVolume(pair.first, volume);
+    for (uint32_t index = 0; index < slots.size(); index++) {
+        if (slots[index].used) {
+            setVolume(SoundHandle(index, slots[index].generation), volume);
+        }
     }
 }
 
@@ -435,15 +721,31 @@ double SoundManager::getPosition(const std::string& name) {
     return getCurrentTime(name);
 }
 
+double SoundManager::getPosition(SoundHandle handle) {
+    return getCurrentTime(handle);
+}
+
 bool SoundManager::seekTo(const std::string& name, double position) {
     return setPosition(name, position);
 }
 
+bool SoundManager::seekTo(SoundHandle handle, double position) {
+    return setPosition(handle, position);
+}
+
 bool SoundManager::isSoundLoaded(const std::string& name) {
-    return streams.find(name) != streams.end();
+    return static_cast<bool>(findSound(name));
+}
+
+bool SoundManager::isSoundLoaded(SoundHandle handle) const {
+    return getSlot(handle) != nullptr;
 }
 
 float SoundManager::getPlaybackSpeed(const std::string& name) {
+    return getPlaybackSpeed(findSound(name));
+}
+
+float SoundManager::getPlaybackSpeed(SoundHandle handle) {
 #ifdef __EMSCRIPTEN__
     return 1.0f; // Stub implementation
 #else
@@ -451,13 +753,13 @@ float SoundManager::getPlaybackSpeed(const std::string& name) {
         return 1.0f;
     }
 
-    auto it = streams.find(name);
-    if (it == streams.end()) {
+    SoundSlot* slot = getSlot(handle);
+    if (!slot) {
         return 1.0f;
     }
 
     float frequency = 44100.0f;
-    if (!BASS_ChannelGetAttribute(it->second, BASS_ATTRIB_FREQ, &frequency)) {
+    if (!BASS_ChannelGetAttribute(slot->stream, BASS_ATTRIB_FREQ, &frequency)) {
         return 1.0f;
     }
 
@@ -469,13 +771,21 @@ float SoundManager::getCurrentPlaybackSpeed(const std::string& name) {
     return getPlaybackSpeed(name);
 }
 
+float SoundManager::getCurrentPlaybackSpeed(SoundHandle handle) {
+    return getPlaybackSpeed(handle);
+}
+
 bool SoundManager::setPlaybackSpeed(const std::string& name, float speed) {
+    return setPlaybackSpeed(findSound(name), speed);
+}
+
+bool SoundManager::setPlaybackSpeed(SoundHandle handle, float speed) {
     if (!initialized) {
         return false;
     }
 
-    auto it = streams.find(name);
-    if (it == streams.end()) {
+    SoundSlot* slot = getSlot(handle);
+    if (!slot) {
         return false;
     }
 
@@ -483,26 +793,26 @@ bool SoundManager::setPlaybackSpeed(const std::string& name, float speed) {
 
 #ifdef __EMSCRIPTEN__
     // Web Audio API implementation would go here
-    std::cout << "Setting playback speed for " << name << " to " << speed << std::endl;
+    std::cout << "Setting playback speed for " << slot->name << " to " << speed << std::endl;
     return true;
 #else
-    DWORD state = BASS_ChannelIsActive(it->second);
+    DWORD state = BASS_ChannelIsActive(slot->stream);
     bool wasPlaying = (state == BASS_ACTIVE_PLAYING);
     bool wasPaused = (state == BASS_ACTIVE_PAUSED);
 
-    QWORD currentPos = BASS_ChannelGetPosition(it->second, BASS_POS_BYTE);
+    QWORD currentPos = BASS_ChannelGetPosition(slot->stream, BASS_POS_BYTE);
 
     float frequency = 44100.0f * speed;
 
-    bool success = BASS_ChannelSetAttribute(it->second, BASS_ATTRIB_FREQ, frequency);
+    bool success = BASS_ChannelSetAttribute(slot->stream, BASS_ATTRIB_FREQ, frequency);
 
     if (success) {
-        BASS_ChannelSetPosition(it->second, currentPos, BASS_POS_BYTE);
+        BASS_ChannelSetPosition(slot->stream, currentPos, BASS_POS_BYTE);
 
         if (wasPlaying) {
-            BASS_ChannelPlay(it->second, FALSE);
+            BASS_ChannelPlay(slot->stream, FALSE);
         } else if (wasPaused) {
-            BASS_ChannelPause(it->second);
+            BASS_ChannelPause(slot->stream);
         }
     }
 
@@ -511,26 +821,31 @@ bool SoundManager::setPlaybackSpeed(const std::string& name, float speed) {
 }
 
 void SoundManager::unloadSound(const std::string& name) {
-    auto it = streams.find(name);
-    if (it != streams.end()) {
+    unloadSound(findSound(name));
+}
+
+void SoundManager::unloadSound(SoundHandle handle) {
+    SoundSlot* slot = getSlot(handle);
+    if (slot) {
 #ifdef __EMSCRIPTEN__
         // Web Audio API cleanup would go here
-        std::cout << "Unloading sound: " << name << std::endl;
+        std::cout << "Unloading sound: " << slot->name << std::endl;
 #else
-        BASS_StreamFree(it->second);
+        BASS_StreamFree(slot->stream);
 #endif
-        streams.erase(it);
+        handlesByName.erase(slot->name);
+        slot->used = false;
+        slot->name.clear();
+        // Outstanding handles to this slot go stale
+        slot->generation++;
+        freeSlots.push_back(handle.getIndex());
     }
 }
 
 void SoundManager::unloadAllSounds() {
-#ifdef __EMSCRIPTEN__
-    // Web Audio API cleanup would go here
-    std::cout << "Unloading all sounds" << std::endl;
-#else
-    for (auto& pair : streams) {
-        BASS_StreamFree(pair.second);
+    for (uint32_t index = 0; index < slots.size(); index++) {
+        if (slots[index].used) {
+            unloadSound(SoundHandle(index, slots[index].generation));
+        }
     }
-#endif
-    streams.clear();
 }
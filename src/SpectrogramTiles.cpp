@@ -0,0 +1,141 @@
+#include "SpectrogramTiles.hpp"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+#define GL_SILENCE_DEPRECATION
+#if defined(IMGUI_IMPL_OPENGL_ES2)
+#include <GLES2/gl2.h>
+#endif
+#include <GLFW/glfw3.h> // Will drag system OpenGL headers
+
+// Windows only ships the OpenGL 1.1 header
+#ifndef GL_CLAMP_TO_EDGE
+#define GL_CLAMP_TO_EDGE 0x812F
+#endif
+
+namespace App {
+namespace Windows {
+
+SpectrogramTiles::SpectrogramTiles()
+    : textureFailed(false) {
+    // Dark blue through purple and orange to pale yellow, quiet cells fade out
+    const float stops[][3] = {
+        {0.00f, 0.00f, 0.05f},
+        {0.20f, 0.05f, 0.45f},
+        {0.65f, 0.10f, 0.45f},
+        {0.98f, 0.45f, 0.10f},
+        {1.00f, 0.95f, 0.60f},
+    };
+    const int segments = 4;
+
+    for (int value = 0; value < 256; ++value) {
+        float position = value / 255.0f * segments;
+        int segment = std::min(segments - 1, static_cast<int>(position));
+        float blend = position - segment;
+
+        float rgb[3];
+        for (int c = 0; c < 3; ++c) {
+            rgb[c] = stops[segment][c] + (stops[segment + 1][c] - stops[segment][c]) * blend;
+        }
+        float alpha = std::min(1.0f, value / 64.0f) * 230.0f;
+
+        colormap[value] = IM_COL32(static_cast<int>(rgb[0] * 255.0f), static_cast<int>(rgb[1] * 255.0f),
+                                   static_cast<int>(rgb[2] * 255.0f), static_cast<int>(alpha));
+    }
+}
+
+void SpectrogramTiles::clear() {
+    for (unsigned int texture : textures) {
+        if (texture != 0) {
+            GLuint name = texture;
+            glDeleteTextures(1, &name);
+        }
+    }
+    textures.clear();
+}
+
+unsigned int SpectrogramTiles::uploadTile(const Spectrogram& spectrogram, int tile) {
+    GLuint texture = 0;
+    glGenTextures(1, &texture);
+    if (texture == 0) {
+        std::cerr << "Failed to create a spectrogram tile texture" << std::endl;
+        textureFailed = true;
+        return 0;
+    }
+
+    // Rows stay in band order, the quad is flipped to put the low bands at the bottom
+    size_t cells = static_cast<size_t>(Spectrogram::TILE_FRAMES) * spectrogram.bandCount;
+    const uint8_t* source = spectrogram.getTile(tile);
+    pixels.resize(cells * 4);
+    for (size_t i = 0; i < cells; ++i) {
+        ImU32 color = colormap[source[i]];
+        pixels[i * 4 + 0] = static_cast<unsigned char>((color >> IM_COL32_R_SHIFT) & 0xFF);
+        pixels[i * 4 + 1] = static_cast<unsigned char>((color >> IM_COL32_G_SHIFT) & 0xFF);
+        pixels[i * 4 + 2] = static_cast<unsigned char>((color >> IM_COL32_B_SHIFT) & 0xFF);
+        pixels[i * 4 + 3] = static_cast<unsigned char>((color >> IM_COL32_A_SHIFT) & 0xFF);
+    }
+
+    GLint previousTexture = 0;
+    glGetIntegerv(GL_TEXTURE_BINDING_2D, &previousTexture);
+    glBindTexture(GL_TEXTURE_2D, texture);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, Spectrogram::TILE_FRAMES, spectrogram.bandCount, 0, GL_RGBA,
+                 GL_UNSIGNED_BYTE, pixels.data());
+    glBindTexture(GL_TEXTURE_2D, static_cast<GLuint>(previousTexture));
+
+    textures[tile] = texture;
+    return texture;
+}
+
+bool SpectrogramTiles::draw(ImDrawList* drawList, const Spectrogram& spectrogram, double start, double duration,
+                            ImVec2 min, ImVec2 max) {
+    float width = max.x - min.x;
+    if (textureFailed || duration <= 0.0 || width < 1.0f || spectrogram.empty()) {
+        return true;
+    }
+
+    int tileCount = spectrogram.getTileCount();
+    textures.resize(tileCount, 0);
+
+    // Texel f is centered on frame f, so a tile starts half a frame before its first frame
+    const int tileFrames = Spectrogram::TILE_FRAMES;
+    double pixelsPerSecond = width / duration;
+    double firstFrame = (start - spectrogram.firstFrameTime) * spectrogram.frameRate + 0.5;
+    double lastFrame = (start + duration - spectrogram.firstFrameTime) * spectrogram.frameRate + 0.5;
+    int firstTile = std::max(0, static_cast<int>(std::floor(firstFrame / tileFrames)));
+    int lastTile = std::min(tileCount - 1, static_cast<int>(std::floor(lastFrame / tileFrames)));
+
+    bool complete = true;
+    int uploads = 0;
+    drawList->PushClipRect(min, max, true);
+    for (int tile = firstTile; tile <= lastTile; ++tile) {
+        unsigned int texture = textures[tile];
+        if (texture == 0) {
+            if (uploads == SPECTROGRAM_UPLOADS_PER_FRAME) {
+                complete = false;
+                continue;
+            }
+            uploads++;
+            texture = uploadTile(spectrogram, tile);
+            if (texture == 0) {
+                break;
+            }
+        }
+
+        int frames = std::min(tileFrames, spectrogram.frameCount - tile * tileFrames);
+        double tileStart = spectrogram.firstFrameTime + (tile * tileFrames - 0.5) / spectrogram.frameRate;
+        float x0 = min.x + static_cast<float>((tileStart - start) * pixelsPerSecond);
+        float x1 = x0 + static_cast<float>(frames / spectrogram.frameRate * pixelsPerSecond);
+        drawList->AddImage(ImTextureRef(static_cast<ImTextureID>(texture)), ImVec2(x0, min.y), ImVec2(x1, max.y),
+                           ImVec2(0.0f, 1.0f), ImVec2(static_cast<float>(frames) / tileFrames, 0.0f));
+    }
+    drawList->PopClipRect();
+    return complete;
+}
+
+} // Windows
+} // App
@@ -0,0 +1,96 @@
+#include "SpectrumStream.hpp"
+#include <algorithm>
+#include <cmath>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+SpectrumStream::SpectrumStream()
+    : plan(FFTPlan::get(WINDOW_SIZE)),
+      window(WINDOW_SIZE),
+      ring(RING_SIZE, 0.0f),
+      position(0),
+      frame(WINDOW_SIZE),
+      bins(plan->getBinCount()),
+      sampleRate(0.0) {
+    for (size_t i = 0; i < WINDOW_SIZE; i++) {
+        window[i] = static_cast<float>(0.5 * (1.0 - std::cos(2.0 * M_PI * i / (WINDOW_SIZE - 1))));
+    }
+}
+
+void SpectrumStream::configure(double rate, size_t bandCount, double minFrequency) {
+    sampleRate = rate;
+    bandStart.assign(bandCount + 1, 0);
+    if (bandCount == 0 || rate <= 0.0) {
+        return;
+    }
+
+    // Log-spaced edges from minFrequency to Nyquist, pushed apart to one bin minimum
+    size_t lastBin = plan->getBinCount();
+    double binWidth = rate / WINDOW_SIZE;
+    double maxFrequency = rate * 0.5;
+    minFrequency = std::min(std::max(minFrequency, binWidth), maxFrequency * 0.5);
+
+    for (size_t band = 0; band <= bandCount; band++) {
+        double frequency = minFrequency * std::pow(maxFrequency / minFrequency, static_cast<double>(band) / bandCount);
+        size_t bin = static_cast<size_t>(std::lround(frequency / binWidth));
+        if (band > 0) {
+            bin = std::max(bin, bandStart[band - 1] + 1);
+        }
+        bandStart[band] = std::min(bin, lastBin);
+    }
+}
+
+double SpectrumStream::getBandFrequency(size_t band) const {
+    return band < bandStart.size() ? bandStart[band] * sampleRate / WINDOW_SIZE : 0.0;
+}
+
+void SpectrumStream::reset(int64_t newPosition) {
+    std::fill(ring.begin(), ring.end(), 0.0f);
+    position = newPosition;
+}
+
+void SpectrumStream::push(const float* samples, size_t count) {
+    // Only the last RING_SIZE samples can ever be read back
+    if (count > RING_SIZE) {
+        position += static_cast<int64_t>(count - RING_SIZE);
+        samples += count - RING_SIZE;
+        count = RING_SIZE;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        ring[static_cast<size_t>(position + static_cast<int64_t>(i)) & (RING_SIZE - 1)] = samples[i];
+    }
+    position += static_cast<int64_t>(count);
+}
+
+void SpectrumStream::compute(float* bands) {
+    size_t start = static_cast<size_t>(position - static_cast<int64_t>(WINDOW_SIZE)) & (RING_SIZE - 1);
+    for (size_t i = 0; i < WINDOW_SIZE; i++) {
+        frame[i] = ring[(start + i) & (RING_SIZE - 1)];
+    }
+
+    computeFrame(frame.data(), bands, frame.data(), bins.data());
+}
+
+void SpectrumStream::computeFrame(const float* samples, float* bands, float* scratch, std::complex<float>* scratchBins) const {
+    size_t bandCount = getBandCount();
+    for (size_t i = 0; i < WINDOW_SIZE; i++) {
+        scratch[i] = samples[i] * window[i];
+    }
+
+    plan->forwardReal(scratch, scratchBins);
+
+    // A full-scale sine through the Hann window peaks at WINDOW_SIZE / 4
+    const float reference = 4.0f / WINDOW_SIZE;
+    for (size_t band = 0; band < bandCount; band++) {
+        float peak = 0.0f;
+        for (size_t bin = bandStart[band]; bin < bandStart[band + 1]; bin++) {
+            peak = std::max(peak, std::norm(scratchBins[bin]));
+        }
+
+        float decibels = 10.0f * std::log10(std::max(peak * reference * reference, 1e-12f));
+        bands[band] = std::clamp((decibels + DYNAMIC_RANGE) / DYNAMIC_RANGE, 0.0f, 1.0f);
+    }
+}
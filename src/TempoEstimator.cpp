@@ -0,0 +1,200 @@
+#include "TempoEstimator.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+const int COMB_HARMONICS = 4;
+const double COMB_BPM_STEP = 0.05;
+const double SEARCH_RANGE = 0.03;     // Share of the tempo searched around the comb pick
+const double SEARCH_BPM_STEP = 0.05;
+const double FINE_BPM_STEP = 0.005;
+const double PHASE_STEP = 0.25;       // Frames
+const double WHOLE_BPM_RANGE = 0.15;
+const double WHOLE_BPM_TOLERANCE = 0.995; // Share of the best alignment a whole BPM must reach
+const double MEAN_WINDOW = 0.5;       // Seconds of envelope averaged around each frame
+
+// Linear interpolation of values at a fractional index, 0 outside
+double sampleAt(const std::vector<float>& values, double index) {
+    size_t below = static_cast<size_t>(index);
+    if (index < 0.0 || below + 1 >= values.size()) {
+        return 0.0;
+    }
+    double blend = index - below;
+    return values[below] * (1.0 - blend) + values[below + 1] * blend;
+}
+
+// Largest value within one index of a fractional index; onset peaks in the
+// autocorrelation are about a frame wide, interpolating would shave them off
+double peakNear(const std::vector<double>& values, double index) {
+    size_t from = static_cast<size_t>(std::max(0.0, std::floor(index - 1.0)));
+    size_t to = std::min(values.size(), static_cast<size_t>(std::ceil(index + 1.0)) + 1);
+    double peak = 0.0;
+    for (size_t i = from; i < to; ++i) {
+        peak = std::max(peak, values[i]);
+    }
+    return peak;
+}
+
+struct Alignment {
+    double score; // Mean envelope on the beats
+    double phase; // First beat, in frames
+};
+
+// Best phase of a beat comb with the given period
+Alignment alignBeats(const std::vector<float>& envelope, double period) {
+    Alignment best = {-1.0, 0.0};
+    for (double phase = 0.0; phase < period; phase += PHASE_STEP) {
+        double sum = 0.0;
+        int beats = 0;
+        for (double frame = phase; frame < envelope.size(); frame += period) {
+            sum += sampleAt(envelope, frame);
+            beats++;
+        }
+
+        double score = beats > 0 ? sum / beats : 0.0;
+        if (score > best.score) {
+            best = {score, phase};
+        }
+    }
+    return best;
+}
+
+// Best aligned tempo within center +- range; bpm receives it
+Alignment searchTempo(const std::vector<float>& envelope, double rate, double center, double range, double step,
+                      double& bpm) {
+    Alignment best = {-1.0, 0.0};
+    bpm = center;
+    for (double candidate = center - range; candidate <= center + range; candidate += step) {
+        Alignment alignment = alignBeats(envelope, rate * 60.0 / candidate);
+        if (alignment.score > best.score) {
+            best = alignment;
+            bpm = candidate;
+        }
+    }
+    return best;
+}
+
+} // namespace
+
+TempoEstimator::TempoEstimator(double minBpm)
+    : minBpm(minBpm) {}
+
+void TempoEstimator::onsetEnvelope(const Spectrogram& spectrogram, std::vector<float>& envelope) {
+    envelope.assign(static_cast<size_t>(spectrogram.frameCount), 0.0f);
+    if (spectrogram.empty()) {
+        return;
+    }
+
+    // Band rows are contiguous inside a tile, so the flux is summed row by row
+    const int tileFrames = Spectrogram::TILE_FRAMES;
+    for (int tile = 0; tile < spectrogram.getTileCount(); ++tile) {
+        int base = tile * tileFrames;
+        int frames = std::min(tileFrames, spectrogram.frameCount - base);
+        const uint8_t* cells = spectrogram.getTile(tile);
+        const uint8_t* previousCells = tile > 0 ? spectrogram.getTile(tile - 1) : nullptr;
+
+        for (int band = 0; band < spectrogram.bandCount; ++band) {
+            const uint8_t* row = cells + static_cast<size_t>(band) * tileFrames;
+            int previous = previousCells ? previousCells[static_cast<size_t>(band) * tileFrames + tileFrames - 1] : row[0];
+            float* flux = envelope.data() + base;
+            for (int i = 0; i < frames; ++i) {
+                int value = row[i];
+                flux[i] += static_cast<float>(std::max(0, value - previous));
+                previous = value;
+            }
+        }
+    }
+
+    // Remove the local mean so sustained loud passages don't look like onsets
+    size_t count = envelope.size();
+    size_t halfWindow = std::max<size_t>(1, static_cast<size_t>(MEAN_WINDOW * 0.5 * spectrogram.frameRate));
+    std::vector<double> prefix(count + 1, 0.0);
+    for (size_t i = 0; i < count; ++i) {
+        prefix[i + 1] = prefix[i] + envelope[i];
+    }
+    for (size_t i = 0; i < count; ++i) {
+        size_t from = i > halfWindow ? i - halfWindow : 0;
+        size_t to = std::min(count, i + halfWindow + 1);
+        double mean = (prefix[to] - prefix[from]) / (to - from);
+        envelope[i] = static_cast<float>(std::max(0.0, envelope[i] - mean));
+    }
+}
+
+TempoEstimate TempoEstimator::estimate(const Spectrogram& spectrogram) const {
+    TempoEstimate result = {0.0, 0.0, 0.0};
+    if (spectrogram.empty() || spectrogram.frameRate <= 0.0 || minBpm <= 0.0) {
+        return result;
+    }
+
+    std::vector<float> envelope;
+    onsetEnvelope(spectrogram, envelope);
+
+    double rate = spectrogram.frameRate;
+    double maxBpm = minBpm * 2.0;
+    size_t maxLag = static_cast<size_t>(std::ceil(rate * 60.0 / minBpm * COMB_HARMONICS)) + 2;
+    if (envelope.size() < maxLag * 2) {
+        return result;
+    }
+
+    // Autocorrelation, normalized by the number of overlapping frames
+    size_t count = envelope.size();
+    std::vector<double> correlation(maxLag + 1, 0.0);
+    for (size_t lag = 1; lag <= maxLag; ++lag) {
+        double sum = 0.0;
+        for (size_t i = 0; i + lag < count; ++i) {
+            sum += static_cast<double>(envelope[i]) * envelope[i + lag];
+        }
+        correlation[lag] = sum / (count - lag);
+    }
+
+    double bestScore = 0.0;
+    double bestBpm = 0.0;
+    double scoreSum = 0.0;
+    int candidates = 0;
+    for (double bpm = minBpm; bpm < maxBpm; bpm += COMB_BPM_STEP) {
+        double period = rate * 60.0 / bpm;
+        double score = 0.0;
+        for (int harmonic = 1; harmonic <= COMB_HARMONICS; ++harmonic) {
+            score += peakNear(correlation, period * harmonic);
+        }
+
+        scoreSum += score;
+        candidates++;
+        if (score > bestScore) {
+            bestScore = score;
+            bestBpm = bpm;
+        }
+    }
+    if (bestScore <= 0.0) {
+        return result;
+    }
+
+    // The autocorrelation lags are whole frames, a few percent of the period; aligning beats
+    // over the whole track pins the tempo down, first coarsely then finely
+    double bpm;
+    searchTempo(envelope, rate, bestBpm, std::max(0.5, bestBpm * SEARCH_RANGE), SEARCH_BPM_STEP, bpm);
+    Alignment best = searchTempo(envelope, rate, bpm, SEARCH_BPM_STEP, FINE_BPM_STEP, bpm);
+
+    // Charts are usually made at a whole BPM, take it when it fits about as well
+    double wholeBpm = std::round(bpm);
+    if (wholeBpm != bpm && std::abs(wholeBpm - bpm) <= WHOLE_BPM_RANGE) {
+        Alignment whole = alignBeats(envelope, rate * 60.0 / wholeBpm);
+        if (whole.score >= best.score * WHOLE_BPM_TOLERANCE) {
+            best = whole;
+            bpm = wholeBpm;
+        }
+    }
+
+    // Flux of frame f is the change from frame f - 1, so it sits half a frame earlier
+    double beatSeconds = 60.0 / bpm;
+    double offset = std::fmod(spectrogram.firstFrameTime + (best.phase - 0.5) / rate, beatSeconds);
+    if (offset < 0.0) {
+        offset += beatSeconds;
+    }
+
+    result.bpm = bpm;
+    result.offset = offset;
+    result.confidence = bestScore / (scoreSum / candidates);
+    return result;
+}
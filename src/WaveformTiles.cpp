@@ -0,0 +1,199 @@
+#include "WaveformTiles.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+
+#define GL_SILENCE_DEPRECATION
+#if defined(IMGUI_IMPL_OPENGL_ES2)
+#include <GLES2/gl2.h>
+#endif
+#include <GLFW/glfw3.h> // Will drag system OpenGL headers
+
+// Windows only ships the OpenGL 1.1 header
+#ifndef GL_CLAMP_TO_EDGE
+#define GL_CLAMP_TO_EDGE 0x812F
+#endif
+
+namespace App {
+namespace Windows {
+
+namespace {
+
+uint64_t tileKey(int bucket, int64_t index) {
+    return (static_cast<uint64_t>(bucket + 512) << 48) | (static_cast<uint64_t>(index) & 0xFFFFFFFFFFFFULL);
+}
+
+double bucketPixelsPerSecond(int bucket) {
+    return std::ldexp(1.0, bucket);
+}
+
+void setPixel(unsigned char* texel, ImU32 color) {
+    texel[0] = static_cast<unsigned char>((color >> IM_COL32_R_SHIFT) & 0xFF);
+    texel[1] = static_cast<unsigned char>((color >> IM_COL32_G_SHIFT) & 0xFF);
+    texel[2] = static_cast<unsigned char>((color >> IM_COL32_B_SHIFT) & 0xFF);
+    texel[3] = static_cast<unsigned char>((color >> IM_COL32_A_SHIFT) & 0xFF);
+}
+
+} // namespace
+
+WaveformTiles::WaveformTiles()
+    : textureFailed(false) {
+}
+
+void WaveformTiles::clear() {
+    for (const Tile& tile : tiles) {
+        GLuint texture = tile.texture;
+        glDeleteTextures(1, &texture);
+    }
+    tiles.clear();
+    tileIndex.clear();
+}
+
+void WaveformTiles::renderTile(const AudioWaveform& waveform, int bucket, int64_t index) {
+    pixels.assign(static_cast<size_t>(WAVEFORM_TILE_WIDTH) * WAVEFORM_TILE_HEIGHT * 4, 0);
+
+    double pixelsPerSecond = bucketPixelsPerSecond(bucket);
+    double samplesPerPixel = waveform.sampleRate / pixelsPerSecond;
+
+    // Every pixel column must cover at least one entry, so no peak falls between columns
+    const std::vector<double>* peaks = &waveform.data;
+    if (const WaveformLevel* level = waveform.findLevelAtMost(samplesPerPixel)) {
+        peaks = &level->peaks;
+    }
+    if (peaks->empty() || waveform.duration <= 0.0) {
+        return;
+    }
+
+    double entriesPerSecond = peaks->size() / waveform.duration;
+    double entriesPerColumn = entriesPerSecond / pixelsPerSecond;
+    double firstEntry = static_cast<double>(index) * WAVEFORM_TILE_WIDTH * entriesPerColumn;
+    float halfHeight = WAVEFORM_TILE_HEIGHT * 0.5f;
+
+    float previousLow = 0.0f;
+    float previousHigh = 0.0f;
+    for (int x = 0; x < WAVEFORM_TILE_WIDTH; ++x) {
+        double from = firstEntry + x * entriesPerColumn;
+        size_t begin = static_cast<size_t>(std::max(0.0, std::floor(from)));
+        size_t end = static_cast<size_t>(std::max(0.0, std::ceil(from + entriesPerColumn)));
+        end = std::min(std::max(end, begin + 1), peaks->size());
+        if (begin >= end) {
+            break;
+        }
+
+        float minimum = static_cast<float>((*peaks)[begin]);
+        float maximum = minimum;
+        for (size_t j = begin + 1; j < end; ++j) {
+            float peak = static_cast<float>((*peaks)[j]);
+            minimum = std::min(minimum, peak);
+            maximum = std::max(maximum, peak);
+        }
+
+        ImU32 waveformColor;
+        if (maximum > 0.8f) {
+            waveformColor = IM_COL32(255, 100, 100, 220); // Red for strong bass/rhythm
+        } else if (maximum > 0.6f) {
+            waveformColor = IM_COL32(255, 150, 100, 200); // Orange for medium intensity
+        } else if (maximum > 0.4f) {
+            waveformColor = IM_COL32(100, 200, 255, 180); // Blue for moderate intensity
+        } else {
+            waveformColor = IM_COL32(100, 150, 255, 150); // Light blue for low intensity
+        }
+
+        // Reach the neighbouring column so the outline stays connected, at least one pixel tall
+        float low = minimum * halfHeight;
+        float high = maximum * halfHeight;
+        if (x > 0) {
+            low = std::min(low, previousHigh);
+            high = std::max(high, previousLow);
+        }
+        previousLow = minimum * halfHeight;
+        previousHigh = maximum * halfHeight;
+
+        int highRows = std::min(static_cast<int>(halfHeight), static_cast<int>(std::ceil(high)));
+        int lowRows = std::max(0, std::min(static_cast<int>(low), highRows - 1));
+        int center = WAVEFORM_TILE_HEIGHT / 2;
+        for (int row = lowRows; row < highRows; ++row) {
+            setPixel(&pixels[(static_cast<size_t>(center - 1 - row) * WAVEFORM_TILE_WIDTH + x) * 4], waveformColor);
+            setPixel(&pixels[(static_cast<size_t>(center + row) * WAVEFORM_TILE_WIDTH + x) * 4], waveformColor);
+        }
+    }
+}
+
+unsigned int WaveformTiles::acquireTile(const AudioWaveform& waveform, int bucket, int64_t index) {
+    uint64_t key = tileKey(bucket, index);
+    auto found = tileIndex.find(key);
+    if (found != tileIndex.end()) {
+        tiles.splice(tiles.begin(), tiles, found->second);
+        return found->second->texture;
+    }
+
+    // Past the capacity the least recently drawn tile gives up its texture
+    GLuint texture = 0;
+    if (tiles.size() >= WAVEFORM_TILE_CAPACITY) {
+        texture = tiles.back().texture;
+        tileIndex.erase(tiles.back().key);
+        tiles.pop_back();
+    } else {
+        glGenTextures(1, &texture);
+        if (texture == 0) {
+            std::cerr << "Failed to create a waveform tile texture" << std::endl;
+            textureFailed = true;
+            return 0;
+        }
+    }
+
+    renderTile(waveform, bucket, index);
+
+    GLint previousTexture = 0;
+    glGetIntegerv(GL_TEXTURE_BINDING_2D, &previousTexture);
+    glBindTexture(GL_TEXTURE_2D, texture);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, WAVEFORM_TILE_WIDTH, WAVEFORM_TILE_HEIGHT, 0, GL_RGBA, GL_UNSIGNED_BYTE,
+                 pixels.data());
+    glBindTexture(GL_TEXTURE_2D, static_cast<GLuint>(previousTexture));
+
+    tiles.push_front(Tile{key, texture});
+    tileIndex[key] = tiles.begin();
+    return texture;
+}
+
+void WaveformTiles::draw(ImDrawList* drawList, const AudioWaveform& waveform, double start, double duration,
+                         ImVec2 min, ImVec2 max, float amplitudeScale) {
+    float width = max.x - min.x;
+    if (textureFailed || duration <= 0.0 || width < 1.0f || waveform.duration <= 0.0) {
+        return;
+    }
+
+    // The bucket at or above the zoom, so tiles are only ever shrunk (by less than half)
+    double pixelsPerSecond = width / duration;
+    int bucket = static_cast<int>(std::ceil(std::log2(pixelsPerSecond)));
+    double tileSeconds = WAVEFORM_TILE_WIDTH / bucketPixelsPerSecond(bucket);
+
+    int64_t firstTile = static_cast<int64_t>(std::floor(std::max(0.0, start) / tileSeconds));
+    int64_t lastTile = static_cast<int64_t>(std::floor(std::min(start + duration, waveform.duration) / tileSeconds));
+
+    float centerY = (min.y + max.y) * 0.5f;
+    float halfHeight = (max.y - min.y) * amplitudeScale;
+
+    // Only clipped horizontally, loud peaks may reach past the rectangle like the line renderer's did
+    drawList->PushClipRect(ImVec2(min.x, centerY - halfHeight), ImVec2(max.x, centerY + halfHeight), true);
+    for (int64_t index = firstTile; index <= lastTile; ++index) {
+        unsigned int texture = acquireTile(waveform, bucket, index);
+        if (texture == 0) {
+            break;
+        }
+
+        float x0 = min.x + static_cast<float>((index * tileSeconds - start) * pixelsPerSecond);
+        float x1 = x0 + static_cast<float>(tileSeconds * pixelsPerSecond);
+        drawList->AddImage(ImTextureRef(static_cast<ImTextureID>(texture)),
+                           ImVec2(x0, centerY - halfHeight), ImVec2(x1, centerY + halfHeight));
+    }
+    drawList->PopClipRect();
+}
+
+} // Windows
+} // App
@@ -83,6 +83,26 @@ static void glfw_error_callback(int error, const char* description)
     fprintf(stderr, "GLFW Error %d: %s\n", error, description);
 }
 
+// Gameplay keys are stamped here, as soon as GLFW delivers them, rather than polled once per frame.
+// Dear ImGui chains to this callback, so its own keyboard handling is unaffected.
+static void glfw_key_callback(GLFWwindow* window, int key, int scancode, int action, int mods)
+{
+    (void)window; (void)scancode; (void)mods;
+    if (action == GLFW_REPEAT)
+        return;
+
+    App::Core::InputEvent event;
+    if (key == GLFW_KEY_F)
+        event.lane = App::Core::Lane::TOP;
+    else if (key == GLFW_KEY_J)
+        event.lane = App::Core::Lane::BOTTOM;
+    else
+        return;
+    event.pressed = (action == GLFW_PRESS);
+    event.time = std::chrono::steady_clock::now();
+    App::Core::getInputQueue().push(event);
+}
+
 // Main code
 int main(int argc, char** argv)
 {
@@ -152,6 +172,7 @@ int main(int argc, char** argv)
     }
 
     // Setup Platform/Renderer backends
+    glfwSetKeyCallback(window, glfw_key_callback); // Before the backend installs its callbacks, so they chain to ours
     ImGui_ImplGlfw_InitForOpenGL(window, true);
 #ifdef __EMSCRIPTEN__
     ImGui_ImplGlfw_InstallEmscriptenCallbacks(window, "#canvas");
@@ -189,6 +210,8 @@ int main(int argc, char** argv)
 
     emscripten_set_main_loop_arg(main_loop, nullptr, 0, 1);
 #else
+    App::Core::FrameScheduler& scheduler = App::Core::getFrameScheduler();
+    int swap_interval = 1;
     while (!glfwWindowShouldClose(window) && !App::isShutdownRequested())
     {
         // Poll and handle events (inputs, window resize, etc.)
@@ -196,12 +219,17 @@ int main(int argc, char** argv)
         // - When io.WantCaptureMouse is true, do not dispatch mouse input data to your main application, or clear/overwrite your copy of the mouse data.
         // - When io.WantCaptureKeyboard is true, do not dispatch keyboard input data to your main application, or clear/overwrite your copy of the keyboard data.
         // Generally you may always pass all inputs to dear imgui, and hide them from your application based on those two flags.
-        glfwPollEvents();
+        // When nothing is animating, block until an event arrives (or the idle timeout) instead of redrawing.
+        if (scheduler.getPacing() == App::Core::PACING_IDLE)
+            glfwWaitEventsTimeout(scheduler.getIdleTimeout());
+        else
+            glfwPollEvents();
         if (glfwGetWindowAttrib(window, GLFW_ICONIFIED) != 0)
         {
             ImGui_ImplGlfw_Sleep(10);
             continue;
         }
+        scheduler.beginFrame();
 
         // Start the Dear ImGui frame
         ImGui_ImplOpenGL3_NewFrame();
@@ -232,6 +260,14 @@ int main(int argc, char** argv)
         }
 
         glfwSwapBuffers(window);
+
+        // Records the frame and sleeps when a target frame rate is set; vsync is dropped while gameplay wants low latency
+        scheduler.endFrame();
+        if (scheduler.getSwapInterval() != swap_interval)
+        {
+            swap_interval = scheduler.getSwapInterval();
+            glfwSwapInterval(swap_interval);
+        }
     }
 #endif
 